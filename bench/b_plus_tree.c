@@ -0,0 +1,137 @@
+// B+ tree against the red-black tree, head to head.
+//
+// For 10^4 keys up to `max_n` (default 4M, 16M fits in about 1.5GB), random distinct
+// keys are inserted in both trees, then both are probed with the same random hits
+// and misses, and range scanned. Memory per key counts the node bytes only: `Rb_Node`
+// pays one node per key plus the `malloc` header, the B+ tree pays its partially
+// filled nodes.
+//
+// Usage: b_plus_tree [max_n]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "tree/b_plus_tree.h"
+#include "tree/red_black_tree.h"
+
+#define LOOKUPS     1000000
+#define RANGE_SCANS 10000
+#define RANGE_WIDTH (1u << 20)
+// Bytes `malloc` adds in front of every chunk on glibc.
+#define MALLOC_HEADER 8
+
+static bool count_entry(uint32_t key, void* value, void* ctx) {
+    (void) key;
+    (void) value;
+    *(size_t*) ctx += 1;
+    return true;
+}
+
+static void print_row(const char* structure, size_t n, double insert_ns, double hit_ns, double miss_ns,
+                      double scan_ns, double bytes_per_key, uint32_t height, bool valid) {
+    printf("%-12s %-10zu %10.1f %10.1f %10.1f %12.1f %10.1f %8u%s\n", structure, n, insert_ns, hit_ns, miss_ns,
+           scan_ns, bytes_per_key, height, valid ? "" : " (INVALID)");
+}
+
+static uint32_t rb_height(Rb_Node* node) {
+    if (node == NULL) {
+        return 0;
+    }
+    uint32_t left  = rb_height(node->left);
+    uint32_t right = rb_height(node->right);
+    return 1 + (left > right ? left : right);
+}
+
+static void bench_size(size_t n) {
+    // Odd numbers times an odd constant are distinct and odd, even keys are never present.
+    uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i += 1) {
+        keys[i] = (uint32_t) ((2 * i + 1) * 2654435761u);
+    }
+    uint32_t* hits   = (uint32_t*) malloc(LOOKUPS * sizeof(uint32_t));
+    uint32_t* misses = (uint32_t*) malloc(LOOKUPS * sizeof(uint32_t));
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        hits[i]   = keys[bench_xorshift32(&seed) % n];
+        misses[i] = bench_xorshift32(&seed) & ~1u;
+    }
+    size_t found = 0;
+    size_t scanned = 0;
+
+    Rb_Node* root = NULL;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&root, keys[i], NULL);
+    }
+    double insert_ns = (double) (bench_now_ns() - start) / (double) n;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += rb_node_find(root, hits[i]) != NULL;
+    }
+    double hit_ns = (double) (bench_now_ns() - start) / LOOKUPS;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += rb_node_find(root, misses[i]) != NULL;
+    }
+    double miss_ns = (double) (bench_now_ns() - start) / LOOKUPS;
+    start = bench_now_ns();
+    for (size_t i = 0; i < RANGE_SCANS; i += 1) {
+        uint32_t lo = hits[i];
+        for (Rb_Node* node = rb_node_lower_bound(root, lo); node != NULL && node->key - lo <= RANGE_WIDTH;
+             node = rb_node_next(node)) {
+            scanned += 1;
+        }
+    }
+    double scan_ns = (double) (bench_now_ns() - start) / RANGE_SCANS;
+    print_row("rb_node", n, insert_ns, hit_ns, miss_ns, scan_ns, (double) (sizeof(Rb_Node) + MALLOC_HEADER),
+              rb_height(root), rb_node_validate(root));
+    rb_node_free(root);
+
+    B_Plus_Tree tree;
+    b_plus_tree_init(&tree);
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        b_plus_tree_insert(&tree, keys[i], NULL);
+    }
+    insert_ns = (double) (bench_now_ns() - start) / (double) n;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += b_plus_tree_find(&tree, hits[i], NULL);
+    }
+    hit_ns = (double) (bench_now_ns() - start) / LOOKUPS;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += b_plus_tree_find(&tree, misses[i], NULL);
+    }
+    miss_ns = (double) (bench_now_ns() - start) / LOOKUPS;
+    start = bench_now_ns();
+    for (size_t i = 0; i < RANGE_SCANS; i += 1) {
+        uint32_t lo = hits[i];
+        uint32_t hi = lo + RANGE_WIDTH < lo ? UINT32_MAX : lo + RANGE_WIDTH;
+        scanned -= b_plus_tree_range(&tree, lo, hi, count_entry, &(size_t) { 0 });
+    }
+    scan_ns = (double) (bench_now_ns() - start) / RANGE_SCANS;
+    print_row("b_plus_tree", n, insert_ns, hit_ns, miss_ns, scan_ns,
+              (double) b_plus_tree_memory_usage(&tree) / (double) n, tree.height, b_plus_tree_validate(&tree));
+    b_plus_tree_free(&tree);
+
+    if (found != 2 * LOOKUPS || scanned != 0) {
+        printf("mismatch: %zu hits out of %d, %zu scanned keys differ\n", found, 2 * LOOKUPS, scanned);
+    }
+    free(misses);
+    free(hits);
+    free(keys);
+}
+
+int main(int argc, char** argv) {
+    size_t max_n = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 4000000;
+
+    printf("times in ns per operation, scan over a key range of width %u\n", RANGE_WIDTH);
+    printf("%-12s %-10s %10s %10s %10s %12s %10s %8s\n", "structure", "n", "insert", "hit", "miss",
+           "range_scan", "bytes/key", "height");
+    for (size_t n = 10000; n <= max_n; n *= 4) {
+        bench_size(n);
+    }
+    return 0;
+}
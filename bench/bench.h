@@ -0,0 +1,121 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+// Monotonic timestamp in nanoseconds, used to time a whole benchmark loop.
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+// Cheap deterministic generator for keys, indices and shuffles. `state` must not be 0.
+static inline uint32_t bench_xorshift32(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Zipf distributed ranks in `[1, n]`, rank `k` drawn with a probability proportional
+// to `1 / k^exponent`, by rejection-inversion (Hörmann and Derflinger), in O(1) per draw
+// and without a table, so that the key universe can be as large as wanted.
+typedef struct Bench_Zipf {
+    double   exponent;
+    double   n;
+    double   h_integral_x1;
+    double   h_integral_n;
+    double   s;
+    uint32_t seed;
+} Bench_Zipf;
+
+static inline double bench_zipf_helper1(double x) {
+    return fabs(x) > 1e-8 ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+static inline double bench_zipf_helper2(double x) {
+    return fabs(x) > 1e-8 ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+static inline double bench_zipf_h(const Bench_Zipf* zipf, double x) {
+    return exp(-zipf->exponent * log(x));
+}
+
+static inline double bench_zipf_h_integral(const Bench_Zipf* zipf, double x) {
+    double log_x = log(x);
+    return bench_zipf_helper2((1.0 - zipf->exponent) * log_x) * log_x;
+}
+
+static inline double bench_zipf_h_integral_inverse(const Bench_Zipf* zipf, double x) {
+    double t = x * (1.0 - zipf->exponent);
+    return exp(bench_zipf_helper1(t < -1.0 ? -1.0 : t) * x);
+}
+
+// `seed` must not be 0.
+static inline void bench_zipf_init(Bench_Zipf* zipf, size_t n, double exponent, uint32_t seed) {
+    zipf->exponent      = exponent;
+    zipf->n             = (double) n;
+    zipf->seed          = seed;
+    zipf->h_integral_x1 = bench_zipf_h_integral(zipf, 1.5) - 1.0;
+    zipf->h_integral_n  = bench_zipf_h_integral(zipf, zipf->n + 0.5);
+    zipf->s = 2.0 - bench_zipf_h_integral_inverse(zipf, bench_zipf_h_integral(zipf, 2.5) - bench_zipf_h(zipf, 2.0));
+}
+
+static inline size_t bench_zipf_next(Bench_Zipf* zipf) {
+    for (;;) {
+        double uniform = (double) bench_xorshift32(&zipf->seed) / 4294967296.0;
+        double u = zipf->h_integral_n + uniform * (zipf->h_integral_x1 - zipf->h_integral_n);
+        double x = bench_zipf_h_integral_inverse(zipf, u);
+        double k = floor(x + 0.5);
+        k = k < 1.0 ? 1.0 : k > zipf->n ? zipf->n : k;
+        if (k - x <= zipf->s || u >= bench_zipf_h_integral(zipf, k + 0.5) - bench_zipf_h(zipf, k)) {
+            return (size_t) k;
+        }
+    }
+}
+
+// Peak resident set size of the calling process, in kilobytes.
+static inline long bench_peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss;
+}
+
+// Current resident set size of the calling process, in kilobytes, -1 when unknown.
+static inline long bench_rss_kb(void) {
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL) {
+        return -1;
+    }
+    long pages = -1;
+    if (fscanf(statm, "%*s %ld", &pages) != 1) {
+        pages = -1;
+    }
+    fclose(statm);
+    return pages < 0 ? -1 : pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static inline void bench_csv_header(FILE* out) {
+    fprintf(out, "structure,function,pattern,n,ops,ns_per_op,ops_per_sec,peak_rss_kb\n");
+}
+
+// One CSV row for `ops` calls of `function` on a structure of `n` elements taking `elapsed_ns` overall.
+static inline void bench_csv_row(FILE* out, const char* structure, const char* function, const char* pattern,
+                                 size_t n, size_t ops, uint64_t elapsed_ns, long peak_rss_kb) {
+    double ns_per_op   = ops > 0 ? (double) elapsed_ns / (double) ops : 0.0;
+    double ops_per_sec = elapsed_ns > 0 ? (double) ops * 1e9 / (double) elapsed_ns : 0.0;
+    fprintf(out, "%s,%s,%s,%zu,%zu,%.2f,%.0f,%ld\n",
+            structure, function, pattern, n, ops, ns_per_op, ops_per_sec, peak_rss_kb);
+}
+
+#endif  // BENCH_H
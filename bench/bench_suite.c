@@ -0,0 +1,1583 @@
+// Benchmark suite timing every public procedure of `linkedlist.h` and
+// `tree/red_black_tree.h`.
+//
+// Usage: bench_suite [max_n] [filter]
+// - max_n:  largest structure size of the sweep, which goes from 10^3 up by powers
+//           of ten (default 10^7).
+// - filter: only run the cases whose procedure name contains this string.
+//
+// Lists are measured with sequential and random positions (or values), trees with
+// random and sorted keys, sorted keys being the adversarial input of an unbalanced
+// search tree. `rb_node_insert_batch` is measured into an empty tree (`rb_node_empty`
+// rows) and into a tree of `n` other keys (`rb_node` rows). Procedures walking the
+// whole structure are called fewer times on large structures so that every case
+// stays in the same time budget. The multiset procedures are measured with repeated
+// keys, drawn uniformly (`random`) or with a Zipf distribution (`zipf`).
+//
+// Each case runs in a forked child, so the reported peak RSS belongs to that case
+// alone. Results are written to the standard output as CSV, what the procedures
+// print goes to /dev/null.
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "linkedlist.h"
+#include "tree/red_black_tree.h"
+
+#define DEFAULT_MAX_N 10000000
+#define MIN_N         1000
+
+// Element visits allowed for a case calling a procedure walking the structure.
+#define LINEAR_BUDGET 20000000
+
+// Keys of the bounded ranges of `rb_iterator_range`.
+#define RANGE_KEYS 64
+
+typedef enum Bench_Pattern {
+    PATTERN_SEQUENTIAL = 1 << 0,
+    PATTERN_RANDOM     = 1 << 1,
+    PATTERN_SORTED     = 1 << 2,
+    PATTERN_ZIPF       = 1 << 3,
+} Bench_Pattern;
+
+#define LIST_PATTERNS  (PATTERN_SEQUENTIAL | PATTERN_RANDOM)
+#define TREE_PATTERNS  (PATTERN_RANDOM | PATTERN_SORTED)
+#define MULTI_PATTERNS (PATTERN_RANDOM | PATTERN_ZIPF)
+
+typedef struct Bench_Run {
+    size_t        n;
+    Bench_Pattern pattern;
+    bool          pooled;
+    uint32_t      seed;
+    size_t        ops;
+    uint64_t      elapsed_ns;
+    uint64_t      start_ns;
+    Node_Pool     pool;
+} Bench_Run;
+
+typedef struct Bench_Case {
+    const char* structure;
+    const char* function;
+    int         patterns;
+    bool        pooled;
+    void        (*run)(Bench_Run* run);
+} Bench_Case;
+
+static void run_start(Bench_Run* run) {
+    run->start_ns = bench_now_ns();
+}
+
+static void run_stop(Bench_Run* run) {
+    run->elapsed_ns += bench_now_ns() - run->start_ns;
+}
+
+static Node_Pool* run_pool(Bench_Run* run) {
+    return run->pooled ? &run->pool : NULL;
+}
+
+// Number of calls of a procedure walking the whole structure.
+static size_t linear_ops(size_t n) {
+    size_t ops = LINEAR_BUDGET / n;
+    if (ops > n / 2) {
+        ops = n / 2;
+    }
+    return ops < 3 ? 3 : ops;
+}
+
+// Number of times a consumed structure is rebuilt, for procedures like `free`.
+static size_t rebuild_rounds(size_t n) {
+    size_t rounds = 1000000 / n;
+    return rounds < 1 ? 1 : rounds;
+}
+
+// Position (or value) used by the i-th call, among `len` elements.
+static size_t pick(Bench_Run* run, size_t i, size_t len) {
+    if (run->pattern == PATTERN_RANDOM) {
+        return bench_xorshift32(&run->seed) % len;
+    }
+    return i % len;
+}
+
+// ========= builders =========
+
+static Singly_Linked_List_Node* build_singly(Bench_Run* run, size_t n) {
+    Singly_List list;
+    singly_list_init_pooled(&list, run_pool(run));
+    for (size_t i = 0; i < n; i += 1) {
+        singly_list_append(&list, (int) i);
+    }
+    return list.head;
+}
+
+static void free_singly(Bench_Run* run, Singly_Linked_List_Node* head) {
+    if (!run->pooled) {
+        singly_linked_list_free(head);
+    }
+}
+
+static void build_singly_list(Bench_Run* run, Singly_List* list, size_t n) {
+    singly_list_init_pooled(list, run_pool(run));
+    for (size_t i = 0; i < n; i += 1) {
+        singly_list_append(list, (int) i);
+    }
+}
+
+static Doubly_Linked_List_Node* build_doubly(Bench_Run* run, size_t n) {
+    Node_Pool* pool = run_pool(run);
+    Doubly_Linked_List_Node* head = doubly_linked_list_new_pooled(pool, (int) (n - 1));
+    for (size_t i = n - 1; i > 0; i -= 1) {
+        doubly_linked_list_insert_head_pooled(pool, head, (int) (i - 1));
+    }
+    return head;
+}
+
+static void free_doubly(Bench_Run* run, Doubly_Linked_List_Node* head) {
+    if (!run->pooled) {
+        doubly_linked_list_free(head);
+    }
+}
+
+// Distinct keys, in random order or sorted depending on the pattern.
+static uint32_t* build_keys(Bench_Run* run, size_t n) {
+    uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i += 1) {
+        keys[i] = (uint32_t) (i * 3);
+    }
+
+    if (run->pattern == PATTERN_RANDOM) {
+        for (size_t i = n - 1; i > 0; i -= 1) {
+            size_t j = bench_xorshift32(&run->seed) % (i + 1);
+            uint32_t tmp = keys[i];
+            keys[i] = keys[j];
+            keys[j] = tmp;
+        }
+    }
+    return keys;
+}
+
+// `n` keys drawn with repetitions from a universe of `n / 10` keys, uniformly or with a
+// Zipf exponent of 0.99 depending on the pattern, like `rb_multiset.c`.
+static uint32_t* build_multi_keys(Bench_Run* run, size_t n) {
+    uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+    size_t universe = n / 10;
+    Bench_Zipf zipf;
+    bench_zipf_init(&zipf, universe, 0.99, run->seed);
+    for (size_t i = 0; i < n; i += 1) {
+        keys[i] = run->pattern == PATTERN_ZIPF ? (uint32_t) bench_zipf_next(&zipf)
+                                               : 1 + bench_xorshift32(&run->seed) % (uint32_t) universe;
+    }
+    return keys;
+}
+
+static Rb_Node* build_multiset(Bench_Run* run, const uint32_t* keys, size_t n) {
+    Rb_Node* root = NULL;
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert_multi_pooled(run_pool(run), &root, keys[i], 1);
+    }
+    return root;
+}
+
+static Rb_Node* build_tree(Bench_Run* run, const uint32_t* keys, size_t n) {
+    Rb_Node* root = NULL;
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert_pooled(run_pool(run), &root, keys[i], NULL);
+    }
+    return root;
+}
+
+static void free_tree(Bench_Run* run, Rb_Node* root) {
+    if (!run->pooled) {
+        rb_node_free(root);
+    }
+}
+
+// ========= singly linked list nodes =========
+
+static void case_singly_new(Bench_Run* run) {
+    Singly_Linked_List_Node** nodes = (Singly_Linked_List_Node**) malloc(run->n * sizeof(Singly_Linked_List_Node*));
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->n; i += 1) {
+            nodes[i] = singly_linked_list_new_pooled(&run->pool, (int) i);
+        }
+    } else {
+        for (size_t i = 0; i < run->n; i += 1) {
+            nodes[i] = singly_linked_list_new((int) i);
+        }
+    }
+    run_stop(run);
+    run->ops = run->n;
+
+    if (!run->pooled) {
+        for (size_t i = 0; i < run->n; i += 1) {
+            free(nodes[i]);
+        }
+    }
+    free(nodes);
+}
+
+static void case_singly_len(Bench_Run* run) {
+    Singly_Linked_List_Node* head = build_singly(run, run->n);
+    size_t total = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        total += singly_linked_list_len(head);
+    }
+    run_stop(run);
+    assert(total == run->ops * run->n);
+    free_singly(run, head);
+}
+
+static void case_singly_print(Bench_Run* run) {
+    Singly_Linked_List_Node* head = build_singly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        singly_linked_list_print(head);
+    }
+    fflush(stdout);
+    run_stop(run);
+    free_singly(run, head);
+}
+
+static void case_singly_append(Bench_Run* run) {
+    Singly_Linked_List_Node* head = build_singly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            singly_linked_list_append_pooled(&run->pool, head, (int) i);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            singly_linked_list_append(head, (int) i);
+        }
+    }
+    run_stop(run);
+    free_singly(run, head);
+}
+
+static void case_singly_insert(Bench_Run* run) {
+    Singly_Linked_List_Node* head = build_singly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        size_t idx = pick(run, i, run->n);
+        if (run->pooled) {
+            singly_linked_list_insert_pooled(&run->pool, head, idx, (int) i);
+        } else {
+            singly_linked_list_insert(head, idx, (int) i);
+        }
+    }
+    run_stop(run);
+    free_singly(run, head);
+}
+
+static void case_singly_remove(Bench_Run* run) {
+    Singly_Linked_List_Node* head = build_singly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        int removed_val;
+        size_t idx = pick(run, i, run->n - i - 1);
+        if (run->pooled) {
+            singly_linked_list_remove_pooled(&run->pool, head, idx, &removed_val);
+        } else {
+            singly_linked_list_remove(head, idx, &removed_val);
+        }
+    }
+    run_stop(run);
+    free_singly(run, head);
+}
+
+static void case_singly_lookup(Bench_Run* run) {
+    Singly_Linked_List_Node* head = build_singly(run, run->n);
+    size_t found = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        size_t found_idx;
+        found += singly_linked_list_lookup(head, (int) pick(run, i, run->n), &found_idx);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    free_singly(run, head);
+}
+
+static void case_singly_free(Bench_Run* run) {
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Singly_Linked_List_Node* head = build_singly(run, run->n);
+        run_start(run);
+        singly_linked_list_free(head);
+        run_stop(run);
+    }
+}
+
+// ========= singly list handle =========
+
+static void case_singly_list_init(Bench_Run* run) {
+    Singly_List list;
+    run->ops = run->n;
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            singly_list_init_pooled(&list, &run->pool);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            singly_list_init(&list);
+        }
+    }
+    run_stop(run);
+}
+
+static void case_singly_list_wrap(Bench_Run* run) {
+    Singly_Linked_List_Node* head = build_singly(run, run->n);
+    Singly_List list;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        singly_list_wrap(&list, head);
+    }
+    run_stop(run);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_free(Bench_Run* run) {
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Singly_List list;
+        build_singly_list(run, &list, run->n);
+        run_start(run);
+        singly_list_free(&list);
+        run_stop(run);
+    }
+}
+
+static void case_singly_list_len(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    size_t total = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        total += singly_list_len(&list);
+    }
+    run_stop(run);
+    assert(total == run->ops * run->n);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_print(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        singly_list_print(&list);
+    }
+    fflush(stdout);
+    run_stop(run);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_push_front(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        singly_list_push_front(&list, (int) i);
+    }
+    run_stop(run);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_append(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        singly_list_append(&list, (int) i);
+    }
+    run_stop(run);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_insert(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        singly_list_insert(&list, pick(run, i, run->n), (int) i);
+    }
+    run_stop(run);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_remove(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        singly_list_remove(&list, pick(run, i, run->n - i), NULL);
+    }
+    run_stop(run);
+    singly_list_free(&list);
+}
+
+// Sequential positions resume from the finger in O(1), so they get a call per element
+// instead of the budget of a walk.
+static size_t finger_ops(Bench_Run* run) {
+    return run->pattern == PATTERN_SEQUENTIAL ? run->n : linear_ops(run->n);
+}
+
+static void case_singly_list_get(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    size_t found = 0;
+    run->ops = finger_ops(run);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        int get_val;
+        found += singly_list_get(&list, pick(run, i, run->n), &get_val);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_set(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    size_t found = 0;
+    run->ops = finger_ops(run);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        found += singly_list_set(&list, pick(run, i, run->n), (int) i);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    singly_list_free(&list);
+}
+
+static void case_singly_list_lookup(Bench_Run* run) {
+    Singly_List list;
+    build_singly_list(run, &list, run->n);
+    size_t found = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        size_t found_idx;
+        found += singly_list_lookup(&list, (int) pick(run, i, run->n), &found_idx);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    singly_list_free(&list);
+}
+
+static int* build_vals(size_t n) {
+    int* vals = (int*) malloc(n * sizeof(int));
+    for (size_t i = 0; i < n; i += 1) {
+        vals[i] = (int) i;
+    }
+    return vals;
+}
+
+static void case_singly_list_from_array(Bench_Run* run) {
+    int* vals = build_vals(run->n);
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Singly_List list;
+        run_start(run);
+        singly_list_from_array(&list, run_pool(run), vals, run->n);
+        run_stop(run);
+        if (run->pooled) {
+            node_pool_destroy(&run->pool);
+        } else {
+            singly_list_free(&list);
+        }
+    }
+    free(vals);
+}
+
+// ========= doubly linked list nodes =========
+
+static void case_doubly_new(Bench_Run* run) {
+    Doubly_Linked_List_Node** nodes = (Doubly_Linked_List_Node**) malloc(run->n * sizeof(Doubly_Linked_List_Node*));
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->n; i += 1) {
+            nodes[i] = doubly_linked_list_new_pooled(&run->pool, (int) i);
+        }
+    } else {
+        for (size_t i = 0; i < run->n; i += 1) {
+            nodes[i] = doubly_linked_list_new((int) i);
+        }
+    }
+    run_stop(run);
+    run->ops = run->n;
+
+    if (!run->pooled) {
+        for (size_t i = 0; i < run->n; i += 1) {
+            free(nodes[i]);
+        }
+    }
+    free(nodes);
+}
+
+static void case_doubly_free(Bench_Run* run) {
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+        run_start(run);
+        doubly_linked_list_free(head);
+        run_stop(run);
+    }
+}
+
+static void case_doubly_count(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    size_t total = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        total += doubly_linked_list_count(head);
+    }
+    run_stop(run);
+    assert(total == run->ops * run->n);
+    free_doubly(run, head);
+}
+
+static void case_doubly_print(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_linked_list_print(head);
+    }
+    fflush(stdout);
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_print_backward(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_linked_list_print_backward(head);
+    }
+    fflush(stdout);
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_insert_head(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = run->n;
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            doubly_linked_list_insert_head_pooled(&run->pool, head, (int) i);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            doubly_linked_list_insert_head(head, (int) i);
+        }
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_insert_tail(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            doubly_linked_list_insert_tail_pooled(&run->pool, head, (int) i);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            doubly_linked_list_insert_tail(head, (int) i);
+        }
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_insert(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        size_t idx = pick(run, i, run->n);
+        if (run->pooled) {
+            doubly_linked_list_insert_pooled(&run->pool, head, idx, (int) i);
+        } else {
+            doubly_linked_list_insert(head, idx, (int) i);
+        }
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_remove_head(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = run->n / 2;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        int removed_val;
+        if (run->pooled) {
+            doubly_linked_list_remove_head_pooled(&run->pool, head, &removed_val);
+        } else {
+            doubly_linked_list_remove_head(head, &removed_val);
+        }
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_remove_tail(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        int removed_val;
+        if (run->pooled) {
+            doubly_linked_list_remove_tail_pooled(&run->pool, head, &removed_val);
+        } else {
+            doubly_linked_list_remove_tail(head, &removed_val);
+        }
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_remove(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        int removed_val;
+        size_t idx = pick(run, i, run->n - i - 1);
+        if (run->pooled) {
+            doubly_linked_list_remove_pooled(&run->pool, head, idx, &removed_val);
+        } else {
+            doubly_linked_list_remove(head, idx, &removed_val);
+        }
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_search(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    size_t found = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        size_t found_idx;
+        found += doubly_linked_list_search(head, (int) pick(run, i, run->n), &found_idx);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    free_doubly(run, head);
+}
+
+static void case_doubly_get(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    size_t found = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        int get_val;
+        found += doubly_linked_list_get(head, pick(run, i, run->n), &get_val);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    free_doubly(run, head);
+}
+
+static void case_doubly_set(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_linked_list_set(head, pick(run, i, run->n), (int) i);
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+static void case_doubly_reverse(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        head = doubly_linked_list_reverse(head);
+    }
+    run_stop(run);
+    free_doubly(run, head);
+}
+
+// ========= doubly list handle =========
+
+static void build_doubly_list(Bench_Run* run, Doubly_List* list, size_t n) {
+    doubly_list_init_pooled(list, run_pool(run));
+    for (size_t i = 0; i < n; i += 1) {
+        doubly_list_insert_tail(list, (int) i);
+    }
+}
+
+static void case_doubly_list_init(Bench_Run* run) {
+    Doubly_List list;
+    run->ops = run->n;
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            doubly_list_init_pooled(&list, &run->pool);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            doubly_list_init(&list);
+        }
+    }
+    run_stop(run);
+}
+
+static void case_doubly_list_wrap(Bench_Run* run) {
+    Doubly_Linked_List_Node* head = build_doubly(run, run->n);
+    Doubly_List list;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_wrap(&list, head);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_free(Bench_Run* run) {
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Doubly_List list;
+        build_doubly_list(run, &list, run->n);
+        run_start(run);
+        doubly_list_free(&list);
+        run_stop(run);
+    }
+}
+
+static void case_doubly_list_count(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    size_t total = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        total += doubly_list_count(&list);
+    }
+    run_stop(run);
+    assert(total == run->ops * run->n);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_print(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_print(&list);
+    }
+    fflush(stdout);
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_print_backward(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_print_backward(&list);
+    }
+    fflush(stdout);
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_insert_head(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_insert_head(&list, (int) i);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_insert_tail(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_insert_tail(&list, (int) i);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_insert(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_insert(&list, pick(run, i, run->n), (int) i);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_remove_head(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = run->n / 2;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_remove_head(&list, NULL);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_remove_tail(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = run->n / 2;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_remove_tail(&list, NULL);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_remove(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_remove(&list, pick(run, i, run->n - i), NULL);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_search(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    size_t found = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        size_t found_idx;
+        found += doubly_list_search(&list, (int) pick(run, i, run->n), &found_idx);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_get(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    size_t found = 0;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        int get_val;
+        found += doubly_list_get(&list, pick(run, i, run->n), &get_val);
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_set(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_set(&list, pick(run, i, run->n), (int) i);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_reverse(Bench_Run* run) {
+    Doubly_List list;
+    build_doubly_list(run, &list, run->n);
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        doubly_list_reverse(&list);
+    }
+    run_stop(run);
+    doubly_list_free(&list);
+}
+
+static void case_doubly_list_from_array(Bench_Run* run) {
+    int* vals = build_vals(run->n);
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Doubly_List list;
+        run_start(run);
+        doubly_list_from_array(&list, run_pool(run), vals, run->n);
+        run_stop(run);
+        if (run->pooled) {
+            node_pool_destroy(&run->pool);
+        } else {
+            doubly_list_free(&list);
+        }
+    }
+    free(vals);
+}
+
+// ========= red-black tree =========
+
+static void case_rb_new(Bench_Run* run) {
+    Rb_Node** nodes = (Rb_Node**) malloc(run->n * sizeof(Rb_Node*));
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->n; i += 1) {
+            nodes[i] = rb_node_new_pooled(&run->pool, (uint32_t) i, true);
+        }
+    } else {
+        for (size_t i = 0; i < run->n; i += 1) {
+            nodes[i] = rb_node_new((uint32_t) i, true);
+        }
+    }
+    run_stop(run);
+    run->ops = run->n;
+
+    if (!run->pooled) {
+        for (size_t i = 0; i < run->n; i += 1) {
+            free(nodes[i]);
+        }
+    }
+    free(nodes);
+}
+
+static void case_rb_free(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Rb_Node* root = build_tree(run, keys, run->n);
+        run_start(run);
+        rb_node_free(root);
+        run_stop(run);
+    }
+    free(keys);
+}
+
+static int compare_keys(const void* a, const void* b) {
+    uint32_t lhs = *(const uint32_t*) a;
+    uint32_t rhs = *(const uint32_t*) b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static void case_rb_bulk_load(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    qsort(keys, run->n, sizeof(uint32_t), compare_keys);
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        run_start(run);
+        Rb_Node* root = run->pooled
+            ? rb_node_bulk_load_pooled(&run->pool, keys, NULL, run->n)
+            : rb_node_bulk_load(keys, NULL, run->n);
+        run_stop(run);
+        free_tree(run, root);
+        if (run->pooled) {
+            node_pool_destroy(&run->pool);
+        }
+    }
+    free(keys);
+}
+
+static size_t insert_batch(Bench_Run* run, Rb_Node** root, const uint32_t* keys) {
+    return run->pooled ? rb_node_insert_batch_pooled(&run->pool, root, keys, NULL, run->n)
+                       : rb_node_insert_batch(root, keys, NULL, run->n);
+}
+
+// One call inserts the `n` keys as a batch into an empty tree.
+static void case_rb_insert_batch_empty(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    size_t inserted = 0;
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Rb_Node* root = NULL;
+        run_start(run);
+        inserted += insert_batch(run, &root, keys);
+        run_stop(run);
+        free_tree(run, root);
+        if (run->pooled) {
+            node_pool_destroy(&run->pool);
+        }
+    }
+    assert(inserted == run->ops * run->n);
+    free(keys);
+}
+
+// One call inserts a batch of `n` new keys, interleaved with the keys of an `n` key tree.
+static void case_rb_insert_batch(Bench_Run* run) {
+    uint32_t* keys  = build_keys(run, run->n);
+    uint32_t* batch = (uint32_t*) malloc(run->n * sizeof(uint32_t));
+    for (size_t i = 0; i < run->n; i += 1) {
+        batch[i] = keys[i] + 1;
+    }
+    size_t inserted = 0;
+    run->ops = rebuild_rounds(run->n);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        Rb_Node* root = build_tree(run, keys, run->n);
+        run_start(run);
+        inserted += insert_batch(run, &root, batch);
+        run_stop(run);
+        free_tree(run, root);
+        if (run->pooled) {
+            node_pool_destroy(&run->pool);
+        }
+    }
+    assert(inserted == run->ops * run->n);
+    free(batch);
+    free(keys);
+}
+
+static void case_rb_insert(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = NULL;
+    run->ops = run->n;
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_insert_pooled(&run->pool, &root, keys[i], NULL);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_insert(&root, keys[i], NULL);
+        }
+    }
+    run_stop(run);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_delete(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    run->ops = run->n;
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_delete_pooled(&run->pool, &root, keys[i], NULL);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_delete(&root, keys[i], NULL);
+        }
+    }
+    run_stop(run);
+    assert(root == NULL);
+    free(keys);
+}
+
+static void case_rb_insert_multi(Bench_Run* run) {
+    uint32_t* keys = build_multi_keys(run, run->n);
+    Rb_Node* root = NULL;
+    run->ops = run->n;
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_insert_multi_pooled(&run->pool, &root, keys[i], 1);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_insert_multi(&root, keys[i], 1);
+        }
+    }
+    run_stop(run);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_delete_multi(Bench_Run* run) {
+    uint32_t* keys = build_multi_keys(run, run->n);
+    Rb_Node* root = build_multiset(run, keys, run->n);
+    run->ops = run->n;
+    run_start(run);
+    if (run->pooled) {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_delete_multi_pooled(&run->pool, &root, keys[i], 1);
+        }
+    } else {
+        for (size_t i = 0; i < run->ops; i += 1) {
+            rb_node_delete_multi(&root, keys[i], 1);
+        }
+    }
+    run_stop(run);
+    assert(root == NULL);
+    free(keys);
+}
+
+static void case_rb_count(Bench_Run* run) {
+    uint32_t* keys = build_multi_keys(run, run->n);
+    Rb_Node* root = build_multiset(run, keys, run->n);
+    size_t total = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        total += rb_node_count(root, keys[i]);
+    }
+    run_stop(run);
+    assert(total >= run->ops);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_find(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    size_t found = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        found += rb_node_find(root, keys[i]) != NULL;
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_lower_bound(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    size_t found = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        found += rb_node_lower_bound(root, keys[i] + 1) != NULL;
+    }
+    run_stop(run);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_upper_bound(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    size_t found = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        found += rb_node_upper_bound(root, keys[i]) != NULL;
+    }
+    run_stop(run);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_next(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    Rb_Node* node = rb_node_lower_bound(root, 0);
+    run->ops = 0;
+    run_start(run);
+    for (;node != NULL; node = rb_node_next(node)) {
+        run->ops += 1;
+    }
+    run_stop(run);
+    assert(run->ops == run->n);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_prev(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    Rb_Node* node = root;
+    while (node->right != NULL) {
+        node = node->right;
+    }
+    run->ops = 0;
+    run_start(run);
+    for (;node != NULL; node = rb_node_prev(node)) {
+        run->ops += 1;
+    }
+    run_stop(run);
+    assert(run->ops == run->n);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_first(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    size_t found = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        found += rb_node_first(root)->key == 0;
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_last(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    size_t found = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        found += rb_node_last(root)->key == (uint32_t) (run->n - 1) * 3;
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    free_tree(run, root);
+    free(keys);
+}
+
+// Full scan: one op per node returned by an iterator over every key.
+static void case_rb_iterator_next(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    run->ops = 0;
+    run_start(run);
+    Rb_Iterator iterator = rb_iterator_range(root, 0, UINT32_MAX);
+    while (rb_iterator_next(&iterator) != NULL) {
+        run->ops += 1;
+    }
+    run_stop(run);
+    assert(run->ops == run->n);
+    free_tree(run, root);
+    free(keys);
+}
+
+// Bounded ranges: one op per range of `RANGE_KEYS` keys, from a key of the tree to the
+// end of the range, each iterated to the end.
+static void case_rb_iterator_range(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    size_t visited = 0;
+    run->ops = LINEAR_BUDGET / RANGE_KEYS < run->n ? LINEAR_BUDGET / RANGE_KEYS : run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        uint32_t lo = keys[i];
+        Rb_Iterator iterator = rb_iterator_range(root, lo, lo + (RANGE_KEYS - 1) * 3);
+        while (rb_iterator_next(&iterator) != NULL) {
+            visited += 1;
+        }
+    }
+    run_stop(run);
+    assert(visited > 0);
+    free_tree(run, root);
+    free(keys);
+}
+
+static void case_rb_validate(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    Rb_Node* root = build_tree(run, keys, run->n);
+    bool valid = true;
+    run->ops = linear_ops(run->n);
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        valid &= rb_node_validate(root);
+    }
+    run_stop(run);
+    assert(valid);
+    free_tree(run, root);
+    free(keys);
+}
+
+// ========= i32 red-black tree (template instantiation) =========
+
+static I32_Rb_Node* build_i32_tree(Bench_Run* run, const uint32_t* keys, size_t n) {
+    I32_Rb_Node* root = NULL;
+    for (size_t i = 0; i < n; i += 1) {
+        i32_rb_node_insert_pooled(run_pool(run), &root, (int32_t) keys[i], NULL);
+    }
+    return root;
+}
+
+static void free_i32_tree(Bench_Run* run, I32_Rb_Node* root) {
+    if (!run->pooled) {
+        i32_rb_node_free(root);
+    }
+}
+
+static void case_i32_rb_insert(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    I32_Rb_Node* root = NULL;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        i32_rb_node_insert_pooled(run_pool(run), &root, (int32_t) keys[i], NULL);
+    }
+    run_stop(run);
+    free_i32_tree(run, root);
+    free(keys);
+}
+
+static void case_i32_rb_delete(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    I32_Rb_Node* root = build_i32_tree(run, keys, run->n);
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        i32_rb_node_delete_pooled(run_pool(run), &root, (int32_t) keys[i], NULL);
+    }
+    run_stop(run);
+    assert(root == NULL);
+    free(keys);
+}
+
+static void case_i32_rb_find(Bench_Run* run) {
+    uint32_t* keys = build_keys(run, run->n);
+    I32_Rb_Node* root = build_i32_tree(run, keys, run->n);
+    size_t found = 0;
+    run->ops = run->n;
+    run_start(run);
+    for (size_t i = 0; i < run->ops; i += 1) {
+        found += i32_rb_node_find(root, (int32_t) keys[i]) != NULL;
+    }
+    run_stop(run);
+    assert(found == run->ops);
+    free_i32_tree(run, root);
+    free(keys);
+}
+
+static const Bench_Case bench_cases[] = {
+    { "singly_node", "singly_linked_list_new",            LIST_PATTERNS, false, case_singly_new },
+    { "singly_node", "singly_linked_list_len",            LIST_PATTERNS, false, case_singly_len },
+    { "singly_node", "singly_linked_list_print",          LIST_PATTERNS, false, case_singly_print },
+    { "singly_node", "singly_linked_list_append",         LIST_PATTERNS, false, case_singly_append },
+    { "singly_node", "singly_linked_list_insert",         LIST_PATTERNS, false, case_singly_insert },
+    { "singly_node", "singly_linked_list_remove",         LIST_PATTERNS, false, case_singly_remove },
+    { "singly_node", "singly_linked_list_lookup",         LIST_PATTERNS, false, case_singly_lookup },
+    { "singly_node", "singly_linked_list_free",           LIST_PATTERNS, false, case_singly_free },
+    { "singly_node", "singly_linked_list_new_pooled",     LIST_PATTERNS, true,  case_singly_new },
+    { "singly_node", "singly_linked_list_append_pooled",  LIST_PATTERNS, true,  case_singly_append },
+    { "singly_node", "singly_linked_list_insert_pooled",  LIST_PATTERNS, true,  case_singly_insert },
+    { "singly_node", "singly_linked_list_remove_pooled",  LIST_PATTERNS, true,  case_singly_remove },
+
+    { "singly_list", "singly_list_init",                  LIST_PATTERNS, false, case_singly_list_init },
+    { "singly_list", "singly_list_init_pooled",           LIST_PATTERNS, true,  case_singly_list_init },
+    { "singly_list", "singly_list_wrap",                  LIST_PATTERNS, false, case_singly_list_wrap },
+    { "singly_list", "singly_list_free",                  LIST_PATTERNS, false, case_singly_list_free },
+    { "singly_list", "singly_list_len",                   LIST_PATTERNS, false, case_singly_list_len },
+    { "singly_list", "singly_list_print",                 LIST_PATTERNS, false, case_singly_list_print },
+    { "singly_list", "singly_list_push_front",            LIST_PATTERNS, false, case_singly_list_push_front },
+    { "singly_list", "singly_list_append",                LIST_PATTERNS, false, case_singly_list_append },
+    { "singly_list", "singly_list_insert",                LIST_PATTERNS, false, case_singly_list_insert },
+    { "singly_list", "singly_list_remove",                LIST_PATTERNS, false, case_singly_list_remove },
+    { "singly_list", "singly_list_lookup",                LIST_PATTERNS, false, case_singly_list_lookup },
+    { "singly_list", "singly_list_get",                   LIST_PATTERNS, false, case_singly_list_get },
+    { "singly_list", "singly_list_set",                   LIST_PATTERNS, false, case_singly_list_set },
+    { "singly_list", "singly_list_from_array",            PATTERN_SEQUENTIAL, false, case_singly_list_from_array },
+    { "singly_list", "singly_list_from_array_pooled",     PATTERN_SEQUENTIAL, true,  case_singly_list_from_array },
+
+    { "doubly_node", "doubly_linked_list_new",            LIST_PATTERNS, false, case_doubly_new },
+    { "doubly_node", "doubly_linked_list_free",           LIST_PATTERNS, false, case_doubly_free },
+    { "doubly_node", "doubly_linked_list_count",          LIST_PATTERNS, false, case_doubly_count },
+    { "doubly_node", "doubly_linked_list_print",          LIST_PATTERNS, false, case_doubly_print },
+    { "doubly_node", "doubly_linked_list_print_backward", LIST_PATTERNS, false, case_doubly_print_backward },
+    { "doubly_node", "doubly_linked_list_insert_head",    LIST_PATTERNS, false, case_doubly_insert_head },
+    { "doubly_node", "doubly_linked_list_insert_tail",    LIST_PATTERNS, false, case_doubly_insert_tail },
+    { "doubly_node", "doubly_linked_list_insert",         LIST_PATTERNS, false, case_doubly_insert },
+    { "doubly_node", "doubly_linked_list_remove_head",    LIST_PATTERNS, false, case_doubly_remove_head },
+    { "doubly_node", "doubly_linked_list_remove_tail",    LIST_PATTERNS, false, case_doubly_remove_tail },
+    { "doubly_node", "doubly_linked_list_remove",         LIST_PATTERNS, false, case_doubly_remove },
+    { "doubly_node", "doubly_linked_list_search",         LIST_PATTERNS, false, case_doubly_search },
+    { "doubly_node", "doubly_linked_list_get",            LIST_PATTERNS, false, case_doubly_get },
+    { "doubly_node", "doubly_linked_list_set",            LIST_PATTERNS, false, case_doubly_set },
+    { "doubly_node", "doubly_linked_list_reverse",        LIST_PATTERNS, false, case_doubly_reverse },
+    { "doubly_node", "doubly_linked_list_new_pooled",         LIST_PATTERNS, true, case_doubly_new },
+    { "doubly_node", "doubly_linked_list_insert_head_pooled", LIST_PATTERNS, true, case_doubly_insert_head },
+    { "doubly_node", "doubly_linked_list_insert_tail_pooled", LIST_PATTERNS, true, case_doubly_insert_tail },
+    { "doubly_node", "doubly_linked_list_insert_pooled",      LIST_PATTERNS, true, case_doubly_insert },
+    { "doubly_node", "doubly_linked_list_remove_head_pooled", LIST_PATTERNS, true, case_doubly_remove_head },
+    { "doubly_node", "doubly_linked_list_remove_tail_pooled", LIST_PATTERNS, true, case_doubly_remove_tail },
+    { "doubly_node", "doubly_linked_list_remove_pooled",      LIST_PATTERNS, true, case_doubly_remove },
+
+    { "doubly_list", "doubly_list_init",                  LIST_PATTERNS, false, case_doubly_list_init },
+    { "doubly_list", "doubly_list_init_pooled",           LIST_PATTERNS, true,  case_doubly_list_init },
+    { "doubly_list", "doubly_list_wrap",                  LIST_PATTERNS, false, case_doubly_list_wrap },
+    { "doubly_list", "doubly_list_free",                  LIST_PATTERNS, false, case_doubly_list_free },
+    { "doubly_list", "doubly_list_count",                 LIST_PATTERNS, false, case_doubly_list_count },
+    { "doubly_list", "doubly_list_print",                 LIST_PATTERNS, false, case_doubly_list_print },
+    { "doubly_list", "doubly_list_print_backward",        LIST_PATTERNS, false, case_doubly_list_print_backward },
+    { "doubly_list", "doubly_list_insert_head",           LIST_PATTERNS, false, case_doubly_list_insert_head },
+    { "doubly_list", "doubly_list_insert_tail",           LIST_PATTERNS, false, case_doubly_list_insert_tail },
+    { "doubly_list", "doubly_list_insert",                LIST_PATTERNS, false, case_doubly_list_insert },
+    { "doubly_list", "doubly_list_remove_head",           LIST_PATTERNS, false, case_doubly_list_remove_head },
+    { "doubly_list", "doubly_list_remove_tail",           LIST_PATTERNS, false, case_doubly_list_remove_tail },
+    { "doubly_list", "doubly_list_remove",                LIST_PATTERNS, false, case_doubly_list_remove },
+    { "doubly_list", "doubly_list_search",                LIST_PATTERNS, false, case_doubly_list_search },
+    { "doubly_list", "doubly_list_get",                   LIST_PATTERNS, false, case_doubly_list_get },
+    { "doubly_list", "doubly_list_set",                   LIST_PATTERNS, false, case_doubly_list_set },
+    { "doubly_list", "doubly_list_reverse",               LIST_PATTERNS, false, case_doubly_list_reverse },
+    { "doubly_list", "doubly_list_from_array",            PATTERN_SEQUENTIAL, false, case_doubly_list_from_array },
+    { "doubly_list", "doubly_list_from_array_pooled",     PATTERN_SEQUENTIAL, true,  case_doubly_list_from_array },
+
+    { "rb_node", "rb_node_new",                           TREE_PATTERNS, false, case_rb_new },
+    { "rb_node", "rb_node_free",                          TREE_PATTERNS, false, case_rb_free },
+    { "rb_node", "rb_node_insert",                        TREE_PATTERNS, false, case_rb_insert },
+    { "rb_node", "rb_node_delete",                        TREE_PATTERNS, false, case_rb_delete },
+    { "rb_node", "rb_node_insert_multi",                  MULTI_PATTERNS, false, case_rb_insert_multi },
+    { "rb_node", "rb_node_delete_multi",                  MULTI_PATTERNS, false, case_rb_delete_multi },
+    { "rb_node", "rb_node_count",                         MULTI_PATTERNS, false, case_rb_count },
+    { "rb_node", "rb_node_find",                          TREE_PATTERNS, false, case_rb_find },
+    { "rb_node", "rb_node_lower_bound",                   TREE_PATTERNS, false, case_rb_lower_bound },
+    { "rb_node", "rb_node_upper_bound",                   TREE_PATTERNS, false, case_rb_upper_bound },
+    { "rb_node", "rb_node_next",                          TREE_PATTERNS, false, case_rb_next },
+    { "rb_node", "rb_node_prev",                          TREE_PATTERNS, false, case_rb_prev },
+    { "rb_node", "rb_node_first",                         TREE_PATTERNS, false, case_rb_first },
+    { "rb_node", "rb_node_last",                          TREE_PATTERNS, false, case_rb_last },
+    { "rb_node", "rb_iterator_next",                      TREE_PATTERNS, false, case_rb_iterator_next },
+    { "rb_node", "rb_iterator_range",                     TREE_PATTERNS, false, case_rb_iterator_range },
+    { "rb_node", "rb_node_validate",                      TREE_PATTERNS, false, case_rb_validate },
+    { "rb_node", "rb_node_new_pooled",                    TREE_PATTERNS, true,  case_rb_new },
+    { "rb_node", "rb_node_insert_pooled",                 TREE_PATTERNS, true,  case_rb_insert },
+    { "rb_node", "rb_node_delete_pooled",                 TREE_PATTERNS, true,  case_rb_delete },
+    { "rb_node", "rb_node_insert_multi_pooled",           MULTI_PATTERNS, true,  case_rb_insert_multi },
+    { "rb_node", "rb_node_delete_multi_pooled",           MULTI_PATTERNS, true,  case_rb_delete_multi },
+    { "rb_node", "rb_node_bulk_load",                     PATTERN_SORTED, false, case_rb_bulk_load },
+    { "rb_node", "rb_node_bulk_load_pooled",              PATTERN_SORTED, true,  case_rb_bulk_load },
+    { "rb_node", "rb_node_insert_batch",                  TREE_PATTERNS, false, case_rb_insert_batch },
+    { "rb_node", "rb_node_insert_batch_pooled",           TREE_PATTERNS, true,  case_rb_insert_batch },
+    { "rb_node_empty", "rb_node_insert_batch",            TREE_PATTERNS, false, case_rb_insert_batch_empty },
+    { "rb_node_empty", "rb_node_insert_batch_pooled",     TREE_PATTERNS, true,  case_rb_insert_batch_empty },
+
+    { "i32_rb_node", "i32_rb_node_insert",                TREE_PATTERNS, false, case_i32_rb_insert },
+    { "i32_rb_node", "i32_rb_node_delete",                TREE_PATTERNS, false, case_i32_rb_delete },
+    { "i32_rb_node", "i32_rb_node_find",                  TREE_PATTERNS, false, case_i32_rb_find },
+    { "i32_rb_node", "i32_rb_node_insert_pooled",         TREE_PATTERNS, true,  case_i32_rb_insert },
+    { "i32_rb_node", "i32_rb_node_delete_pooled",         TREE_PATTERNS, true,  case_i32_rb_delete },
+};
+
+static size_t pool_node_size(const Bench_Case* bench_case) {
+    if (strncmp(bench_case->structure, "singly", 6) == 0) {
+        return sizeof(Singly_Linked_List_Node);
+    }
+    if (strncmp(bench_case->structure, "doubly", 6) == 0) {
+        return sizeof(Doubly_Linked_List_Node);
+    }
+    if (strncmp(bench_case->structure, "i32", 3) == 0) {
+        return sizeof(I32_Rb_Node);
+    }
+    return sizeof(Rb_Node);
+}
+
+static const char* pattern_name(Bench_Pattern pattern) {
+    switch (pattern) {
+        case PATTERN_SEQUENTIAL: return "sequential";
+        case PATTERN_RANDOM:     return "random";
+        case PATTERN_SORTED:     return "sorted";
+        case PATTERN_ZIPF:       return "zipf";
+    }
+    return "unknown";
+}
+
+// Runs a single case in a forked child writing its CSV row to `out_fd`, so that
+// the peak RSS of the child only accounts for this case.
+static bool run_case_isolated(const Bench_Case* bench_case, Bench_Pattern pattern, size_t n, int out_fd) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return false;
+    }
+
+    if (pid == 0) {
+        FILE* out = fdopen(out_fd, "w");
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (out == NULL || null_fd < 0) {
+            _exit(1);
+        }
+        dup2(null_fd, STDOUT_FILENO);
+
+        Bench_Run run;
+        memset(&run, 0, sizeof(run));
+        run.n       = n;
+        run.pattern = pattern;
+        run.pooled  = bench_case->pooled;
+        run.seed    = 2463534242u;
+        node_pool_init(&run.pool, pool_node_size(bench_case), 0);
+
+        bench_case->run(&run);
+
+        long peak_rss_kb = bench_peak_rss_kb();
+        node_pool_destroy(&run.pool);
+        bench_csv_row(out, bench_case->structure, bench_case->function, pattern_name(pattern),
+                      n, run.ops, run.elapsed_ns, peak_rss_kb);
+        fflush(out);
+        _exit(0);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "%s (%s, n=%zu) failed\n", bench_case->function, pattern_name(pattern), n);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    size_t max_n = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : DEFAULT_MAX_N;
+    const char* filter = argc > 2 ? argv[2] : NULL;
+
+    // The children write to a duplicate of the standard output, theirs goes to /dev/null.
+    int out_fd = dup(STDOUT_FILENO);
+    bench_csv_header(stdout);
+
+    bool all_ok = true;
+    size_t case_count = sizeof(bench_cases) / sizeof(bench_cases[0]);
+    for (size_t n = MIN_N; n <= max_n; n *= 10) {
+        for (size_t i = 0; i < case_count; i += 1) {
+            const Bench_Case* bench_case = &bench_cases[i];
+            if (filter != NULL && strstr(bench_case->function, filter) == NULL) {
+                continue;
+            }
+
+            for (int pattern = 1; pattern <= PATTERN_ZIPF; pattern <<= 1) {
+                if ((bench_case->patterns & pattern) != 0) {
+                    all_ok &= run_case_isolated(bench_case, (Bench_Pattern) pattern, n, out_fd);
+                }
+            }
+        }
+    }
+
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+// Bulk construction from sorted input against one insertion per key.
+//
+// For 10^5 to 10^7 sorted keys: building a red-black tree with `rb_node_insert`
+// per key, with `rb_node_bulk_load` (one allocation per node, O(n)) and with
+// `rb_node_bulk_load_pooled` (a single allocation), then the lookup time on each
+// result, since the pooled tree has its nodes laid out in key order. The lists are
+// compared the same way: appends through the handle against `_from_array`.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "linkedlist.h"
+#include "tree/red_black_tree.h"
+
+#define LOOKUPS 1000000
+
+static double lookup_ns(Rb_Node* root, const uint32_t* keys, size_t n) {
+    uint32_t seed = 2463534242u;
+    size_t found = 0;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += rb_node_find(root, keys[bench_xorshift32(&seed) % n]) != NULL;
+    }
+    double elapsed = (double) (bench_now_ns() - start) / LOOKUPS;
+    return found == LOOKUPS ? elapsed : -1.0;
+}
+
+static void bench_tree(size_t n) {
+    uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i += 1) {
+        keys[i] = (uint32_t) (i * 3);
+    }
+
+    Rb_Node* root = NULL;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&root, keys[i], NULL);
+    }
+    double insert_ms = (double) (bench_now_ns() - start) / 1e6;
+    double insert_lookup_ns = lookup_ns(root, keys, n);
+    rb_node_free(root);
+
+    start = bench_now_ns();
+    root = rb_node_bulk_load(keys, NULL, n);
+    double bulk_ms = (double) (bench_now_ns() - start) / 1e6;
+    double bulk_lookup_ns = lookup_ns(root, keys, n);
+    bool valid = rb_node_validate(root);
+    rb_node_free(root);
+
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Rb_Node), 0);
+    start = bench_now_ns();
+    root = rb_node_bulk_load_pooled(&pool, keys, NULL, n);
+    double pooled_ms = (double) (bench_now_ns() - start) / 1e6;
+    double pooled_lookup_ns = lookup_ns(root, keys, n);
+    valid = valid && rb_node_validate(root);
+    node_pool_destroy(&pool);
+
+    printf("%-10s %-10zu %12.1f %12.1f %12.1f %10.1f %10.1f %10.1f%s\n", "rb_node", n,
+           insert_ms, bulk_ms, pooled_ms, insert_lookup_ns, bulk_lookup_ns, pooled_lookup_ns,
+           valid ? "" : " (INVALID)");
+    free(keys);
+}
+
+static void bench_lists(size_t n) {
+    int* vals = (int*) malloc(n * sizeof(int));
+    for (size_t i = 0; i < n; i += 1) {
+        vals[i] = (int) i;
+    }
+
+    Singly_List singly;
+    singly_list_init(&singly);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        singly_list_append(&singly, vals[i]);
+    }
+    double singly_append_ms = (double) (bench_now_ns() - start) / 1e6;
+    singly_list_free(&singly);
+
+    start = bench_now_ns();
+    singly_list_from_array(&singly, NULL, vals, n);
+    double singly_bulk_ms = (double) (bench_now_ns() - start) / 1e6;
+    singly_list_free(&singly);
+
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+    start = bench_now_ns();
+    singly_list_from_array(&singly, &pool, vals, n);
+    double singly_pooled_ms = (double) (bench_now_ns() - start) / 1e6;
+    node_pool_destroy(&pool);
+
+    printf("%-10s %-10zu %12.1f %12.1f %12.1f\n", "singly", n, singly_append_ms, singly_bulk_ms, singly_pooled_ms);
+
+    Doubly_List doubly;
+    doubly_list_init(&doubly);
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        doubly_list_insert_tail(&doubly, vals[i]);
+    }
+    double doubly_append_ms = (double) (bench_now_ns() - start) / 1e6;
+    doubly_list_free(&doubly);
+
+    start = bench_now_ns();
+    doubly_list_from_array(&doubly, NULL, vals, n);
+    double doubly_bulk_ms = (double) (bench_now_ns() - start) / 1e6;
+    doubly_list_free(&doubly);
+
+    node_pool_init(&pool, sizeof(Doubly_Linked_List_Node), 0);
+    start = bench_now_ns();
+    doubly_list_from_array(&doubly, &pool, vals, n);
+    double doubly_pooled_ms = (double) (bench_now_ns() - start) / 1e6;
+    node_pool_destroy(&pool);
+
+    printf("%-10s %-10zu %12.1f %12.1f %12.1f\n", "doubly", n, doubly_append_ms, doubly_bulk_ms, doubly_pooled_ms);
+    free(vals);
+}
+
+int main(void) {
+    printf("build times in ms, lookup times in ns\n");
+    printf("%-10s %-10s %12s %12s %12s %10s %10s %10s\n", "structure", "n",
+           "per_key", "bulk", "bulk_pooled", "lookup", "lookup", "lookup");
+    for (size_t n = 100000; n <= 10000000; n *= 10) {
+        bench_tree(n);
+        bench_lists(n);
+    }
+    return 0;
+}
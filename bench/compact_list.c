@@ -0,0 +1,177 @@
+// Memory per element and walk speed of `Compact_List` against `Doubly_List`.
+//
+// For 10^5 to `max_n` elements (default 10^7), builds each list by appending, then
+// reports the resident memory the list added per element, the append time, the time
+// to walk it forward and backward, and the time of a cursor pass removing every
+// other element and inserting a new one after each element left. `Doubly_List` is
+// measured with one `malloc` per node and with a node pool.
+//
+// Usage: compact_list [max_n]
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "compact_list.h"
+#include "linkedlist.h"
+
+typedef struct Result {
+    double bytes_per_elem;
+    double build_ns;
+    double forward_ns;
+    double backward_ns;
+    double cursor_ns;
+    long   sum;
+} Result;
+
+static double ns_per_elem(uint64_t start, size_t n) {
+    return (double) (bench_now_ns() - start) / (double) n;
+}
+
+static Result bench_doubly(size_t n, bool pooled) {
+    Result result = { 0 };
+    long rss_before = bench_rss_kb();
+
+    Node_Pool pool;
+    Doubly_List list;
+    if (pooled) {
+        node_pool_init(&pool, sizeof(Doubly_Linked_List_Node), 0);
+        doubly_list_init_pooled(&list, &pool);
+    } else {
+        doubly_list_init(&list);
+    }
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        doubly_list_insert_tail(&list, (int) i);
+    }
+    result.build_ns = ns_per_elem(start, n);
+    result.bytes_per_elem = (double) (bench_rss_kb() - rss_before) * 1024.0 / (double) n;
+
+    start = bench_now_ns();
+    for (Doubly_Linked_List_Node* node = list.head; node != NULL; node = node->next) {
+        result.sum += node->val;
+    }
+    result.forward_ns = ns_per_elem(start, n);
+    start = bench_now_ns();
+    for (Doubly_Linked_List_Node* node = list.tail; node != NULL; node = node->prev) {
+        result.sum -= node->val;
+    }
+    result.backward_ns = ns_per_elem(start, n);
+
+    // The handle has no cursor: the node is unlinked and linked by hand, which is what
+    // a caller holding node pointers would do.
+    start = bench_now_ns();
+    bool remove = true;
+    for (Doubly_Linked_List_Node* node = list.head; node != NULL;) {
+        Doubly_Linked_List_Node* next_node = node->next;
+        if (remove) {
+            if (node->prev != NULL) {
+                node->prev->next = next_node;
+            } else {
+                list.head = next_node;
+            }
+            if (next_node != NULL) {
+                next_node->prev = node->prev;
+            } else {
+                list.tail = node->prev;
+            }
+            if (pooled) {
+                node_pool_release(&pool, node);
+            } else {
+                free(node);
+            }
+        } else {
+            Doubly_Linked_List_Node* new_node = pooled
+                ? (Doubly_Linked_List_Node*) node_pool_alloc(&pool)
+                : (Doubly_Linked_List_Node*) malloc(sizeof(Doubly_Linked_List_Node));
+            new_node->val  = -node->val;
+            new_node->prev = node;
+            new_node->next = next_node;
+            node->next     = new_node;
+            if (next_node != NULL) {
+                next_node->prev = new_node;
+            } else {
+                list.tail = new_node;
+            }
+        }
+        remove = !remove;
+        node = next_node;
+    }
+    result.cursor_ns = ns_per_elem(start, n);
+
+    doubly_list_free(&list);
+    if (pooled) {
+        node_pool_destroy(&pool);
+    }
+    malloc_trim(0);
+    return result;
+}
+
+static Result bench_compact(size_t n) {
+    Result result = { 0 };
+    long rss_before = bench_rss_kb();
+
+    Compact_List list;
+    compact_list_init(&list);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        compact_list_insert_tail(&list, (int) i);
+    }
+    result.build_ns = ns_per_elem(start, n);
+    result.bytes_per_elem = (double) (bench_rss_kb() - rss_before) * 1024.0 / (double) n;
+
+    start = bench_now_ns();
+    for (Compact_List_Cursor cursor = compact_list_first(&list); cursor != COMPACT_LIST_END;
+         cursor = compact_list_next(&list, cursor)) {
+        result.sum += compact_list_value(&list, cursor);
+    }
+    result.forward_ns = ns_per_elem(start, n);
+    start = bench_now_ns();
+    for (Compact_List_Cursor cursor = compact_list_last(&list); cursor != COMPACT_LIST_END;
+         cursor = compact_list_prev(&list, cursor)) {
+        result.sum -= compact_list_value(&list, cursor);
+    }
+    result.backward_ns = ns_per_elem(start, n);
+
+    start = bench_now_ns();
+    bool remove = true;
+    for (Compact_List_Cursor cursor = compact_list_first(&list); cursor != COMPACT_LIST_END;) {
+        if (remove) {
+            cursor = compact_list_erase(&list, cursor);
+        } else {
+            Compact_List_Cursor next_cursor = compact_list_next(&list, cursor);
+            compact_list_insert_after(&list, cursor, -compact_list_value(&list, cursor));
+            cursor = next_cursor;
+        }
+        remove = !remove;
+    }
+    result.cursor_ns = ns_per_elem(start, n);
+
+    compact_list_free(&list);
+    malloc_trim(0);
+    return result;
+}
+
+static void print_row(const char* structure, size_t n, Result result) {
+    printf("%-18s %-10zu %12.1f %10.1f %10.1f %10.1f %10.1f\n", structure, n, result.bytes_per_elem,
+           result.build_ns, result.forward_ns, result.backward_ns, result.cursor_ns);
+    if (result.sum != 0) {
+        printf("mismatch: forward and backward sums differ\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t max_n = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    printf("memory in bytes per element (resident), times in ns per element\n");
+    printf("%-18s %-10s %12s %10s %10s %10s %10s\n", "structure", "n", "bytes/elem", "append", "forward",
+           "backward", "cursor");
+    for (size_t n = 100000; n <= max_n; n *= 10) {
+        print_row("doubly_list", n, bench_doubly(n, false));
+        print_row("doubly_list_pool", n, bench_doubly(n, true));
+        print_row("compact_list", n, bench_compact(n));
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+// Bulk export of a list: one `fprintf` per node against `Export_Writer`.
+//
+// For a singly list of `n` random values (default 10^7), laid out in list order,
+// writes the list to /dev/null and to a temporary file: with one `fprintf` per node
+// through a `FILE`, the way the `_print` procedures used to, and through an export
+// writer in each `Export_Format`. The writer is also measured streaming 64 KiB chunks
+// to a callback, which only checksums them. The file outputs are read back and
+// checked against the values, and every format is checked into a caller buffer of
+// exactly the size of the output, without callback.
+//
+// Usage: export [n]
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "persist/export.h"
+
+typedef enum Method {
+    FPRINTF,
+    WRITER_LINES,
+    WRITER_ARROWS,
+    WRITER_BINARY,
+    METHOD_COUNT,
+} Method;
+
+static const char* method_names[] = {
+    [FPRINTF]       = "fprintf_lines",
+    [WRITER_LINES]  = "export_lines",
+    [WRITER_ARROWS] = "export_arrows",
+    [WRITER_BINARY] = "export_binary",
+};
+
+static bool checksum_chunk(const void* chunk, size_t size, void* ctx) {
+    const unsigned char* bytes = (const unsigned char*) chunk;
+    uint64_t sum = *(uint64_t*) ctx;
+    for (size_t i = 0; i < size; i += 64) {
+        sum += bytes[i];
+    }
+    *(uint64_t*) ctx = sum;
+    return true;
+}
+
+// Writes the list to `fd` and returns the time taken in ms, the file size in `size`.
+static double export_list(Singly_List* list, int fd, Method method, size_t* size) {
+    uint64_t start = bench_now_ns();
+    if (method == FPRINTF) {
+        FILE* file = fdopen(dup(fd), "w");
+        for (Singly_Linked_List_Node* node = list->head; node != NULL; node = node->next) {
+            fprintf(file, "%d\n", node->val);
+        }
+        fclose(file);
+    } else {
+        Export_Format format = method == WRITER_LINES ? EXPORT_TEXT_LINES
+            : method == WRITER_ARROWS ? EXPORT_TEXT_ARROWS : EXPORT_BINARY_LE32;
+        Export_Writer writer;
+        export_writer_init_fd(&writer, fd, format, NULL, 0);
+        export_singly_list(&writer, list);
+        if (!export_writer_finish(&writer)) {
+            printf("export failed\n");
+            exit(1);
+        }
+    }
+    double ms = (double) (bench_now_ns() - start) / 1e6;
+    *size = (size_t) lseek(fd, 0, SEEK_END);
+    return ms;
+}
+
+// Reads the file back and checks it holds the values of the list in the format of `method`.
+static bool check_file(const char* path, Singly_List* list, Method method) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    bool valid = true;
+    for (Singly_Linked_List_Node* node = list->head; node != NULL && valid; node = node->next) {
+        int val;
+        if (method == WRITER_BINARY) {
+            unsigned char bytes[4];
+            valid = fread(bytes, 4, 1, file) == 1;
+            val = (int) ((uint32_t) bytes[0] | (uint32_t) bytes[1] << 8 | (uint32_t) bytes[2] << 16
+                         | (uint32_t) bytes[3] << 24);
+        } else if (method == WRITER_ARROWS) {
+            valid = fscanf(file, node == list->head ? "%d" : " -> %d", &val) == 1;
+        } else {
+            valid = fscanf(file, "%d\n", &val) == 1;
+        }
+        valid = valid && val == node->val;
+    }
+    valid = valid && fgetc(file) == EOF;
+    fclose(file);
+    return valid;
+}
+
+// One `export_int` per value: `export_ints` copies binary output in bulk.
+static void export_values(Export_Writer* writer, const int* vals, size_t n) {
+    for (size_t i = 0; i < n; i += 1) {
+        export_int(writer, vals[i]);
+    }
+}
+
+// Exports the first `n` values into a caller buffer without callback of exactly the
+// size of the output, which must succeed with the expected bytes, then one byte
+// smaller, which must fail. Outputs below the smallest buffer are not checked.
+static bool check_exact_buffer(const int* vals, size_t n, Export_Format format) {
+    unsigned char expected[64 * 16];
+    size_t expected_len = 0;
+    for (size_t i = 0; i < n; i += 1) {
+        if (format == EXPORT_BINARY_LE32) {
+            uint32_t bits = (uint32_t) vals[i];
+            for (size_t byte = 0; byte < 4; byte += 1) {
+                expected[expected_len++] = (unsigned char) (bits >> (8 * byte));
+            }
+        } else {
+            const char* pattern = format == EXPORT_TEXT_LINES ? "%d\n" : i > 0 ? " -> %d" : "%d";
+            expected_len += (size_t) snprintf((char*) expected + expected_len, sizeof(expected) - expected_len,
+                                              pattern, vals[i]);
+        }
+    }
+
+    if (expected_len < EXPORT_MIN_BUFFER_SIZE) {
+        return true;
+    }
+
+    unsigned char buffer[sizeof(expected)];
+    Export_Writer writer;
+    export_writer_init_buffer(&writer, buffer, expected_len, format, NULL, NULL);
+    export_values(&writer, vals, n);
+    if (!export_writer_finish(&writer) || writer.len != expected_len || memcmp(buffer, expected, expected_len) != 0) {
+        return false;
+    }
+
+    if (expected_len == EXPORT_MIN_BUFFER_SIZE) {
+        return true;
+    }
+    export_writer_init_buffer(&writer, buffer, expected_len - 1, format, NULL, NULL);
+    export_values(&writer, vals, n);
+    return !export_writer_finish(&writer);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    int* vals = (int*) malloc(n * sizeof(int));
+    if (vals == NULL) {
+        printf("Unable to allocate more memory.\n");
+        return 1;
+    }
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < n; i += 1) {
+        vals[i] = (int) bench_xorshift32(&seed);
+    }
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+    Singly_List list;
+    singly_list_from_array(&list, &pool, vals, n);
+
+    char path[] = "/tmp/export_bench_XXXXXX";
+    int file_fd = mkstemp(path);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (file_fd < 0 || null_fd < 0) {
+        printf("Unable to open the outputs.\n");
+        return 1;
+    }
+
+    printf("%zu elements, times in ms\n", n);
+    printf("%-15s %12s %12s %12s %10s\n", "method", "/dev/null", "file", "file_MB", "MB/s");
+    for (Method method = FPRINTF; method < METHOD_COUNT; method += 1) {
+        size_t size;
+        double null_ms = export_list(&list, null_fd, method, &size);
+        if (ftruncate(file_fd, 0) != 0 || lseek(file_fd, 0, SEEK_SET) != 0) {
+            printf("Unable to truncate the output file.\n");
+            return 1;
+        }
+        double file_ms = export_list(&list, file_fd, method, &size);
+        printf("%-15s %12.1f %12.1f %12.1f %10.0f%s\n", method_names[method], null_ms, file_ms, (double) size / 1e6,
+               (double) size / 1e6 / (file_ms / 1e3), check_file(path, &list, method) ? "" : " (MISMATCH)");
+    }
+
+    static const int small_vals[] = { 1, 2, 3, 4 };
+    static const Export_Format formats[] = { EXPORT_TEXT_LINES, EXPORT_TEXT_ARROWS, EXPORT_BINARY_LE32 };
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i += 1) {
+        // 1 to 4 fill the smallest buffer in arrows and binary, 64 random values need elements of every size.
+        bool valid = check_exact_buffer(small_vals, 4, formats[i]);
+        valid = valid && check_exact_buffer(vals, n < 64 ? n : 64, formats[i]);
+        if (!valid) {
+            printf("export into an exactly sized buffer failed, format %d\n", (int) formats[i]);
+            return 1;
+        }
+    }
+
+    unsigned char chunk[1 << 16];
+    uint64_t checksum = 0;
+    uint64_t start = bench_now_ns();
+    Export_Writer writer;
+    export_writer_init_buffer(&writer, chunk, sizeof(chunk), EXPORT_TEXT_LINES, checksum_chunk, &checksum);
+    export_singly_list(&writer, &list);
+    export_writer_finish(&writer);
+    printf("%-15s %12.1f (64 KiB chunks to a callback, checksum %llu)\n", "export_chunks",
+           (double) (bench_now_ns() - start) / 1e6, (unsigned long long) checksum);
+
+    close(null_fd);
+    close(file_fd);
+    unlink(path);
+    node_pool_destroy(&pool);
+    free(vals);
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Cost of the hot path instrumentation of src/instrument.h.
+//
+// Built twice by `make bench`: `instrument` without the counters and `instrument_on`
+// with `-DDS_INSTRUMENT`. Both time the same workload, positional reads of a doubly
+// list and inserts, finds and deletes of a red-black tree. Comparing their ns/op gives
+// the overhead of the counters; `instrument_on` then writes them as JSON to `json_path`,
+// or to stdout when no path is given.
+//
+// Usage: instrument [n] [json_path]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "instrument.h"
+#include "linkedlist.h"
+#include "tree/red_black_tree.h"
+
+#define LIST_GETS 20000
+
+static double ns_per_op(uint64_t start, size_t ops) {
+    return (double) (bench_now_ns() - start) / (double) ops;
+}
+
+int main(int argc, char** argv) {
+    size_t n              = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 1000000;
+    const char* json_path = argc > 2 ? argv[2] : NULL;
+    size_t list_n         = n < 10000 ? n : 10000;
+
+    uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+    uint32_t seed = 88675123u;
+    for (size_t i = 0; i < n; i += 1) {
+        keys[i] = bench_xorshift32(&seed);
+    }
+
+    printf("instrumentation %s\n", instrument_enabled() ? "on" : "off");
+    printf("%-20s %10s %10s\n", "op", "n", "ns/op");
+
+    Doubly_List list;
+    doubly_list_init(&list);
+    for (size_t i = 0; i < list_n; i += 1) {
+        doubly_list_insert_tail(&list, (int) i);
+    }
+    long sum = 0;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < LIST_GETS; i += 1) {
+        int val;
+        doubly_list_get(&list, bench_xorshift32(&seed) % list_n, &val);
+        sum += val;
+    }
+    printf("%-20s %10zu %10.1f\n", "doubly_list_get", list_n, ns_per_op(start, LIST_GETS));
+
+    Rb_Node* root = NULL;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&root, keys[i], NULL);
+    }
+    printf("%-20s %10zu %10.1f\n", "rb_node_insert", n, ns_per_op(start, n));
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        found += rb_node_find(root, keys[bench_xorshift32(&seed) % n]) != NULL;
+    }
+    printf("%-20s %10zu %10.1f\n", "rb_node_find", n, ns_per_op(start, n));
+
+    size_t deleted = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        deleted += rb_node_delete(&root, keys[i], NULL);
+    }
+    printf("%-20s %10zu %10.1f\n", "rb_node_delete", n, ns_per_op(start, n));
+
+    if (found != n || root != NULL || sum < 0) {
+        printf("mismatch: %zu found, %zu deleted\n", found, deleted);
+    }
+
+    if (instrument_enabled()) {
+        FILE* out = json_path != NULL ? fopen(json_path, "w") : stdout;
+        if (out == NULL) {
+            printf("unable to open %s\n", json_path);
+            exit(1);
+        }
+        instrument_dump_json(out);
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+
+    doubly_list_free(&list);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,246 @@
+// List radix sort against the list merge sort, and the relinking partitions.
+//
+// For 10^5 to `max_n` elements (default 10^7), sorts a singly and a doubly list of
+// random, presorted, bytes (values in 0 .. 255) and few distinct values with the
+// merge sort and the radix sort, then times a stable partition of the even values and
+// a split at 0 of the random list. Every result is checked: sorted, stable partition
+// and split, no node lost.
+//
+// Usage: list_radix_sort [max_n]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "sort/list_sort.h"
+
+typedef enum Pattern {
+    RANDOM,
+    SORTED,
+    BYTES,
+    FEW_DISTINCT,
+} Pattern;
+
+static const char* pattern_names[] = {
+    [RANDOM]       = "random",
+    [SORTED]       = "sorted",
+    [BYTES]        = "bytes",
+    [FEW_DISTINCT] = "few_distinct",
+};
+
+static void fill(int* vals, size_t n, Pattern pattern) {
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < n; i += 1) {
+        switch (pattern) {
+            case RANDOM:       vals[i] = (int) bench_xorshift32(&seed); break;
+            case SORTED:       vals[i] = (int) i; break;
+            case BYTES:        vals[i] = (int) (bench_xorshift32(&seed) & 0xff); break;
+            case FEW_DISTINCT: vals[i] = (int) (bench_xorshift32(&seed) % 16) - 8; break;
+        }
+    }
+}
+
+static bool is_even(int val, void* ctx) {
+    (void) ctx;
+    return val % 2 == 0;
+}
+
+static bool is_below_zero(int val, void* ctx) {
+    (void) ctx;
+    return val < 0;
+}
+
+static void fail(const char* list, const char* message) {
+    printf("%s list %s\n", list, message);
+    exit(1);
+}
+
+static double elapsed_ms(uint64_t start) {
+    return (double) (bench_now_ns() - start) / 1e6;
+}
+
+// Copies the values of the list to `out`, checking the links and the cached ends of
+// the handle, and returns their number.
+static size_t singly_values(const Singly_List* list, int* out) {
+    size_t count = 0;
+    for (Singly_Linked_List_Node* node = list->head; node != NULL; node = node->next) {
+        if (node->next == NULL && node != list->tail) {
+            fail("singly", "tail not updated");
+        }
+        out[count++] = node->val;
+    }
+    if (count != list->len) {
+        fail("singly", "lost nodes");
+    }
+    return count;
+}
+
+static size_t doubly_values(const Doubly_List* list, int* out) {
+    size_t count = 0;
+    for (Doubly_Linked_List_Node* node = list->head; node != NULL; node = node->next) {
+        if (node->next != NULL ? node->next->prev != node : node != list->tail) {
+            fail("doubly", "links broken");
+        }
+        out[count++] = node->val;
+    }
+    if (count != list->count) {
+        fail("doubly", "lost nodes");
+    }
+    return count;
+}
+
+static void check_sorted(const char* list, const int* out, size_t n) {
+    for (size_t i = 1; i < n; i += 1) {
+        if (out[i] < out[i - 1]) {
+            fail(list, "not sorted");
+        }
+    }
+}
+
+// Checks that `out` holds the values of `vals` that `pred` accepts, or rejects, in order.
+static void check_stable(const char* list, const int* vals, size_t n, const int* out, size_t out_len,
+                         List_Predicate_Fn pred, bool accepted) {
+    size_t j = 0;
+    for (size_t i = 0; i < n; i += 1) {
+        if (pred(vals[i], NULL) == accepted && (j == out_len || out[j++] != vals[i])) {
+            fail(list, "partition not stable");
+        }
+    }
+    if (j != out_len) {
+        fail(list, "partition not stable");
+    }
+}
+
+static double sort_singly(const int* vals, int* scratch, size_t n, bool radix) {
+    // A fresh pool per run lays the nodes out in list order whatever the heap did before.
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+    Singly_List list;
+    singly_list_from_array(&list, &pool, vals, n);
+
+    uint64_t start = bench_now_ns();
+    if (radix) {
+        singly_list_radix_sort(&list);
+    } else {
+        singly_list_sort(&list);
+    }
+    double ms = elapsed_ms(start);
+
+    check_sorted("singly", scratch, singly_values(&list, scratch));
+    singly_list_free(&list);
+    node_pool_destroy(&pool);
+    return ms;
+}
+
+static double sort_doubly(const int* vals, int* scratch, size_t n, bool radix) {
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Doubly_Linked_List_Node), 0);
+    Doubly_List list;
+    doubly_list_from_array(&list, &pool, vals, n);
+
+    uint64_t start = bench_now_ns();
+    if (radix) {
+        doubly_list_radix_sort(&list);
+    } else {
+        doubly_list_sort(&list);
+    }
+    double ms = elapsed_ms(start);
+
+    check_sorted("doubly", scratch, doubly_values(&list, scratch));
+    doubly_list_free(&list);
+    node_pool_destroy(&pool);
+    return ms;
+}
+
+static void partition_singly(const int* vals, int* scratch, size_t n, double* partition_ms, double* split_ms) {
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+    Singly_List list;
+    singly_list_from_array(&list, &pool, vals, n);
+
+    uint64_t start = bench_now_ns();
+    size_t even = singly_list_partition(&list, is_even, NULL);
+    *partition_ms = elapsed_ms(start);
+
+    size_t count = singly_values(&list, scratch);
+    check_stable("singly", vals, n, scratch, even, is_even, true);
+    check_stable("singly", vals, n, scratch + even, count - even, is_even, false);
+    singly_list_free(&list);
+
+    singly_list_from_array(&list, &pool, vals, n);
+    Singly_List upper;
+    start = bench_now_ns();
+    singly_list_split(&list, 0, &upper);
+    *split_ms = elapsed_ms(start);
+
+    check_stable("singly", vals, n, scratch, singly_values(&list, scratch), is_below_zero, true);
+    check_stable("singly", vals, n, scratch, singly_values(&upper, scratch), is_below_zero, false);
+    singly_list_free(&list);
+    singly_list_free(&upper);
+    node_pool_destroy(&pool);
+}
+
+static void partition_doubly(const int* vals, int* scratch, size_t n, double* partition_ms, double* split_ms) {
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Doubly_Linked_List_Node), 0);
+    Doubly_List list;
+    doubly_list_from_array(&list, &pool, vals, n);
+
+    uint64_t start = bench_now_ns();
+    size_t even = doubly_list_partition(&list, is_even, NULL);
+    *partition_ms = elapsed_ms(start);
+
+    size_t count = doubly_values(&list, scratch);
+    check_stable("doubly", vals, n, scratch, even, is_even, true);
+    check_stable("doubly", vals, n, scratch + even, count - even, is_even, false);
+    doubly_list_free(&list);
+
+    doubly_list_from_array(&list, &pool, vals, n);
+    Doubly_List upper;
+    start = bench_now_ns();
+    doubly_list_split(&list, 0, &upper);
+    *split_ms = elapsed_ms(start);
+
+    check_stable("doubly", vals, n, scratch, doubly_values(&list, scratch), is_below_zero, true);
+    check_stable("doubly", vals, n, scratch, doubly_values(&upper, scratch), is_below_zero, false);
+    doubly_list_free(&list);
+    doubly_list_free(&upper);
+    node_pool_destroy(&pool);
+}
+
+int main(int argc, char** argv) {
+    size_t max_n = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    int* vals    = (int*) malloc(max_n * sizeof(int));
+    int* scratch = (int*) malloc(max_n * sizeof(int));
+    if (vals == NULL || scratch == NULL) {
+        printf("Unable to allocate more memory.\n");
+        return 1;
+    }
+
+    printf("times in ms\n");
+    printf("%-8s %-13s %-10s %12s %12s\n", "list", "pattern", "n", "merge_sort", "radix_sort");
+    for (size_t n = 100000; n <= max_n; n *= 10) {
+        for (Pattern pattern = RANDOM; pattern <= FEW_DISTINCT; pattern += 1) {
+            fill(vals, n, pattern);
+            printf("%-8s %-13s %-10zu %12.1f %12.1f\n", "singly", pattern_names[pattern], n,
+                   sort_singly(vals, scratch, n, false), sort_singly(vals, scratch, n, true));
+            printf("%-8s %-13s %-10zu %12.1f %12.1f\n", "doubly", pattern_names[pattern], n,
+                   sort_doubly(vals, scratch, n, false), sort_doubly(vals, scratch, n, true));
+        }
+    }
+
+    printf("\n%-8s %-10s %12s %12s\n", "list", "n", "partition", "split");
+    for (size_t n = 100000; n <= max_n; n *= 10) {
+        fill(vals, n, RANDOM);
+        double partition_ms, split_ms;
+        partition_singly(vals, scratch, n, &partition_ms, &split_ms);
+        printf("%-8s %-10zu %12.1f %12.1f\n", "singly", n, partition_ms, split_ms);
+        partition_doubly(vals, scratch, n, &partition_ms, &split_ms);
+        printf("%-8s %-10zu %12.1f %12.1f\n", "doubly", n, partition_ms, split_ms);
+    }
+
+    free(vals);
+    free(scratch);
+    return 0;
+}
@@ -0,0 +1,166 @@
+// In-place list merge sort against copying out, `qsort` and rebuilding the list.
+//
+// For 10^5 to `max_n` elements (default 10^7), sorts a singly and a doubly list of
+// random, presorted and few distinct values three ways: copying the values to an
+// array, `qsort` and rebuilding the list from the array in a single pooled block; the
+// sequential merge sort; and the parallel merge sort on `threads` threads (default:
+// the online processors). Every result is checked to be sorted.
+//
+// Usage: list_sort [max_n] [threads]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "sort/list_sort.h"
+
+typedef enum Pattern {
+    RANDOM,
+    SORTED,
+    FEW_DISTINCT,
+} Pattern;
+
+static const char* pattern_names[] = {
+    [RANDOM]       = "random",
+    [SORTED]       = "sorted",
+    [FEW_DISTINCT] = "few_distinct",
+};
+
+typedef enum Method {
+    QSORT_REBUILD,
+    MERGE_SORT,
+    PARALLEL_MERGE_SORT,
+} Method;
+
+static int compare_ints(const void* a, const void* b) {
+    int lhs = *(const int*) a;
+    int rhs = *(const int*) b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static void fill(int* vals, size_t n, Pattern pattern) {
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < n; i += 1) {
+        switch (pattern) {
+            case RANDOM:       vals[i] = (int) bench_xorshift32(&seed); break;
+            case SORTED:       vals[i] = (int) i; break;
+            case FEW_DISTINCT: vals[i] = (int) (bench_xorshift32(&seed) % 16); break;
+        }
+    }
+}
+
+static double sort_singly(const int* vals, int* scratch, size_t n, Method method, size_t threads) {
+    // A fresh pool per run lays the nodes out in list order whatever the heap did before.
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+    Singly_List list;
+    singly_list_from_array(&list, &pool, vals, n);
+
+    uint64_t start = bench_now_ns();
+    switch (method) {
+        case QSORT_REBUILD: {
+            size_t i = 0;
+            for (Singly_Linked_List_Node* node = list.head; node != NULL; node = node->next) {
+                scratch[i++] = node->val;
+            }
+            qsort(scratch, n, sizeof(int), compare_ints);
+            singly_list_free(&list);
+            singly_list_from_array(&list, &pool, scratch, n);
+            break;
+        }
+        case MERGE_SORT:          singly_list_sort(&list); break;
+        case PARALLEL_MERGE_SORT: singly_list_sort_parallel(&list, threads); break;
+    }
+    double ms = (double) (bench_now_ns() - start) / 1e6;
+
+    size_t count = 0;
+    for (Singly_Linked_List_Node* node = list.head; node != NULL; node = node->next) {
+        if (node->next != NULL && node->next->val < node->val) {
+            printf("singly list not sorted\n");
+            exit(1);
+        }
+        count += 1;
+    }
+    if (count != n) {
+        printf("singly list lost nodes\n");
+        exit(1);
+    }
+    singly_list_free(&list);
+    node_pool_destroy(&pool);
+    return ms;
+}
+
+static double sort_doubly(const int* vals, int* scratch, size_t n, Method method, size_t threads) {
+    // A fresh pool per run lays the nodes out in list order whatever the heap did before.
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Doubly_Linked_List_Node), 0);
+    Doubly_List list;
+    doubly_list_from_array(&list, &pool, vals, n);
+
+    uint64_t start = bench_now_ns();
+    switch (method) {
+        case QSORT_REBUILD: {
+            size_t i = 0;
+            for (Doubly_Linked_List_Node* node = list.head; node != NULL; node = node->next) {
+                scratch[i++] = node->val;
+            }
+            qsort(scratch, n, sizeof(int), compare_ints);
+            doubly_list_free(&list);
+            doubly_list_from_array(&list, &pool, scratch, n);
+            break;
+        }
+        case MERGE_SORT:          doubly_list_sort(&list); break;
+        case PARALLEL_MERGE_SORT: doubly_list_sort_parallel(&list, threads); break;
+    }
+    double ms = (double) (bench_now_ns() - start) / 1e6;
+
+    size_t count = 0;
+    for (Doubly_Linked_List_Node* node = list.head; node != NULL; node = node->next) {
+        if (node->next != NULL && (node->next->val < node->val || node->next->prev != node)) {
+            printf("doubly list not sorted\n");
+            exit(1);
+        }
+        count += 1;
+    }
+    if (count != n) {
+        printf("doubly list lost nodes\n");
+        exit(1);
+    }
+    doubly_list_free(&list);
+    node_pool_destroy(&pool);
+    return ms;
+}
+
+int main(int argc, char** argv) {
+    size_t max_n   = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+    long online    = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads = argc > 2 ? (size_t) strtoull(argv[2], NULL, 10) : (size_t) (online > 0 ? online : 1);
+
+    int* vals    = (int*) malloc(max_n * sizeof(int));
+    int* scratch = (int*) malloc(max_n * sizeof(int));
+    if (vals == NULL || scratch == NULL) {
+        printf("Unable to allocate more memory.\n");
+        return 1;
+    }
+
+    printf("times in ms, parallel on %zu threads\n", threads);
+    printf("%-8s %-13s %-10s %14s %12s %12s\n", "list", "pattern", "n", "qsort_rebuild", "merge_sort", "parallel");
+    for (size_t n = 100000; n <= max_n; n *= 10) {
+        for (Pattern pattern = RANDOM; pattern <= FEW_DISTINCT; pattern += 1) {
+            fill(vals, n, pattern);
+            printf("%-8s %-13s %-10zu %14.1f %12.1f %12.1f\n", "singly", pattern_names[pattern], n,
+                   sort_singly(vals, scratch, n, QSORT_REBUILD, threads),
+                   sort_singly(vals, scratch, n, MERGE_SORT, threads),
+                   sort_singly(vals, scratch, n, PARALLEL_MERGE_SORT, threads));
+            printf("%-8s %-13s %-10zu %14.1f %12.1f %12.1f\n", "doubly", pattern_names[pattern], n,
+                   sort_doubly(vals, scratch, n, QSORT_REBUILD, threads),
+                   sort_doubly(vals, scratch, n, MERGE_SORT, threads),
+                   sort_doubly(vals, scratch, n, PARALLEL_MERGE_SORT, threads));
+        }
+    }
+
+    free(vals);
+    free(scratch);
+    return 0;
+}
@@ -0,0 +1,268 @@
+// Lock-free Treiber stack and Michael-Scott queue.
+//
+// First runs a stress check: producer threads push distinct values while consumer
+// threads pop them concurrently, every value must come out exactly once and, for
+// the queue, the values of a given producer must come out in the order they were
+// pushed. Then measures the throughput of push/pop pairs from 1 thread up to the
+// number of online cores (or the thread count given as first argument) against a
+// `Singly_List` wrapped in a global mutex, the setup the lock-free structures replace.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "concurrent/hazard_pointer.h"
+#include "concurrent/lock_free_list.h"
+#include "linkedlist.h"
+
+#define CHECK_THREADS            4
+#define CHECK_VALUES_PER_THREAD  200000
+#define DEFAULT_OPS_PER_THREAD   1000000
+
+typedef enum Structure {
+    LOCK_FREE_STACK,
+    LOCK_FREE_QUEUE,
+    MUTEX_STACK,
+    MUTEX_QUEUE,
+} Structure;
+
+static const char* structure_names[] = {
+    [LOCK_FREE_STACK] = "lock_free_stack",
+    [LOCK_FREE_QUEUE] = "lock_free_queue",
+    [MUTEX_STACK]     = "mutex_singly_list_stack",
+    [MUTEX_QUEUE]     = "mutex_singly_list_queue",
+};
+
+typedef struct Shared {
+    Structure       structure;
+    Lock_Free_Stack stack;
+    Lock_Free_Queue queue;
+    pthread_mutex_t mutex;
+    Singly_List     list;
+} Shared;
+
+static void shared_push(Shared* shared, int val) {
+    switch (shared->structure) {
+    case LOCK_FREE_STACK:
+        lock_free_stack_push(&shared->stack, val);
+        break;
+    case LOCK_FREE_QUEUE:
+        lock_free_queue_enqueue(&shared->queue, val);
+        break;
+    case MUTEX_STACK:
+        pthread_mutex_lock(&shared->mutex);
+        singly_list_push_front(&shared->list, val);
+        pthread_mutex_unlock(&shared->mutex);
+        break;
+    case MUTEX_QUEUE:
+        pthread_mutex_lock(&shared->mutex);
+        singly_list_append(&shared->list, val);
+        pthread_mutex_unlock(&shared->mutex);
+        break;
+    }
+}
+
+static bool shared_pop(Shared* shared, int* val) {
+    bool popped = false;
+    switch (shared->structure) {
+    case LOCK_FREE_STACK:
+        popped = lock_free_stack_pop(&shared->stack, val);
+        break;
+    case LOCK_FREE_QUEUE:
+        popped = lock_free_queue_dequeue(&shared->queue, val);
+        break;
+    case MUTEX_STACK:
+    case MUTEX_QUEUE:
+        pthread_mutex_lock(&shared->mutex);
+        popped = singly_list_remove(&shared->list, 0, val);
+        pthread_mutex_unlock(&shared->mutex);
+        break;
+    }
+    return popped;
+}
+
+static void shared_init(Shared* shared, Structure structure) {
+    shared->structure = structure;
+    lock_free_stack_init(&shared->stack);
+    lock_free_queue_init(&shared->queue);
+    pthread_mutex_init(&shared->mutex, NULL);
+    singly_list_init(&shared->list);
+}
+
+static void shared_free(Shared* shared) {
+    lock_free_stack_free(&shared->stack);
+    lock_free_queue_free(&shared->queue);
+    pthread_mutex_destroy(&shared->mutex);
+    singly_list_free(&shared->list);
+}
+
+// ========= stress check =========
+
+typedef struct Check_Thread {
+    Shared*      shared;
+    size_t       id;
+    atomic_int*  seen;
+    atomic_long* remaining;
+    bool         ordered;
+} Check_Thread;
+
+static void* check_producer(void* arg) {
+    Check_Thread* thread = (Check_Thread*) arg;
+    for (size_t i = 0; i < CHECK_VALUES_PER_THREAD; i += 1) {
+        shared_push(thread->shared, (int) (thread->id * CHECK_VALUES_PER_THREAD + i));
+    }
+    hazard_pointer_thread_exit();
+    return NULL;
+}
+
+static void* check_consumer(void* arg) {
+    Check_Thread* thread = (Check_Thread*) arg;
+    int last_seen[CHECK_THREADS];
+    for (size_t i = 0; i < CHECK_THREADS; i += 1) {
+        last_seen[i] = -1;
+    }
+
+    while (atomic_load(thread->remaining) > 0) {
+        int val;
+        if (!shared_pop(thread->shared, &val)) {
+            continue;
+        }
+        atomic_fetch_sub(thread->remaining, 1);
+        atomic_fetch_add(&thread->seen[val], 1);
+
+        size_t producer = (size_t) val / CHECK_VALUES_PER_THREAD;
+        if (val <= last_seen[producer]) {
+            thread->ordered = false;
+        }
+        last_seen[producer] = val;
+    }
+    hazard_pointer_thread_exit();
+    return NULL;
+}
+
+static bool stress_check(Structure structure) {
+    size_t total = CHECK_THREADS * CHECK_VALUES_PER_THREAD;
+    atomic_int* seen = (atomic_int*) calloc(total, sizeof(atomic_int));
+    atomic_long remaining = (long) total;
+
+    Shared shared;
+    shared_init(&shared, structure);
+
+    pthread_t producers[CHECK_THREADS];
+    pthread_t consumers[CHECK_THREADS];
+    Check_Thread threads[2 * CHECK_THREADS];
+    for (size_t i = 0; i < 2 * CHECK_THREADS; i += 1) {
+        threads[i] = (Check_Thread) { &shared, i % CHECK_THREADS, seen, &remaining, true };
+    }
+    for (size_t i = 0; i < CHECK_THREADS; i += 1) {
+        pthread_create(&producers[i], NULL, check_producer, &threads[i]);
+        pthread_create(&consumers[i], NULL, check_consumer, &threads[CHECK_THREADS + i]);
+    }
+    for (size_t i = 0; i < CHECK_THREADS; i += 1) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < total; i += 1) {
+        if (atomic_load(&seen[i]) != 1) {
+            printf("check: %s popped %zu %d times\n", structure_names[structure], i, atomic_load(&seen[i]));
+            ok = false;
+            break;
+        }
+    }
+    if (structure == LOCK_FREE_QUEUE) {
+        for (size_t i = CHECK_THREADS; i < 2 * CHECK_THREADS; i += 1) {
+            if (!threads[i].ordered) {
+                printf("check: %s reordered the values of a producer\n", structure_names[structure]);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    shared_free(&shared);
+    free(seen);
+    return ok;
+}
+
+// ========= throughput =========
+
+typedef struct Bench_Thread {
+    Shared* shared;
+    size_t  ops;
+    size_t  id;
+} Bench_Thread;
+
+static atomic_bool start_flag;
+
+static void* bench_thread(void* arg) {
+    Bench_Thread* thread = (Bench_Thread*) arg;
+    while (!atomic_load_explicit(&start_flag, memory_order_acquire)) {
+    }
+
+    for (size_t i = 0; i < thread->ops; i += 1) {
+        int val;
+        shared_push(thread->shared, (int) (thread->id + i));
+        shared_pop(thread->shared, &val);
+    }
+    hazard_pointer_thread_exit();
+    return NULL;
+}
+
+static void bench_structure(Structure structure, size_t threads, size_t ops_per_thread) {
+    Shared shared;
+    shared_init(&shared, structure);
+
+    pthread_t*    handles = (pthread_t*) malloc(threads * sizeof(pthread_t));
+    Bench_Thread* args    = (Bench_Thread*) malloc(threads * sizeof(Bench_Thread));
+    atomic_store(&start_flag, false);
+    for (size_t i = 0; i < threads; i += 1) {
+        args[i] = (Bench_Thread) { &shared, ops_per_thread, i };
+        pthread_create(&handles[i], NULL, bench_thread, &args[i]);
+    }
+
+    uint64_t start = bench_now_ns();
+    atomic_store_explicit(&start_flag, true, memory_order_release);
+    for (size_t i = 0; i < threads; i += 1) {
+        pthread_join(handles[i], NULL);
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    // `n` is the number of threads, every op is a push followed by a pop.
+    bench_csv_row(stdout, structure_names[structure], "push_pop", "contended",
+                  threads, threads * ops_per_thread, elapsed, bench_peak_rss_kb());
+
+    shared_free(&shared);
+    free(handles);
+    free(args);
+}
+
+int main(int argc, char** argv) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads    = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : (size_t) (cores > 0 ? cores : 1);
+    size_t ops_per_thread = argc > 2 ? (size_t) strtoull(argv[2], NULL, 10) : DEFAULT_OPS_PER_THREAD;
+
+    bool check_ok = true;
+    for (Structure structure = LOCK_FREE_STACK; structure <= LOCK_FREE_QUEUE; structure += 1) {
+        uint64_t start = bench_now_ns();
+        bool ok = stress_check(structure);
+        printf("stress check %s: %s (%d producers, %d consumers, %.1f s)\n", structure_names[structure],
+               ok ? "ok" : "FAILED", CHECK_THREADS, CHECK_THREADS, (double) (bench_now_ns() - start) / 1e9);
+        check_ok = check_ok && ok;
+    }
+    printf("\n");
+
+    bench_csv_header(stdout);
+    for (size_t threads = 1; threads <= max_threads; threads = threads < max_threads && threads * 2 > max_threads ? max_threads : threads * 2) {
+        for (Structure structure = LOCK_FREE_STACK; structure <= MUTEX_QUEUE; structure += 1) {
+            bench_structure(structure, threads, ops_per_thread);
+        }
+    }
+
+    hazard_pointer_drain();
+    return check_ok ? 0 : 1;
+}
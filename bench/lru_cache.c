@@ -0,0 +1,144 @@
+// LRU and segmented LRU caches on Zipf distributed key traces.
+//
+// For capacities of 10^4 to `max_capacity` entries (default 10^7), replays a trace of
+// max(10^6, 4 * capacity) keys drawn with a Zipf exponent of 0.99 from a universe of
+// 10 times the capacity: every key is looked up, and put on a miss. Reports the hit
+// ratio and the time per access of the plain LRU and of the segmented LRU (80% of the
+// entries protected), and checks that `lru_cache_evict` drains the cache. At 10^4
+// entries the trace is also replayed on a `Doubly_List` searched linearly and moved
+// to front on a hit, the LRU built without an index, over its first
+// `LINEAR_TRACE_LEN` keys.
+//
+// Usage: lru_cache [max_capacity]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "cache/lru_cache.h"
+
+#define ZIPF_EXPONENT    0.99
+#define LINEAR_TRACE_LEN 100000
+
+typedef struct Result {
+    double   ns_per_access;
+    double   hit_ratio;
+    uint64_t evictions;
+} Result;
+
+static void count_eviction(int key, void* value, void* ctx) {
+    (void) key;
+    (void) value;
+    *(uint64_t*) ctx += 1;
+}
+
+static Result replay(const int* trace, size_t len, size_t capacity, size_t protected_capacity) {
+    uint64_t evicted = 0;
+    Lru_Cache cache;
+    lru_cache_init(&cache, capacity, protected_capacity, count_eviction, &evicted);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < len; i += 1) {
+        if (!lru_cache_get(&cache, trace[i], NULL)) {
+            lru_cache_put(&cache, trace[i], NULL);
+        }
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    if (cache.hits + cache.misses != len || evicted != cache.evictions
+        || lru_cache_count(&cache) + cache.evictions != cache.misses) {
+        printf("inconsistent cache counters\n");
+        exit(1);
+    }
+    Result result = { (double) elapsed / (double) len, (double) cache.hits / (double) len, cache.evictions };
+
+    // Draining the cache evicts every entry once, each key no longer cached after.
+    size_t cached = lru_cache_count(&cache);
+    int key;
+    while (lru_cache_evict(&cache, &key, NULL)) {
+        if (lru_cache_peek(&cache, key, NULL)) {
+            printf("evicted key still cached\n");
+            exit(1);
+        }
+    }
+    if (lru_cache_count(&cache) != 0 || evicted != result.evictions + cached) {
+        printf("inconsistent cache drain\n");
+        exit(1);
+    }
+    lru_cache_free(&cache);
+    return result;
+}
+
+static Result replay_linear(const int* trace, size_t len, size_t capacity) {
+    Doubly_List list;
+    doubly_list_init(&list);
+    size_t hits = 0;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < len; i += 1) {
+        Doubly_Linked_List_Node* node = list.head;
+        while (node != NULL && node->val != trace[i]) {
+            node = node->next;
+        }
+
+        if (node != NULL) {
+            hits += 1;
+            if (node != list.head) {
+                node->prev->next = node->next;
+                if (node->next != NULL) {
+                    node->next->prev = node->prev;
+                } else {
+                    list.tail = node->prev;
+                }
+                node->prev      = NULL;
+                node->next      = list.head;
+                list.head->prev = node;
+                list.head       = node;
+            }
+            continue;
+        }
+
+        if (list.count == capacity) {
+            doubly_list_remove_tail(&list, NULL);
+        }
+        doubly_list_insert_head(&list, trace[i]);
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    doubly_list_free(&list);
+    return (Result) { (double) elapsed / (double) len, (double) hits / (double) len, 0 };
+}
+
+static void print_row(const char* cache, size_t capacity, size_t len, Result result) {
+    printf("%-13s %-10zu %-10zu %10.4f %12.1f %12llu\n", cache, capacity, len, result.hit_ratio,
+           result.ns_per_access, (unsigned long long) result.evictions);
+}
+
+int main(int argc, char** argv) {
+    size_t max_capacity = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    printf("Zipf exponent %.2f over 10 * capacity keys, times in ns per access\n", ZIPF_EXPONENT);
+    printf("%-13s %-10s %-10s %10s %12s %12s\n", "cache", "capacity", "accesses", "hit_ratio", "ns/access",
+           "evictions");
+    for (size_t capacity = 10000; capacity <= max_capacity; capacity *= 10) {
+        size_t len = 4 * capacity > 1000000 ? 4 * capacity : 1000000;
+        int* trace = (int*) malloc(len * sizeof(int));
+        if (trace == NULL) {
+            printf("Unable to allocate more memory.\n");
+            return 1;
+        }
+        Bench_Zipf zipf;
+        bench_zipf_init(&zipf, 10 * capacity, ZIPF_EXPONENT, 2463534242u);
+        for (size_t i = 0; i < len; i += 1) {
+            trace[i] = (int) bench_zipf_next(&zipf);
+        }
+
+        print_row("lru", capacity, len, replay(trace, len, capacity, 0));
+        print_row("segmented_lru", capacity, len, replay(trace, len, capacity, capacity * 4 / 5));
+        if (capacity == 10000) {
+            print_row("linear_lru", capacity, LINEAR_TRACE_LEN, replay_linear(trace, LINEAR_TRACE_LEN, capacity));
+        }
+        free(trace);
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Node allocation cost: the same list workloads run once with `malloc`/`free`
+// and once with nodes coming from a `Node_Pool`.
+//
+// - build:    n appends (singly) or head insertions (doubly).
+// - churn:    n removals from the front immediately followed by n insertions, so
+//             every node goes back to the allocator and is handed out again.
+// - teardown: freeing the whole list, node by node with `free` or with a single
+//             `node_pool_destroy`.
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "linkedlist.h"
+
+typedef struct Bench_Result {
+    double build_ns;
+    double churn_ns;
+    double teardown_ns;
+} Bench_Result;
+
+static Bench_Result bench_singly(size_t n, bool pooled) {
+    Bench_Result result;
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+
+    Singly_List list;
+    singly_list_init_pooled(&list, pooled ? &pool : NULL);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        singly_list_append(&list, (int) i);
+    }
+    result.build_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        int removed_val;
+        singly_list_remove(&list, 0, &removed_val);
+        singly_list_append(&list, removed_val);
+    }
+    result.churn_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    if (pooled) {
+        node_pool_destroy(&pool);
+    } else {
+        singly_list_free(&list);
+    }
+    result.teardown_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    return result;
+}
+
+static Bench_Result bench_doubly(size_t n, bool pooled) {
+    Bench_Result result;
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Doubly_Linked_List_Node), 0);
+    Node_Pool* node_pool = pooled ? &pool : NULL;
+
+    uint64_t start = bench_now_ns();
+    Doubly_Linked_List_Node* head = doubly_linked_list_new_pooled(node_pool, 0);
+    for (size_t i = 1; i < n; i += 1) {
+        doubly_linked_list_insert_head_pooled(node_pool, head, (int) i);
+    }
+    result.build_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        int removed_val;
+        doubly_linked_list_remove_head_pooled(node_pool, head, &removed_val);
+        doubly_linked_list_insert_head_pooled(node_pool, head, removed_val);
+    }
+    result.churn_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    if (pooled) {
+        node_pool_destroy(&pool);
+    } else {
+        doubly_linked_list_free(head);
+    }
+    result.teardown_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    return result;
+}
+
+static void print_result(const char* name, size_t n, Bench_Result heap, Bench_Result pool) {
+    printf("%-8s %-10zu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+           name, n,
+           heap.build_ns, pool.build_ns,
+           heap.churn_ns, pool.churn_ns,
+           heap.teardown_ns, pool.teardown_ns);
+}
+
+int main(void) {
+    printf("%-8s %-10s %10s %10s %10s %10s %10s %10s\n", "list", "n",
+           "build", "build/pool", "churn", "churn/pool", "free", "free/pool");
+    for (size_t n = 1000; n <= 10000000; n *= 10) {
+        print_result("singly", n, bench_singly(n, false), bench_singly(n, true));
+        print_result("doubly", n, bench_doubly(n, false), bench_doubly(n, true));
+    }
+
+    return 0;
+}
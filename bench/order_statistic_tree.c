@@ -0,0 +1,164 @@
+// Order statistic tree queries against sorting plus scanning.
+//
+// For n random keys (10^5 to 10^7), compares the O(log n) rank, select,
+// count_in_range and sum_in_range of `Os_Rb_Node` with what answering them takes
+// without augmentation: sorting the keys (needed again after every update, its cost
+// is reported once per n) and then scanning the sorted keys for each query. Also
+// reports the insertion cost of the augmented tree against `Rb_Node`, which is the
+// price of maintaining the aggregates.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "tree/order_statistic_tree.h"
+#include "tree/red_black_tree.h"
+
+#define QUERIES      1000000
+#define SCAN_BUDGET  200000000
+#define RANGE_WIDTH  (1u << 24)
+
+typedef struct Entry {
+    uint32_t key;
+    int32_t  value;
+} Entry;
+
+static int compare_entries(const void* a, const void* b) {
+    uint32_t lhs = ((const Entry*) a)->key;
+    uint32_t rhs = ((const Entry*) b)->key;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static size_t scan_rank(const Entry* sorted, size_t n, uint32_t key) {
+    size_t rank = 0;
+    while (rank < n && sorted[rank].key < key) {
+        rank += 1;
+    }
+    return rank;
+}
+
+static Os_Rb_Stats scan_range(const Entry* sorted, size_t n, uint32_t lo, uint32_t hi) {
+    Os_Rb_Stats stats = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < n && sorted[i].key <= hi; i += 1) {
+        if (sorted[i].key >= lo) {
+            stats.count += 1;
+            stats.sum   += sorted[i].value;
+        }
+    }
+    return stats;
+}
+
+static void bench_n(size_t n) {
+    Entry* entries = (Entry*) malloc(n * sizeof(Entry));
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < n; i += 1) {
+        entries[i].key   = bench_xorshift32(&seed);
+        entries[i].value = (int32_t) (bench_xorshift32(&seed) % 2001) - 1000;
+    }
+
+    Rb_Node* plain_root = NULL;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&plain_root, entries[i].key, NULL);
+    }
+    double plain_insert_ns = (double) (bench_now_ns() - start) / (double) n;
+    rb_node_free(plain_root);
+
+    Os_Rb_Node* root = NULL;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        os_rb_node_insert(&root, entries[i].key, entries[i].value);
+    }
+    double insert_ns = (double) (bench_now_ns() - start) / (double) n;
+    size_t size = os_rb_node_size(root);
+
+    start = bench_now_ns();
+    qsort(entries, n, sizeof(Entry), compare_entries);
+    double sort_ms = (double) (bench_now_ns() - start) / 1e6;
+    // Duplicate random keys were merged by the tree, keep the last value like it did.
+    size_t unique = 0;
+    for (size_t i = 0; i < n; i += 1) {
+        if (unique > 0 && entries[unique - 1].key == entries[i].key) {
+            entries[unique - 1].value = os_rb_node_find(root, entries[i].key)->value;
+        } else {
+            entries[unique] = entries[i];
+            entries[unique].value = os_rb_node_find(root, entries[i].key)->value;
+            unique += 1;
+        }
+    }
+
+    size_t scan_queries = SCAN_BUDGET / unique;
+    if (scan_queries < 10) {
+        scan_queries = 10;
+    }
+
+    uint64_t checksum = 0;
+    uint64_t scan_checksum = 0;
+    bool     agree = true;
+
+    // rank
+    start = bench_now_ns();
+    for (size_t i = 0; i < QUERIES; i += 1) {
+        checksum += os_rb_node_rank(root, bench_xorshift32(&seed));
+    }
+    double rank_ns = (double) (bench_now_ns() - start) / QUERIES;
+    start = bench_now_ns();
+    for (size_t i = 0; i < scan_queries; i += 1) {
+        uint32_t key = bench_xorshift32(&seed);
+        size_t rank = scan_rank(entries, unique, key);
+        scan_checksum += rank;
+        agree = agree && rank == os_rb_node_rank(root, key);
+    }
+    double scan_rank_ns = (double) (bench_now_ns() - start) / (double) scan_queries;
+
+    // select, the sorted array answers it by indexing once sorted.
+    start = bench_now_ns();
+    for (size_t i = 0; i < QUERIES; i += 1) {
+        checksum += os_rb_node_select(root, bench_xorshift32(&seed) % size)->key;
+    }
+    double select_ns = (double) (bench_now_ns() - start) / QUERIES;
+
+    // count_in_range and sum_in_range
+    start = bench_now_ns();
+    for (size_t i = 0; i < QUERIES; i += 1) {
+        uint32_t lo = bench_xorshift32(&seed);
+        uint32_t hi = lo + RANGE_WIDTH < lo ? UINT32_MAX : lo + RANGE_WIDTH;
+        checksum += os_rb_node_count_in_range(root, lo, hi);
+    }
+    double count_ns = (double) (bench_now_ns() - start) / QUERIES;
+    start = bench_now_ns();
+    for (size_t i = 0; i < QUERIES; i += 1) {
+        uint32_t lo = bench_xorshift32(&seed);
+        uint32_t hi = lo + RANGE_WIDTH < lo ? UINT32_MAX : lo + RANGE_WIDTH;
+        checksum += (uint64_t) os_rb_node_sum_in_range(root, lo, hi);
+    }
+    double sum_ns = (double) (bench_now_ns() - start) / QUERIES;
+    start = bench_now_ns();
+    for (size_t i = 0; i < scan_queries; i += 1) {
+        uint32_t lo = bench_xorshift32(&seed);
+        uint32_t hi = lo + RANGE_WIDTH < lo ? UINT32_MAX : lo + RANGE_WIDTH;
+        Os_Rb_Stats stats = scan_range(entries, unique, lo, hi);
+        scan_checksum += stats.count;
+        Os_Rb_Stats tree_stats = os_rb_node_range_stats(root, lo, hi);
+        agree = agree && stats.count == tree_stats.count && stats.sum == tree_stats.sum;
+    }
+    double scan_range_ns = (double) (bench_now_ns() - start) / (double) scan_queries;
+
+    printf("%-10zu %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f %10.1f %12.1f %12.1f %s\n",
+           n, plain_insert_ns, insert_ns, rank_ns, select_ns, count_ns, sum_ns,
+           sort_ms, scan_rank_ns, scan_range_ns,
+           agree && checksum != 0 && scan_checksum != 0 ? "" : "(MISMATCH)");
+
+    os_rb_node_free(root);
+    free(entries);
+}
+
+int main(void) {
+    printf("times in ns per call, sort in ms per refresh\n");
+    printf("%-10s %8s %8s %8s %8s %8s %8s %10s %12s %12s\n", "n", "rb_ins", "os_ins",
+           "rank", "select", "count", "sum", "sort_ms", "scan_rank", "scan_range");
+    for (size_t n = 100000; n <= 10000000; n *= 10) {
+        bench_n(n);
+    }
+    return 0;
+}
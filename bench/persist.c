@@ -0,0 +1,294 @@
+// Cold start: rebuilding a structure against mapping its saved file.
+//
+// For 10^5 to `max_n` elements (default 10^7), the time to rebuild each structure
+// with one `malloc` per node, to save it, to map the saved file and run a first
+// query, and the lookup time in place against the heap structure. A multiset tree is
+// also saved, and the count of every key compared. The file is in the page cache, so
+// mapping measures the format, not the disk. Files are written to `dir` (default
+// /tmp) and removed afterwards.
+//
+// Usage: persist [max_n] [dir]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "persist/persist.h"
+
+#define LOOKUPS 1000000
+
+static double elapsed_ms(uint64_t start) {
+    return (double) (bench_now_ns() - start) / 1e6;
+}
+
+static void print_row(const char* structure, size_t n, double rebuild_ms, double save_ms, double map_ms,
+                      double verify_ms, double heap_ns, double mapped_ns) {
+    printf("%-12s %-10zu %10.1f %10.1f %10.3f %10.1f %10.1f %10.1f\n", structure, n, rebuild_ms, save_ms,
+           map_ms, verify_ms, heap_ns, mapped_ns);
+}
+
+static void bench_singly(size_t n, const char* path) {
+    uint64_t start = bench_now_ns();
+    Singly_List list;
+    singly_list_init(&list);
+    for (size_t i = 0; i < n; i += 1) {
+        singly_list_append(&list, (int) (3 * i));
+    }
+    double rebuild_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    if (persist_save_singly_list(path, &list) != PERSIST_OK) {
+        printf("unable to save %s\n", path);
+        exit(1);
+    }
+    double save_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Image image;
+    int first = -1;
+    if (persist_map(&image, path, PERSIST_SINGLY_LIST, false) != PERSIST_OK
+        || !persist_singly_get(&image, n / 2, &first)) {
+        printf("unable to map %s\n", path);
+        exit(1);
+    }
+    double map_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Result verified = persist_verify(&image);
+    double verify_ms = elapsed_ms(start);
+
+    // The saved links follow the list, value for value.
+    size_t mismatches = 0;
+    const Persist_Singly_Node* saved = persist_singly_head(&image);
+    for (Singly_Linked_List_Node* node = list.head; node != NULL; node = node->next) {
+        mismatches += saved == NULL || saved->val != node->val;
+        saved = saved != NULL ? persist_singly_next(&image, saved) : NULL;
+    }
+    mismatches += saved != NULL;
+
+    // Positional reads, walking from the finger on the heap, O(1) in the file.
+    size_t ops = n < 100000 ? 1000 : 100;
+    uint32_t seed = 2463534242u;
+    long sum = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < ops; i += 1) {
+        int val;
+        singly_list_get(&list, bench_xorshift32(&seed) % n, &val);
+        sum += val;
+    }
+    double heap_ns = (double) (bench_now_ns() - start) / (double) ops;
+    seed = 2463534242u;
+    start = bench_now_ns();
+    for (size_t i = 0; i < ops; i += 1) {
+        int val;
+        persist_singly_get(&image, bench_xorshift32(&seed) % n, &val);
+        sum -= val;
+    }
+    double mapped_ns = (double) (bench_now_ns() - start) / (double) ops;
+
+    // Lookups by value find the same index in the file and on the heap.
+    for (size_t i = 0; i < 10; i += 1) {
+        int needle = (int) (3 * (bench_xorshift32(&seed) % n)) + (i % 2 == 0 ? 0 : 1);
+        size_t heap_idx = 0, mapped_idx = 0;
+        bool heap_found   = singly_list_lookup(&list, needle, &heap_idx);
+        bool mapped_found = persist_singly_lookup(&image, needle, &mapped_idx);
+        mismatches += heap_found != mapped_found || heap_idx != mapped_idx || heap_found != (i % 2 == 0);
+    }
+
+    print_row("singly_list", n, rebuild_ms, save_ms, map_ms, verify_ms, heap_ns, mapped_ns);
+    if (verified != PERSIST_OK || sum != 0 || first != (int) (3 * (n / 2)) || mismatches != 0) {
+        printf("mismatch: %s, %zu values differ\n", persist_result_name(verified), mismatches);
+    }
+    persist_unmap(&image);
+    singly_list_free(&list);
+}
+
+static void bench_lists(size_t n, const char* path) {
+    uint64_t start = bench_now_ns();
+    Doubly_List list;
+    doubly_list_init(&list);
+    for (size_t i = 0; i < n; i += 1) {
+        doubly_list_insert_tail(&list, (int) i);
+    }
+    double rebuild_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    if (persist_save_doubly_list(path, &list) != PERSIST_OK) {
+        printf("unable to save %s\n", path);
+        exit(1);
+    }
+    double save_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Image image;
+    int first = -1;
+    if (persist_map(&image, path, PERSIST_DOUBLY_LIST, false) != PERSIST_OK
+        || !persist_doubly_get(&image, n / 2, &first)) {
+        printf("unable to map %s\n", path);
+        exit(1);
+    }
+    double map_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Result verified = persist_verify(&image);
+    double verify_ms = elapsed_ms(start);
+
+    // Positional reads, walking from the nearer end on the heap, O(1) in the file.
+    size_t ops = n < 100000 ? 1000 : 100;
+    uint32_t seed = 2463534242u;
+    long sum = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < ops; i += 1) {
+        int val;
+        doubly_list_get(&list, bench_xorshift32(&seed) % n, &val);
+        sum += val;
+    }
+    double heap_ns = (double) (bench_now_ns() - start) / (double) ops;
+    seed = 2463534242u;
+    start = bench_now_ns();
+    for (size_t i = 0; i < ops; i += 1) {
+        int val;
+        persist_doubly_get(&image, bench_xorshift32(&seed) % n, &val);
+        sum -= val;
+    }
+    double mapped_ns = (double) (bench_now_ns() - start) / (double) ops;
+
+    print_row("doubly_list", n, rebuild_ms, save_ms, map_ms, verify_ms, heap_ns, mapped_ns);
+    if (verified != PERSIST_OK || sum != 0 || first != (int) (n / 2)) {
+        printf("mismatch: %s\n", persist_result_name(verified));
+    }
+    persist_unmap(&image);
+    doubly_list_free(&list);
+}
+
+static void bench_tree(size_t n, const char* path) {
+    uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+    uint32_t seed = 88675123u;
+    for (size_t i = 0; i < n; i += 1) {
+        keys[i] = bench_xorshift32(&seed);
+    }
+
+    uint64_t start = bench_now_ns();
+    Rb_Node* root = NULL;
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&root, keys[i], (void*) (uintptr_t) i);
+    }
+    double rebuild_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    if (persist_save_rb_tree(path, root) != PERSIST_OK) {
+        printf("unable to save %s\n", path);
+        exit(1);
+    }
+    double save_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Image image;
+    if (persist_map(&image, path, PERSIST_RB_TREE, false) != PERSIST_OK
+        || !persist_rb_find(&image, keys[n / 2], NULL)) {
+        printf("unable to map %s\n", path);
+        exit(1);
+    }
+    double map_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Result verified = persist_verify(&image);
+    double verify_ms = elapsed_ms(start);
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += rb_node_find(root, keys[bench_xorshift32(&seed) % n]) != NULL;
+    }
+    double heap_ns = (double) (bench_now_ns() - start) / LOOKUPS;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += persist_rb_find(&image, keys[bench_xorshift32(&seed) % n], NULL);
+    }
+    double mapped_ns = (double) (bench_now_ns() - start) / LOOKUPS;
+
+    print_row("rb_node", n, rebuild_ms, save_ms, map_ms, verify_ms, heap_ns, mapped_ns);
+    if (verified != PERSIST_OK || found != 2 * LOOKUPS) {
+        printf("mismatch: %s, %zu found\n", persist_result_name(verified), found);
+    }
+    persist_unmap(&image);
+    rb_node_free(root);
+    free(keys);
+}
+
+// A multiset of keys drawn from a tenth as many, every count compared after the round trip.
+static void bench_multiset(size_t n, const char* path) {
+    size_t universe = n / 10;
+    uint32_t seed = 362436069u;
+    uint64_t start = bench_now_ns();
+    Rb_Node* root = NULL;
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert_multi(&root, bench_xorshift32(&seed) % universe, 1);
+    }
+    double rebuild_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    if (persist_save_rb_tree(path, root) != PERSIST_OK) {
+        printf("unable to save %s\n", path);
+        exit(1);
+    }
+    double save_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Image image;
+    if (persist_map(&image, path, PERSIST_RB_TREE, false) != PERSIST_OK) {
+        printf("unable to map %s\n", path);
+        exit(1);
+    }
+    uint32_t first = persist_rb_count(&image, 0);
+    double map_ms = elapsed_ms(start);
+
+    start = bench_now_ns();
+    Persist_Result verified = persist_verify(&image);
+    double verify_ms = elapsed_ms(start);
+
+    uint64_t total = 0;
+    start = bench_now_ns();
+    for (size_t key = 0; key < universe; key += 1) {
+        total += rb_node_count(root, (uint32_t) key);
+    }
+    double heap_ns = (double) (bench_now_ns() - start) / (double) universe;
+    start = bench_now_ns();
+    for (size_t key = 0; key < universe; key += 1) {
+        total -= persist_rb_count(&image, (uint32_t) key);
+    }
+    double mapped_ns = (double) (bench_now_ns() - start) / (double) universe;
+
+    size_t mismatches = first != rb_node_count(root, 0);
+    for (size_t key = 0; key < universe; key += 1) {
+        mismatches += persist_rb_count(&image, (uint32_t) key) != rb_node_count(root, (uint32_t) key);
+    }
+
+    print_row("rb_multiset", n, rebuild_ms, save_ms, map_ms, verify_ms, heap_ns, mapped_ns);
+    if (verified != PERSIST_OK || total != 0 || mismatches != 0) {
+        printf("mismatch: %s, %zu counts differ\n", persist_result_name(verified), mismatches);
+    }
+    persist_unmap(&image);
+    rb_node_free(root);
+}
+
+int main(int argc, char** argv) {
+    size_t max_n    = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+    const char* dir = argc > 2 ? argv[2] : "/tmp";
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/persist_bench_%d.bin", dir, (int) getpid());
+
+    printf("times in ms, except lookups in ns (positional get for lists, find for trees, count for "
+           "multisets)\n");
+    printf("%-12s %-10s %10s %10s %10s %10s %10s %10s\n", "structure", "n", "rebuild", "save", "map+query",
+           "verify", "heap_op", "mapped_op");
+    for (size_t n = 100000; n <= max_n; n *= 10) {
+        bench_singly(n, path);
+        bench_lists(n, path);
+        bench_tree(n, path);
+        bench_multiset(n, path);
+    }
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Array-backed red-black tree against the pointer based `Rb_Node`: insertion,
+// search and deletion of n random keys, at 10^5 to 10^7 keys, with the memory
+// taken per key (the node array for the former, the nodes for the latter).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "tree/array_red_black_tree.h"
+#include "tree/red_black_tree.h"
+
+static void bench_node_tree(const uint32_t* keys, size_t n) {
+    Rb_Node* root = NULL;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&root, keys[i], NULL);
+    }
+    double insert_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        found += rb_node_find(root, keys[(i * 7919) % n]) != NULL;
+    }
+    double search_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_delete(&root, keys[i], NULL);
+    }
+    double delete_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&root, keys[i], NULL);
+    }
+    double reinsert_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    printf("%-8s %-10zu %10.1f %10.1f %10.1f %10.1f %12.1f %s\n",
+           "Rb_Node", n, insert_ns, search_ns, delete_ns, reinsert_ns, (double) sizeof(Rb_Node),
+           found == n ? "" : "(missing keys)");
+
+    rb_node_free(root);
+}
+
+static void bench_array_tree(const uint32_t* keys, size_t n) {
+    Rb_Array_Tree tree;
+    rb_array_tree_init(&tree, 0);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_array_tree_insert(&tree, keys[i]);
+    }
+    double insert_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        found += rb_array_tree_search(&tree, keys[(i * 7919) % n]);
+    }
+    double search_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    // Deleting then inserting again reuses the released slots, without allocating.
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_array_tree_delete(&tree, keys[i]);
+    }
+    double delete_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_array_tree_insert(&tree, keys[i]);
+    }
+    double reinsert_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    double bytes_per_key = (double) tree.capacity * sizeof(Rb_Array_Node) / (double) n;
+    printf("%-8s %-10zu %10.1f %10.1f %10.1f %10.1f %12.1f %s\n",
+           "array", n, insert_ns, search_ns, delete_ns, reinsert_ns, bytes_per_key,
+           found == n ? "" : "(missing keys)");
+
+    rb_array_tree_free(&tree);
+}
+
+int main(void) {
+    printf("%-8s %-10s %10s %10s %10s %10s %12s\n", "tree", "n", "insert", "search", "delete", "reinsert", "bytes/key");
+    for (size_t n = 100000; n <= 10000000; n *= 10) {
+        // Distinct keys, the map semantic of `rb_node_insert` would drop duplicates.
+        uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+        for (size_t i = 0; i < n; i += 1) {
+            keys[i] = (uint32_t) i * 2654435761u;
+        }
+
+        bench_node_tree(keys, n);
+        bench_array_tree(keys, n);
+        free(keys);
+    }
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Batch insertion of unsorted keys against one `rb_node_insert` per key.
+//
+// For batches of 64 to `max_batch` random keys (default 2^20), inserted into an empty
+// tree and into a tree already holding `tree_n` random keys (default 10^6): the time
+// per key of looping `rb_node_insert`, of `rb_node_insert_batch` and of
+// `rb_node_insert_batch_pooled`. Every resulting tree is validated and checked to hold
+// as many keys as the looped one.
+//
+// Usage: rb_batch [max_batch] [tree_n]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "tree/red_black_tree.h"
+
+typedef enum Method {
+    LOOP,
+    BATCH,
+    BATCH_POOLED,
+} Method;
+
+static size_t tree_count(Rb_Node* root) {
+    return root == NULL ? 0 : 1 + tree_count(root->left) + tree_count(root->right);
+}
+
+// Inserts the `n` keys of `base` (NULL for an empty tree) then the batch, timing the batch only.
+static double insert_ns(const uint32_t* base, size_t base_n, const uint32_t* batch, size_t n, Method method,
+                        size_t* count) {
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Rb_Node), 0);
+    Node_Pool* tree_pool = method == BATCH_POOLED ? &pool : NULL;
+
+    Rb_Node* root = NULL;
+    for (size_t i = 0; i < base_n; i += 1) {
+        rb_node_insert_pooled(tree_pool, &root, base[i], NULL);
+    }
+
+    uint64_t start = bench_now_ns();
+    switch (method) {
+        case LOOP:
+            for (size_t i = 0; i < n; i += 1) {
+                rb_node_insert(&root, batch[i], NULL);
+            }
+            break;
+        case BATCH:        rb_node_insert_batch(&root, batch, NULL, n); break;
+        case BATCH_POOLED: rb_node_insert_batch_pooled(&pool, &root, batch, NULL, n); break;
+    }
+    double elapsed = (double) (bench_now_ns() - start) / (double) n;
+
+    if (!rb_node_validate(root)) {
+        printf("invalid tree\n");
+        exit(1);
+    }
+    *count = tree_count(root);
+    if (tree_pool == NULL) {
+        rb_node_free(root);
+    }
+    node_pool_destroy(&pool);
+    return elapsed;
+}
+
+static void bench_batch(const char* tree, const uint32_t* base, size_t base_n, const uint32_t* batch, size_t n) {
+    size_t loop_count, batch_count, pooled_count;
+    double loop_ns   = insert_ns(base, base_n, batch, n, LOOP, &loop_count);
+    double batch_ns  = insert_ns(base, base_n, batch, n, BATCH, &batch_count);
+    double pooled_ns = insert_ns(base, base_n, batch, n, BATCH_POOLED, &pooled_count);
+    printf("%-8s %-10zu %10.1f %10.1f %12.1f %8.2f%s\n", tree, n, loop_ns, batch_ns, pooled_ns,
+           loop_ns / pooled_ns, batch_count == loop_count && pooled_count == loop_count ? "" : " (MISMATCH)");
+}
+
+int main(int argc, char** argv) {
+    size_t max_batch = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : (size_t) 1 << 20;
+    size_t tree_n    = argc > 2 ? (size_t) strtoull(argv[2], NULL, 10) : 1000000;
+
+    uint32_t* base  = (uint32_t*) malloc(tree_n * sizeof(uint32_t));
+    uint32_t* batch = (uint32_t*) malloc(max_batch * sizeof(uint32_t));
+    if (base == NULL || batch == NULL) {
+        printf("Unable to allocate more memory.\n");
+        return 1;
+    }
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < tree_n; i += 1) {
+        base[i] = bench_xorshift32(&seed);
+    }
+
+    printf("times in ns per batch key\n");
+    printf("%-8s %-10s %10s %10s %12s %8s\n", "tree", "batch", "loop", "batch", "batch_pooled", "speedup");
+    for (size_t n = 64; n <= max_batch; n *= 4) {
+        for (size_t i = 0; i < n; i += 1) {
+            batch[i] = bench_xorshift32(&seed);
+        }
+        bench_batch("empty", NULL, 0, batch, n);
+        bench_batch("filled", base, tree_n, batch, n);
+    }
+
+    free(base);
+    free(batch);
+    return 0;
+}
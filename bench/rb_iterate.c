@@ -0,0 +1,136 @@
+// Full and range scans of a red-black tree through its iterator.
+//
+// For 10^5 to `max_n` random keys (default 10^7), in a tree grown by `rb_node_insert`,
+// whose nodes are scattered over the heap, and in a pooled bulk-loaded tree, whose
+// nodes are laid out in key order: the time per node of a recursive in-order walk, of
+// a successor walk without prefetching (the walk `rb_node_next` did before it
+// prefetched), of `rb_node_first` and `rb_node_next`, and of `rb_iterator_range` over
+// `RANGE_KEYS` consecutive keys from random starting keys. The node bytes scanned per
+// second are given for the full scan with `rb_node_next`.
+//
+// Usage: rb_iterate [max_n]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "tree/red_black_tree.h"
+
+#define RANGES     1000
+#define RANGE_KEYS 1000
+
+static void walk(Rb_Node* node, uint64_t* sum) {
+    if (node == NULL) {
+        return;
+    }
+    walk(node->left, sum);
+    *sum += node->key;
+    walk(node->right, sum);
+}
+
+static Rb_Node* plain_next(Rb_Node* node) {
+    if (node->right != NULL) {
+        node = node->right;
+        while (node->left != NULL) {
+            node = node->left;
+        }
+        return node;
+    }
+
+    while (node->parent != NULL && node->parent->right == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+static int compare_keys(const void* a, const void* b) {
+    uint32_t lhs = *(const uint32_t*) a;
+    uint32_t rhs = *(const uint32_t*) b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static void bench_scans(const char* layout, Rb_Node* root, size_t n) {
+    uint64_t expected = 0;
+    uint64_t start = bench_now_ns();
+    walk(root, &expected);
+    double walk_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    uint64_t plain_sum = 0;
+    start = bench_now_ns();
+    Rb_Node* first = root;
+    while (first->left != NULL) {
+        first = first->left;
+    }
+    for (Rb_Node* node = first; node != NULL; node = plain_next(node)) {
+        plain_sum += node->key;
+    }
+    double plain_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    uint64_t next_sum = 0;
+    start = bench_now_ns();
+    for (Rb_Node* node = rb_node_first(root); node != NULL; node = rb_node_next(node)) {
+        next_sum += node->key;
+    }
+    uint64_t next_elapsed = bench_now_ns() - start;
+    double next_ns = (double) next_elapsed / (double) n;
+    double next_mb_s = (double) (n * sizeof(Rb_Node)) / ((double) next_elapsed / 1e9) / 1e6;
+
+    // Ranges from random keys, each holding up to RANGE_KEYS nodes.
+    uint32_t seed = 88172645u;
+    size_t visited = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < RANGES; i += 1) {
+        uint32_t lo = bench_xorshift32(&seed);
+        uint32_t hi = lo + (uint32_t) ((UINT32_MAX / n) * RANGE_KEYS);
+        Rb_Iterator iterator = rb_iterator_range(root, lo, hi < lo ? UINT32_MAX : hi);
+        for (Rb_Node* node; (node = rb_iterator_next(&iterator)) != NULL;) {
+            if (node->key < lo) {
+                printf("range out of order\n");
+                exit(1);
+            }
+            visited += 1;
+        }
+    }
+    double range_ns = visited > 0 ? (double) (bench_now_ns() - start) / (double) visited : 0.0;
+
+    printf("%-10s %-10zu %10.1f %10.1f %10.1f %10.1f %10.0f%s\n", layout, n, walk_ns, plain_ns, next_ns, range_ns,
+           next_mb_s, plain_sum == expected && next_sum == expected ? "" : " (MISMATCH)");
+}
+
+int main(int argc, char** argv) {
+    size_t max_n = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    uint32_t* keys = (uint32_t*) malloc(max_n * sizeof(uint32_t));
+    if (keys == NULL) {
+        printf("Unable to allocate more memory.\n");
+        return 1;
+    }
+
+    printf("times in ns per node, scan in MB/s of nodes\n");
+    printf("%-10s %-10s %10s %10s %10s %10s %10s\n", "layout", "n", "recursive", "plain", "next", "range", "scan");
+    for (size_t n = 100000; n <= max_n; n *= 10) {
+        uint32_t seed = 2463534242u;
+        for (size_t i = 0; i < n; i += 1) {
+            keys[i] = bench_xorshift32(&seed);
+        }
+
+        Rb_Node* root = NULL;
+        size_t unique = 0;
+        for (size_t i = 0; i < n; i += 1) {
+            unique += rb_node_insert(&root, keys[i], NULL);
+        }
+        bench_scans("scattered", root, unique);
+        rb_node_free(root);
+
+        // Duplicate keys are merged by the bulk load, as they were by the insertions.
+        qsort(keys, n, sizeof(uint32_t), compare_keys);
+        Node_Pool pool;
+        node_pool_init(&pool, sizeof(Rb_Node), 0);
+        root = rb_node_bulk_load_pooled(&pool, keys, NULL, n);
+        bench_scans("sequential", root, unique);
+        node_pool_destroy(&pool);
+    }
+
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Multiset mode of `Rb_Node` against one node per occurrence, on Zipf distributed keys.
+//
+// For 10^5 to `max_n` insertions (default 10^7), draws keys with a Zipf exponent of
+// `exponent` (default 0.99) from a universe of a tenth as many keys, and inserts them
+// into a `Rb_Node` multiset with `rb_node_insert_multi`, and into a tree holding one
+// node per occurrence, keyed by the key and the insertion index. Reports the nodes and
+// the height of both trees, the time per insertion, the time to count the occurrences
+// of every key of the universe (a lower bound and a walk over the occurrences for the
+// node per occurrence tree) and the time per removal of every occurrence. Both trees
+// are validated and their counts compared.
+//
+// Usage: rb_multiset [max_n] [exponent]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "tree/red_black_tree.h"
+
+// One node per occurrence: the key in the upper 32 bits, the insertion index in the lower.
+RB_TREE_DECLARE(U64, u64, uint64_t, void*)
+RB_TREE_DEFINE(U64, u64, uint64_t, void*, RB_TREE_DEFAULT_LESS)
+
+typedef struct Result {
+    size_t nodes;
+    size_t height;
+    double insert_ns;
+    double count_ns;
+    double delete_ns;
+} Result;
+
+static size_t multiset_nodes(Rb_Node* node, size_t depth, size_t* height) {
+    if (node == NULL) {
+        *height = depth > *height ? depth : *height;
+        return 0;
+    }
+    return 1 + multiset_nodes(node->left, depth + 1, height) + multiset_nodes(node->right, depth + 1, height);
+}
+
+static size_t occurrence_nodes(U64_Rb_Node* node, size_t depth, size_t* height) {
+    if (node == NULL) {
+        *height = depth > *height ? depth : *height;
+        return 0;
+    }
+    return 1 + occurrence_nodes(node->left, depth + 1, height) + occurrence_nodes(node->right, depth + 1, height);
+}
+
+static double ns_per_op(uint64_t start, size_t n) {
+    return (double) (bench_now_ns() - start) / (double) n;
+}
+
+static void fail(const char* message) {
+    printf("%s\n", message);
+    exit(1);
+}
+
+static Result bench_multiset(const uint32_t* trace, size_t n, size_t universe, uint32_t* counts) {
+    Result result = { 0 };
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(Rb_Node), 0);
+    Rb_Node* root = NULL;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert_multi_pooled(&pool, &root, trace[i], 1);
+    }
+    result.insert_ns = ns_per_op(start, n);
+
+    if (!rb_node_validate(root)) {
+        fail("multiset tree is invalid");
+    }
+    result.nodes = multiset_nodes(root, 0, &result.height);
+
+    start = bench_now_ns();
+    for (size_t key = 1; key <= universe; key += 1) {
+        counts[key] = rb_node_count(root, (uint32_t) key);
+    }
+    result.count_ns = ns_per_op(start, universe);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_delete_multi_pooled(&pool, &root, trace[i], 1);
+    }
+    result.delete_ns = ns_per_op(start, n);
+
+    if (root != NULL) {
+        fail("multiset tree is not empty after removing every occurrence");
+    }
+    node_pool_destroy(&pool);
+    return result;
+}
+
+static Result bench_occurrences(const uint32_t* trace, size_t n, size_t universe, const uint32_t* counts) {
+    Result result = { 0 };
+    Node_Pool pool;
+    node_pool_init(&pool, sizeof(U64_Rb_Node), 0);
+    U64_Rb_Node* root = NULL;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        u64_rb_node_insert_pooled(&pool, &root, (uint64_t) trace[i] << 32 | i, NULL);
+    }
+    result.insert_ns = ns_per_op(start, n);
+
+    if (!u64_rb_node_validate(root)) {
+        fail("node per occurrence tree is invalid");
+    }
+    result.nodes = occurrence_nodes(root, 0, &result.height);
+
+    start = bench_now_ns();
+    size_t mismatches = 0;
+    for (size_t key = 1; key <= universe; key += 1) {
+        uint32_t count = 0;
+        for (U64_Rb_Node* node = u64_rb_node_lower_bound(root, (uint64_t) key << 32);
+             node != NULL && node->key >> 32 == key; node = u64_rb_node_next(node)) {
+            count += 1;
+        }
+        mismatches += count != counts[key];
+    }
+    result.count_ns = ns_per_op(start, universe);
+    if (mismatches > 0) {
+        fail("multiset counts differ from the occurrences");
+    }
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        u64_rb_node_delete_pooled(&pool, &root, (uint64_t) trace[i] << 32 | i, NULL);
+    }
+    result.delete_ns = ns_per_op(start, n);
+
+    node_pool_destroy(&pool);
+    return result;
+}
+
+static void print_row(const char* structure, size_t n, Result result) {
+    printf("%-16s %-10zu %10zu %8zu %10.1f %10.1f %10.1f\n", structure, n, result.nodes, result.height,
+           result.insert_ns, result.count_ns, result.delete_ns);
+}
+
+int main(int argc, char** argv) {
+    size_t max_n    = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+    double exponent = argc > 2 ? strtod(argv[2], NULL) : 0.99;
+
+    uint32_t* trace  = (uint32_t*) malloc(max_n * sizeof(uint32_t));
+    uint32_t* counts = (uint32_t*) malloc((max_n / 10 + 1) * sizeof(uint32_t));
+    if (trace == NULL || counts == NULL) {
+        printf("Unable to allocate more memory.\n");
+        return 1;
+    }
+
+    printf("zipf exponent %.2f, times in ns per operation (count: per key of the universe)\n", exponent);
+    printf("%-16s %-10s %10s %8s %10s %10s %10s\n", "structure", "n", "nodes", "height", "insert", "count",
+           "delete");
+    for (size_t n = 100000; n <= max_n; n *= 10) {
+        size_t universe = n / 10;
+        Bench_Zipf zipf;
+        bench_zipf_init(&zipf, universe, exponent, 2463534242u);
+        for (size_t i = 0; i < n; i += 1) {
+            trace[i] = (uint32_t) bench_zipf_next(&zipf);
+        }
+
+        print_row("multiset", n, bench_multiset(trace, n, universe, counts));
+        print_row("node_per_occur", n, bench_occurrences(trace, n, universe, counts));
+    }
+
+    free(trace);
+    free(counts);
+    return 0;
+}
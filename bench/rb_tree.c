@@ -0,0 +1,163 @@
+// Red-black tree ordered map.
+//
+// First runs a randomized check: a long sequence of random insertions and
+// deletions on a small key range, mirrored in a presence table, validating the
+// tree invariants periodically and the ordered traversal against the table.
+// Then measures insert/find/lower_bound/delete throughput on random and sorted
+// keys at 10^5 to 10^7 keys, together with the tree height against the 2*log2(n+1)
+// bound.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "tree/red_black_tree.h"
+
+#define CHECK_KEY_RANGE  4096
+#define CHECK_OPERATIONS 2000000
+#define CHECK_INTERVAL   1000
+
+static size_t tree_height(Rb_Node* node) {
+    // Follows the longest path with a bounded explicit stack instead of recursing.
+    typedef struct { Rb_Node* node; size_t depth; } Frame;
+    Frame stack[128];
+    size_t top = 0;
+    size_t height = 0;
+    if (node != NULL) {
+        stack[top++] = (Frame) { node, 1 };
+    }
+    while (top > 0) {
+        Frame frame = stack[--top];
+        if (frame.depth > height) {
+            height = frame.depth;
+        }
+        if (frame.node->left != NULL) {
+            stack[top++] = (Frame) { frame.node->left, frame.depth + 1 };
+        }
+        if (frame.node->right != NULL) {
+            stack[top++] = (Frame) { frame.node->right, frame.depth + 1 };
+        }
+    }
+    return height;
+}
+
+static bool randomized_check(void) {
+    static bool present[CHECK_KEY_RANGE];
+    Rb_Node* root = NULL;
+    uint32_t seed = 1;
+
+    for (size_t op = 0; op < CHECK_OPERATIONS; op += 1) {
+        uint32_t key = bench_xorshift32(&seed) % CHECK_KEY_RANGE;
+        if (bench_xorshift32(&seed) % 2 == 0) {
+            if (rb_node_insert(&root, key, (void*) (uintptr_t) (key + 1)) == present[key]) {
+                printf("check: insert of %u disagrees with the reference\n", key);
+                return false;
+            }
+            present[key] = true;
+        } else {
+            void* value = NULL;
+            if (rb_node_delete(&root, key, &value) != present[key]
+                || (present[key] && value != (void*) (uintptr_t) (key + 1))) {
+                printf("check: delete of %u disagrees with the reference\n", key);
+                return false;
+            }
+            present[key] = false;
+        }
+
+        if (op % CHECK_INTERVAL != 0) {
+            continue;
+        }
+
+        if (!rb_node_validate(root)) {
+            return false;
+        }
+
+        uint32_t expected = 0;
+        for (Rb_Node* node = rb_node_lower_bound(root, 0); node != NULL; node = rb_node_next(node)) {
+            while (expected < CHECK_KEY_RANGE && !present[expected]) {
+                expected += 1;
+            }
+            if (node->key != expected) {
+                printf("check: traversal yields %u instead of %u\n", node->key, expected);
+                return false;
+            }
+            expected += 1;
+        }
+    }
+
+    rb_node_free(root);
+    return true;
+}
+
+static void bench_keys(const char* pattern, const uint32_t* keys, size_t n) {
+    Rb_Node* root = NULL;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&root, keys[i], NULL);
+    }
+    double insert_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        found += rb_node_find(root, keys[(i * 7919) % n]) != NULL;
+    }
+    double find_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        found += rb_node_lower_bound(root, keys[i] + 1) != NULL;
+    }
+    double lower_bound_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    size_t height = tree_height(root);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_delete(&root, keys[i], NULL);
+    }
+    double delete_ns = (double) (bench_now_ns() - start) / (double) n;
+
+    printf("%-8s %-10zu %10.1f %10.1f %12.1f %10.1f %8zu %8.1f%s\n",
+           pattern, n, insert_ns, find_ns, lower_bound_ns, delete_ns,
+           height, 2.0 * log2((double) n + 1.0), found >= n ? "" : " (missing keys)");
+
+    rb_node_free(root);
+}
+
+int main(void) {
+    uint64_t start = bench_now_ns();
+    bool check_ok = randomized_check();
+    printf("randomized check: %s (%d operations, %.1f s)\n\n", check_ok ? "ok" : "FAILED",
+           CHECK_OPERATIONS, (double) (bench_now_ns() - start) / 1e9);
+
+    printf("%-8s %-10s %10s %10s %12s %10s %8s %8s\n",
+           "pattern", "n", "insert", "find", "lower_bound", "delete", "height", "bound");
+    for (size_t n = 100000; n <= 10000000; n *= 10) {
+        uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+
+        // Distinct random keys: a random permutation of a spread out sequence.
+        for (size_t i = 0; i < n; i += 1) {
+            keys[i] = (uint32_t) (i * 3);
+        }
+        uint32_t seed = 2463534242u;
+        for (size_t i = n - 1; i > 0; i -= 1) {
+            size_t j = bench_xorshift32(&seed) % (i + 1);
+            uint32_t tmp = keys[i];
+            keys[i] = keys[j];
+            keys[j] = tmp;
+        }
+        bench_keys("random", keys, n);
+
+        for (size_t i = 0; i < n; i += 1) {
+            keys[i] = (uint32_t) (i * 3);
+        }
+        bench_keys("sorted", keys, n);
+
+        free(keys);
+    }
+
+    return check_ok ? 0 : 1;
+}
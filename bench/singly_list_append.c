@@ -0,0 +1,66 @@
+// Append-heavy workload: builds a list of `n` elements one append at a time.
+//
+// `singly_linked_list_append` walks the whole chain to find the last node, so
+// building the list is O(n^2). `singly_list_append` links after the cached tail,
+// building the list is O(n). The node based variant is skipped past
+// `NODE_APPEND_MAX_LEN` elements, it would take minutes.
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "linkedlist.h"
+
+#define NODE_APPEND_MAX_LEN 100000
+
+static double bench_node_append(size_t n) {
+    uint64_t start = bench_now_ns();
+
+    Singly_Linked_List_Node* head = singly_linked_list_new(0);
+    for (size_t i = 1; i < n; i += 1) {
+        singly_linked_list_append(head, (int) i);
+    }
+
+    uint64_t elapsed = bench_now_ns() - start;
+    if (singly_linked_list_len(head) != n) {
+        fprintf(stderr, "node append: unexpected length\n");
+    }
+
+    Singly_List list;
+    singly_list_wrap(&list, head);
+    singly_list_free(&list);
+
+    return (double) elapsed / (double) n;
+}
+
+static double bench_handle_append(size_t n) {
+    uint64_t start = bench_now_ns();
+
+    Singly_List list;
+    singly_list_init(&list);
+    for (size_t i = 0; i < n; i += 1) {
+        singly_list_append(&list, (int) i);
+    }
+
+    uint64_t elapsed = bench_now_ns() - start;
+    if (singly_list_len(&list) != n) {
+        fprintf(stderr, "handle append: unexpected length\n");
+    }
+
+    singly_list_free(&list);
+    return (double) elapsed / (double) n;
+}
+
+int main(void) {
+    printf("%-10s %18s %18s\n", "n", "node ns/append", "handle ns/append");
+    for (size_t n = 1000; n <= 1000000; n *= 10) {
+        double handle_ns = bench_handle_append(n);
+        if (n <= NODE_APPEND_MAX_LEN) {
+            double node_ns = bench_node_append(n);
+            printf("%-10zu %18.1f %18.1f\n", n, node_ns, handle_ns);
+        } else {
+            printf("%-10zu %18s %18.1f\n", n, "skipped", handle_ns);
+        }
+    }
+
+    return 0;
+}
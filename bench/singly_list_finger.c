@@ -0,0 +1,131 @@
+// Positional workloads on `Singly_List`, with and without its finger.
+//
+// For lists of 10^3 to 10^6 elements: a `singly_list_get` and a `singly_list_set`
+// loop over increasing indices, a near-sequential `singly_list_get` loop whose index
+// advances by 0 to 3, an insertion after every element by index and a removal of
+// every other element by index. Without the finger, which is cleared before every
+// call, each access walks from the head and the workloads are O(n^2). They are
+// skipped past `NO_FINGER_MAX_LEN` elements, they would take minutes.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "linkedlist.h"
+
+#define NO_FINGER_MAX_LEN 10000
+
+typedef enum Workload {
+    GET,
+    SET,
+    NEAR_GET,
+    INSERT,
+    REMOVE,
+    WORKLOAD_COUNT,
+} Workload;
+
+static const char* workload_names[] = {
+    [GET]      = "get",
+    [SET]      = "set",
+    [NEAR_GET] = "near_get",
+    [INSERT]   = "insert",
+    [REMOVE]   = "remove",
+};
+
+static double bench_workload(const int* vals, size_t n, Workload workload, bool finger) {
+    Singly_List list;
+    singly_list_from_array(&list, NULL, vals, n);
+
+    uint32_t seed = 2463534242u;
+    long sum = 0;
+    int val = 0;
+    size_t operations = 0;
+    uint64_t start = bench_now_ns();
+    switch (workload) {
+        case GET:
+            for (size_t i = 0; i < n; i += 1) {
+                list.finger = finger ? list.finger : NULL;
+                singly_list_get(&list, i, &val);
+                operations += 1;
+                sum += val;
+            }
+            break;
+        case SET:
+            for (size_t i = 0; i < n; i += 1) {
+                list.finger = finger ? list.finger : NULL;
+                singly_list_set(&list, i, (int) i);
+                operations += 1;
+            }
+            break;
+        case NEAR_GET:
+            for (size_t i = 0; i < n; i += bench_xorshift32(&seed) % 4) {
+                list.finger = finger ? list.finger : NULL;
+                singly_list_get(&list, i, &val);
+                operations += 1;
+                sum += val;
+            }
+            break;
+        case INSERT:
+            for (size_t i = 0; i < n; i += 1) {
+                list.finger = finger ? list.finger : NULL;
+                singly_list_insert(&list, 2 * i + 1, -vals[i]);
+                operations += 1;
+            }
+            break;
+        case REMOVE:
+            for (size_t i = 0; i < n / 2; i += 1) {
+                list.finger = finger ? list.finger : NULL;
+                singly_list_remove(&list, i, &val);
+                operations += 1;
+                sum += val;
+            }
+            break;
+        default:
+            break;
+    }
+    double elapsed = (double) (bench_now_ns() - start) / (double) operations;
+
+    // Checks the list against what the workload should have left.
+    size_t i = 0;
+    bool valid = true;
+    for (Singly_Linked_List_Node* node = list.head; node != NULL; node = node->next, i += 1) {
+        switch (workload) {
+            case SET:    valid = valid && node->val == (int) i; break;
+            case INSERT: valid = valid && node->val == (i % 2 == 0 ? vals[i / 2] : -vals[i / 2]); break;
+            case REMOVE: valid = valid && node->val == vals[2 * i + 1]; break;
+            default:     valid = valid && node->val == vals[i]; break;
+        }
+    }
+    (void) sum;
+    singly_list_free(&list);
+    return valid ? elapsed : -1.0;
+}
+
+int main(void) {
+    int* vals = (int*) malloc(1000000 * sizeof(int));
+    if (vals == NULL) {
+        printf("Unable to allocate more memory.\n");
+        return 1;
+    }
+    uint32_t seed = 88172645u;
+    for (size_t i = 0; i < 1000000; i += 1) {
+        vals[i] = (int) (bench_xorshift32(&seed) >> 1);
+    }
+
+    printf("times in ns per operation, negative on a wrong result\n");
+    printf("%-10s %-10s %14s %14s\n", "workload", "n", "no_finger", "finger");
+    for (size_t n = 1000; n <= 1000000; n *= 10) {
+        for (Workload workload = GET; workload < WORKLOAD_COUNT; workload += 1) {
+            double finger_ns = bench_workload(vals, n, workload, true);
+            if (n <= NO_FINGER_MAX_LEN) {
+                printf("%-10s %-10zu %14.1f %14.1f\n", workload_names[workload], n,
+                       bench_workload(vals, n, workload, false), finger_ns);
+            } else {
+                printf("%-10s %-10zu %14s %14.1f\n", workload_names[workload], n, "skipped", finger_ns);
+            }
+        }
+    }
+
+    free(vals);
+    return 0;
+}
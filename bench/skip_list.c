@@ -0,0 +1,271 @@
+// Lock-free skip list against an `Rb_Node` tree behind a global mutex.
+//
+// First runs a stress check: threads insert and delete random keys of a small shared
+// range, so that most operations race on the same keys, counting their successful
+// insertions and deletions per key. Once they are done, a key must be in the set
+// exactly when it was inserted once more than it was deleted, and the structure must
+// validate. Then measures the throughput of a read-heavy and an update-heavy mix of
+// operations at 1, 2, 4, 8 and 16 threads on a half-full key range.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "concurrent/epoch.h"
+#include "concurrent/skip_list.h"
+#include "tree/red_black_tree.h"
+
+#define CHECK_THREADS           8
+#define CHECK_KEY_RANGE         256
+#define CHECK_OPS_PER_THREAD    200000
+#define BENCH_KEY_RANGE         (1u << 20)
+#define DEFAULT_OPS_PER_THREAD  500000
+#define RANGE_SCAN_WIDTH        64
+
+typedef enum Structure {
+    SKIP_LIST,
+    MUTEX_RB_TREE,
+} Structure;
+
+static const char* structure_names[] = {
+    [SKIP_LIST]     = "lock_free_skip_list",
+    [MUTEX_RB_TREE] = "mutex_rb_tree",
+};
+
+// Percentages of insertions and deletions, lookups take the rest, one in a hundred of
+// them being a range scan.
+typedef struct Mix {
+    const char* name;
+    uint32_t    insert_percent;
+    uint32_t    delete_percent;
+} Mix;
+
+static const Mix mixes[] = {
+    { "read_heavy",   5,  5  },
+    { "update_heavy", 25, 25 },
+};
+
+typedef struct Shared {
+    Structure       structure;
+    Skip_List       skip_list;
+    pthread_mutex_t mutex;
+    Rb_Node*        root;
+} Shared;
+
+static bool shared_insert(Shared* shared, uint32_t key) {
+    if (shared->structure == SKIP_LIST) {
+        return skip_list_insert(&shared->skip_list, key);
+    }
+    pthread_mutex_lock(&shared->mutex);
+    bool inserted = rb_node_insert(&shared->root, key, NULL);
+    pthread_mutex_unlock(&shared->mutex);
+    return inserted;
+}
+
+static bool shared_delete(Shared* shared, uint32_t key) {
+    if (shared->structure == SKIP_LIST) {
+        return skip_list_delete(&shared->skip_list, key);
+    }
+    pthread_mutex_lock(&shared->mutex);
+    bool deleted = rb_node_delete(&shared->root, key, NULL);
+    pthread_mutex_unlock(&shared->mutex);
+    return deleted;
+}
+
+static bool shared_contains(Shared* shared, uint32_t key) {
+    if (shared->structure == SKIP_LIST) {
+        return skip_list_contains(&shared->skip_list, key);
+    }
+    pthread_mutex_lock(&shared->mutex);
+    bool found = rb_node_find(shared->root, key) != NULL;
+    pthread_mutex_unlock(&shared->mutex);
+    return found;
+}
+
+static bool count_key(uint32_t key, void* ctx) {
+    (void) key;
+    *(size_t*) ctx += 1;
+    return true;
+}
+
+static size_t shared_range(Shared* shared, uint32_t lo, uint32_t hi) {
+    size_t visited = 0;
+    if (shared->structure == SKIP_LIST) {
+        skip_list_range(&shared->skip_list, lo, hi, count_key, &visited);
+        return visited;
+    }
+    pthread_mutex_lock(&shared->mutex);
+    for (Rb_Node* node = rb_node_lower_bound(shared->root, lo); node != NULL && node->key <= hi; node = rb_node_next(node)) {
+        visited += 1;
+    }
+    pthread_mutex_unlock(&shared->mutex);
+    return visited;
+}
+
+static void shared_init(Shared* shared, Structure structure) {
+    shared->structure = structure;
+    skip_list_init(&shared->skip_list);
+    pthread_mutex_init(&shared->mutex, NULL);
+    shared->root = NULL;
+}
+
+static void shared_free(Shared* shared) {
+    skip_list_free(&shared->skip_list);
+    pthread_mutex_destroy(&shared->mutex);
+    rb_node_free(shared->root);
+}
+
+// ========= stress check =========
+
+typedef struct Check_Thread {
+    Skip_List* list;
+    atomic_int* net_inserts;
+    uint32_t   seed;
+} Check_Thread;
+
+static void* check_thread(void* arg) {
+    Check_Thread* thread = (Check_Thread*) arg;
+    for (size_t i = 0; i < CHECK_OPS_PER_THREAD; i += 1) {
+        uint32_t key = bench_xorshift32(&thread->seed) % CHECK_KEY_RANGE;
+        switch (bench_xorshift32(&thread->seed) % 4) {
+        case 0:
+        case 1:
+            if (skip_list_insert(thread->list, key)) {
+                atomic_fetch_add(&thread->net_inserts[key], 1);
+            }
+            break;
+        case 2:
+            if (skip_list_delete(thread->list, key)) {
+                atomic_fetch_sub(&thread->net_inserts[key], 1);
+            }
+            break;
+        default: {
+            size_t visited = 0;
+            skip_list_range(thread->list, key, key + 16, count_key, &visited);
+            break;
+        }
+        }
+    }
+    epoch_thread_exit();
+    return NULL;
+}
+
+static bool stress_check(void) {
+    static atomic_int net_inserts[CHECK_KEY_RANGE];
+    Skip_List list;
+    skip_list_init(&list);
+
+    pthread_t handles[CHECK_THREADS];
+    Check_Thread threads[CHECK_THREADS];
+    for (size_t i = 0; i < CHECK_THREADS; i += 1) {
+        threads[i] = (Check_Thread) { &list, net_inserts, (uint32_t) (i + 1) * 2654435761u };
+        pthread_create(&handles[i], NULL, check_thread, &threads[i]);
+    }
+    for (size_t i = 0; i < CHECK_THREADS; i += 1) {
+        pthread_join(handles[i], NULL);
+    }
+
+    bool ok = skip_list_validate(&list);
+    for (uint32_t key = 0; ok && key < CHECK_KEY_RANGE; key += 1) {
+        int net = atomic_load(&net_inserts[key]);
+        if (net != (int) skip_list_contains(&list, key)) {
+            printf("check: key %u inserted %d more times than deleted but %s\n",
+                   key, net, skip_list_contains(&list, key) ? "present" : "absent");
+            ok = false;
+        }
+    }
+
+    skip_list_free(&list);
+    epoch_thread_exit();
+    return ok;
+}
+
+// ========= throughput =========
+
+typedef struct Bench_Thread {
+    Shared*    shared;
+    const Mix* mix;
+    size_t     ops;
+    uint32_t   seed;
+    size_t     found;
+} Bench_Thread;
+
+static atomic_bool start_flag;
+
+static void* bench_thread(void* arg) {
+    Bench_Thread* thread = (Bench_Thread*) arg;
+    while (!atomic_load_explicit(&start_flag, memory_order_acquire)) {
+    }
+
+    uint32_t insert_below = thread->mix->insert_percent;
+    uint32_t delete_below = insert_below + thread->mix->delete_percent;
+    for (size_t i = 0; i < thread->ops; i += 1) {
+        uint32_t key  = bench_xorshift32(&thread->seed) % BENCH_KEY_RANGE;
+        uint32_t roll = bench_xorshift32(&thread->seed) % 100;
+        if (roll < insert_below) {
+            shared_insert(thread->shared, key);
+        } else if (roll < delete_below) {
+            shared_delete(thread->shared, key);
+        } else if (i % 100 == 0) {
+            thread->found += shared_range(thread->shared, key, key + RANGE_SCAN_WIDTH);
+        } else {
+            thread->found += shared_contains(thread->shared, key);
+        }
+    }
+    epoch_thread_exit();
+    return NULL;
+}
+
+static void bench_structure(Structure structure, const Mix* mix, size_t threads, size_t ops_per_thread) {
+    Shared shared;
+    shared_init(&shared, structure);
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < BENCH_KEY_RANGE / 2; i += 1) {
+        shared_insert(&shared, bench_xorshift32(&seed) % BENCH_KEY_RANGE);
+    }
+
+    pthread_t*    handles = (pthread_t*) malloc(threads * sizeof(pthread_t));
+    Bench_Thread* args    = (Bench_Thread*) malloc(threads * sizeof(Bench_Thread));
+    atomic_store(&start_flag, false);
+    for (size_t i = 0; i < threads; i += 1) {
+        args[i] = (Bench_Thread) { &shared, mix, ops_per_thread, (uint32_t) (i + 1) * 2654435761u, 0 };
+        pthread_create(&handles[i], NULL, bench_thread, &args[i]);
+    }
+
+    uint64_t start = bench_now_ns();
+    atomic_store_explicit(&start_flag, true, memory_order_release);
+    for (size_t i = 0; i < threads; i += 1) {
+        pthread_join(handles[i], NULL);
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    // `n` is the number of threads.
+    bench_csv_row(stdout, structure_names[structure], "mixed", mix->name,
+                  threads, threads * ops_per_thread, elapsed, bench_peak_rss_kb());
+
+    shared_free(&shared);
+    free(handles);
+    free(args);
+}
+
+int main(int argc, char** argv) {
+    size_t ops_per_thread = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : DEFAULT_OPS_PER_THREAD;
+
+    uint64_t start = bench_now_ns();
+    bool check_ok = stress_check();
+    printf("stress check: %s (%d threads, %d keys, %.1f s)\n\n", check_ok ? "ok" : "FAILED",
+           CHECK_THREADS, CHECK_KEY_RANGE, (double) (bench_now_ns() - start) / 1e9);
+
+    bench_csv_header(stdout);
+    for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); m += 1) {
+        for (size_t threads = 1; threads <= 16; threads *= 2) {
+            bench_structure(SKIP_LIST, &mixes[m], threads, ops_per_thread);
+            bench_structure(MUTEX_RB_TREE, &mixes[m], threads, ops_per_thread);
+        }
+    }
+
+    epoch_drain();
+    return check_ok ? 0 : 1;
+}
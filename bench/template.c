@@ -0,0 +1,166 @@
+// Compile-time specialized containers against the `void*` plus function pointer design.
+//
+// The same red-black tree and doubly list templates are instantiated twice: once for
+// `uint32_t`/`uint64_t` elements compared with an inlined `<`/`==`, once for boxed
+// elements (`const void*` pointing to the value) compared through a function pointer,
+// which is what a generic container storing `void*` pays: an indirect call and a
+// pointer chase per comparison. The hand-written `Rb_Node` is timed as the baseline.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "list_template.h"
+#include "tree/red_black_tree.h"
+
+#define LOOKUPS      1000000
+#define LIST_N       10000
+#define LIST_LOOKUPS 2000
+
+typedef int (*Compare_Fn)(const void* a, const void* b);
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*) a;
+    uint32_t y = *(const uint32_t*) b;
+    return (x > y) - (x < y);
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+// Volatile so that the compiler cannot see through the pointer and inline the call.
+static Compare_Fn volatile boxed_u32_compare = compare_u32;
+static Compare_Fn volatile boxed_u64_compare = compare_u64;
+
+#define BOXED_LESS(a, b) (boxed_u32_compare((a), (b)) < 0)
+#define BOXED_EQ(a, b)   (boxed_u64_compare((a), (b)) == 0)
+
+RB_TREE_DECLARE(U32, u32, uint32_t, void*)
+RB_TREE_DEFINE(U32, u32, uint32_t, void*, RB_TREE_DEFAULT_LESS)
+RB_TREE_DECLARE(Boxed, boxed, const void*, void*)
+RB_TREE_DEFINE(Boxed, boxed, const void*, void*, BOXED_LESS)
+
+DOUBLY_LIST_DECLARE(U64, u64, uint64_t)
+DOUBLY_LIST_DEFINE(U64, u64, uint64_t, LIST_TEMPLATE_DEFAULT_EQ)
+DOUBLY_LIST_DECLARE(Boxed, boxed, const void*)
+DOUBLY_LIST_DEFINE(Boxed, boxed, const void*, BOXED_EQ)
+
+static void print_row(const char* structure, size_t n, uint64_t insert_ns, uint64_t lookup_ns,
+                      size_t lookups, bool valid) {
+    printf("%-12s %-10zu %12.1f %12.1f%s\n", structure, n, (double) insert_ns / (double) n,
+           (double) lookup_ns / (double) lookups, valid ? "" : " (INVALID)");
+}
+
+static void bench_trees(size_t n) {
+    uint32_t* keys = (uint32_t*) malloc(n * sizeof(uint32_t));
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < n; i += 1) {
+        keys[i] = bench_xorshift32(&seed);
+    }
+    uint32_t* probes = (uint32_t*) malloc(LOOKUPS * sizeof(uint32_t));
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        probes[i] = keys[bench_xorshift32(&seed) % n];
+    }
+    size_t found = 0;
+
+    Rb_Node* rb_root = NULL;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        rb_node_insert(&rb_root, keys[i], NULL);
+    }
+    uint64_t insert_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += rb_node_find(rb_root, probes[i]) != NULL;
+    }
+    print_row("rb_node", n, insert_ns, bench_now_ns() - start, LOOKUPS, rb_node_validate(rb_root));
+    rb_node_free(rb_root);
+
+    U32_Rb_Node* u32_root = NULL;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        u32_rb_node_insert(&u32_root, keys[i], NULL);
+    }
+    insert_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += u32_rb_node_find(u32_root, probes[i]) != NULL;
+    }
+    print_row("u32_rb_node", n, insert_ns, bench_now_ns() - start, LOOKUPS, u32_rb_node_validate(u32_root));
+    u32_rb_node_free(u32_root);
+
+    Boxed_Rb_Node* boxed_root = NULL;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i += 1) {
+        boxed_rb_node_insert(&boxed_root, &keys[i], NULL);
+    }
+    insert_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i += 1) {
+        found += boxed_rb_node_find(boxed_root, &probes[i]) != NULL;
+    }
+    print_row("boxed_rb", n, insert_ns, bench_now_ns() - start, LOOKUPS, boxed_rb_node_validate(boxed_root));
+    boxed_rb_node_free(boxed_root);
+
+    if (found != 3 * LOOKUPS) {
+        printf("lookup mismatch: %zu found out of %d\n", found, 3 * LOOKUPS);
+    }
+    free(probes);
+    free(keys);
+}
+
+static void bench_lists(void) {
+    uint64_t* vals = (uint64_t*) malloc(LIST_N * sizeof(uint64_t));
+    for (size_t i = 0; i < LIST_N; i += 1) {
+        vals[i] = (uint64_t) i * 7;
+    }
+    uint32_t seed = 88675123u;
+    size_t found_sum = 0;
+    size_t found_idx = 0;
+
+    U64_Doubly_List u64_list;
+    u64_doubly_list_init(&u64_list);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < LIST_N; i += 1) {
+        u64_doubly_list_insert_tail(&u64_list, vals[i]);
+    }
+    uint64_t insert_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LIST_LOOKUPS; i += 1) {
+        u64_doubly_list_search(&u64_list, vals[bench_xorshift32(&seed) % LIST_N], &found_idx);
+        found_sum += found_idx;
+    }
+    print_row("u64_doubly", LIST_N, insert_ns, bench_now_ns() - start, LIST_LOOKUPS, true);
+    u64_doubly_list_free(&u64_list);
+
+    seed = 88675123u;
+    size_t boxed_found_sum = 0;
+    Boxed_Doubly_List boxed_list;
+    boxed_doubly_list_init(&boxed_list);
+    start = bench_now_ns();
+    for (size_t i = 0; i < LIST_N; i += 1) {
+        boxed_doubly_list_insert_tail(&boxed_list, &vals[i]);
+    }
+    insert_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (size_t i = 0; i < LIST_LOOKUPS; i += 1) {
+        boxed_doubly_list_search(&boxed_list, &vals[bench_xorshift32(&seed) % LIST_N], &found_idx);
+        boxed_found_sum += found_idx;
+    }
+    print_row("boxed_doubly", LIST_N, insert_ns, bench_now_ns() - start, LIST_LOOKUPS,
+              boxed_found_sum == found_sum);
+    boxed_doubly_list_free(&boxed_list);
+    free(vals);
+}
+
+int main(void) {
+    printf("%-12s %-10s %12s %12s\n", "structure", "n", "insert_ns", "lookup_ns");
+    for (size_t n = 1000; n <= 1000000; n *= 10) {
+        bench_trees(n);
+    }
+    bench_lists();
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Full list scans: looking up a value that is not in the list, for a singly list
+// whose nodes were allocated in order, a singly list whose nodes are linked in a
+// shuffled order (the usual state of a long lived list), and an unrolled list.
+// Also measures a random `get` on the unrolled list, which skips whole nodes.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "linkedlist.h"
+#include "unrolled_linkedlist.h"
+
+#define SCAN_ROUNDS 5
+
+// Keeps the values read by the benchmarks alive.
+static volatile long long sink;
+
+static void build_shuffled(Singly_List* list, size_t n) {
+    Singly_Linked_List_Node** nodes = (Singly_Linked_List_Node**) malloc(n * sizeof(Singly_Linked_List_Node*));
+    for (size_t i = 0; i < n; i += 1) {
+        nodes[i] = singly_linked_list_new((int) i);
+    }
+
+    uint32_t seed = 88172645u;
+    for (size_t i = n - 1; i > 0; i -= 1) {
+        size_t j = bench_xorshift32(&seed) % (i + 1);
+        Singly_Linked_List_Node* tmp = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = tmp;
+    }
+
+    for (size_t i = 0; i + 1 < n; i += 1) {
+        nodes[i]->next = nodes[i + 1];
+    }
+    singly_list_wrap(list, nodes[0]);
+    free(nodes);
+}
+
+static double scan_singly(Singly_List* list, size_t n) {
+    size_t found_idx;
+    size_t found = 0;
+    uint64_t start = bench_now_ns();
+    for (int round = 0; round < SCAN_ROUNDS; round += 1) {
+        found += singly_list_lookup(list, -1, &found_idx);
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+    if (found != 0) {
+        fprintf(stderr, "singly lookup: unexpected match\n");
+    }
+    return (double) elapsed / (double) (n * SCAN_ROUNDS);
+}
+
+static double scan_unrolled(Unrolled_List* list, size_t n) {
+    size_t found_idx;
+    size_t found = 0;
+    uint64_t start = bench_now_ns();
+    for (int round = 0; round < SCAN_ROUNDS; round += 1) {
+        found += unrolled_list_lookup(list, -1, &found_idx);
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+    if (found != 0) {
+        fprintf(stderr, "unrolled lookup: unexpected match\n");
+    }
+    return (double) elapsed / (double) (n * SCAN_ROUNDS);
+}
+
+int main(void) {
+    printf("%-10s %16s %16s %16s %16s\n", "n", "singly ns/elem", "shuffled ns/elem", "unrolled ns/elem", "unrolled get ns");
+    for (size_t n = 100000; n <= 10000000; n *= 10) {
+        Singly_List sequential;
+        singly_list_init(&sequential);
+        for (size_t i = 0; i < n; i += 1) {
+            singly_list_append(&sequential, (int) i);
+        }
+        double sequential_ns = scan_singly(&sequential, n);
+        singly_list_free(&sequential);
+
+        Singly_List shuffled;
+        build_shuffled(&shuffled, n);
+        double shuffled_ns = scan_singly(&shuffled, n);
+        singly_list_free(&shuffled);
+
+        Unrolled_List unrolled;
+        unrolled_list_init(&unrolled);
+        for (size_t i = 0; i < n; i += 1) {
+            unrolled_list_append(&unrolled, (int) i);
+        }
+        double unrolled_ns = scan_unrolled(&unrolled, n);
+
+        size_t gets = 1000;
+        long long sum = 0;
+        uint32_t seed = 2463534242u;
+        uint64_t start = bench_now_ns();
+        for (size_t i = 0; i < gets; i += 1) {
+            int val;
+            unrolled_list_get(&unrolled, bench_xorshift32(&seed) % n, &val);
+            sum += val;
+        }
+        double get_ns = (double) (bench_now_ns() - start) / (double) gets;
+        sink = sum;
+        unrolled_list_free(&unrolled);
+
+        printf("%-10zu %16.2f %16.2f %16.2f %16.1f\n", n, sequential_ns, shuffled_ns, unrolled_ns, get_ns);
+    }
+
+    return 0;
+}
@@ -0,0 +1,255 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "lru_cache.h"
+
+static Lru_Cache_Entry* entry_of(Doubly_Linked_List_Node* node) {
+    return (Lru_Cache_Entry*) ((char*) node - offsetof(Lru_Cache_Entry, node));
+}
+
+static size_t home_slot(Lru_Cache* cache, int key) {
+    return (size_t) (((uint64_t) (uint32_t) key * 0x9E3779B97F4A7C15ull) >> 32) & cache->slot_mask;
+}
+
+// Returns the slot holding `key`, or the empty slot ending its probe sequence.
+static size_t find_slot(Lru_Cache* cache, int key) {
+    size_t slot = home_slot(cache, key);
+    while (cache->slots[slot].entry != 0 && cache->slots[slot].key != key) {
+        slot = (slot + 1) & cache->slot_mask;
+    }
+    return slot;
+}
+
+// Empties `slot` and shifts back the following keys of its cluster that probed past
+// it, so that probing never needs tombstones.
+static void clear_slot(Lru_Cache* cache, size_t slot) {
+    Lru_Cache_Slot* slots = cache->slots;
+    size_t hole = slot;
+    for (size_t next_slot = (slot + 1) & cache->slot_mask; slots[next_slot].entry != 0;
+         next_slot = (next_slot + 1) & cache->slot_mask) {
+        size_t home = home_slot(cache, slots[next_slot].key);
+        // The key can fill the hole unless its home lies after the hole, up to `next_slot`.
+        if (((next_slot - home) & cache->slot_mask) >= ((next_slot - hole) & cache->slot_mask)) {
+            slots[hole] = slots[next_slot];
+            hole = next_slot;
+        }
+    }
+    slots[hole].entry = 0;
+}
+
+static void link_front(Doubly_List* list, Doubly_Linked_List_Node* node) {
+    node->prev = NULL;
+    node->next = list->head;
+    if (list->head != NULL) {
+        list->head->prev = node;
+    } else {
+        list->tail = node;
+    }
+    list->head = node;
+    list->count += 1;
+}
+
+static void unlink_node(Doubly_List* list, Doubly_Linked_List_Node* node) {
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+    list->count -= 1;
+}
+
+static Doubly_List* segment_of(Lru_Cache* cache, Lru_Cache_Entry* entry) {
+    return entry->is_protected ? &cache->protected_list : &cache->probation;
+}
+
+// Makes `entry` the most recently used, promoting it to the protected segment in a
+// segmented cache and demoting the least recently used protected entry if needed.
+static void touch(Lru_Cache* cache, Lru_Cache_Entry* entry) {
+    unlink_node(segment_of(cache, entry), &entry->node);
+    if (cache->protected_capacity == 0) {
+        link_front(&cache->probation, &entry->node);
+        return;
+    }
+
+    entry->is_protected = true;
+    link_front(&cache->protected_list, &entry->node);
+    if (cache->protected_list.count > cache->protected_capacity) {
+        Lru_Cache_Entry* demoted = entry_of(cache->protected_list.tail);
+        unlink_node(&cache->protected_list, &demoted->node);
+        demoted->is_protected = false;
+        link_front(&cache->probation, &demoted->node);
+    }
+}
+
+// Unlinks and unindexes the least recently used entry of probation, of the protected
+// segment if probation is empty, and calls the eviction callback. The cache must not
+// be empty. Returns the entry, which the caller reuses or frees.
+static Lru_Cache_Entry* evict_entry(Lru_Cache* cache) {
+    Doubly_List* victim_list = cache->probation.tail != NULL ? &cache->probation : &cache->protected_list;
+    Lru_Cache_Entry* entry = entry_of(victim_list->tail);
+    unlink_node(victim_list, &entry->node);
+    clear_slot(cache, find_slot(cache, entry->node.val));
+    cache->evictions += 1;
+    if (cache->on_evict != NULL) {
+        cache->on_evict(entry->node.val, entry->value, cache->evict_ctx);
+    }
+    return entry;
+}
+
+void lru_cache_init(Lru_Cache* cache, size_t capacity, size_t protected_capacity, Lru_Cache_Evict_Fn on_evict,
+                    void* evict_ctx) {
+    assert(cache != NULL && "Cache handle is NULL.");
+    assert(capacity > 0 && capacity < UINT32_MAX && "Cache capacity is out of range.");
+    assert(protected_capacity < capacity && "Protected capacity leaves no room for probation.");
+
+    size_t slot_count = 2;
+    while (slot_count < 2 * capacity) {
+        slot_count *= 2;
+    }
+    cache->entries = (Lru_Cache_Entry*) malloc(capacity * sizeof(Lru_Cache_Entry));
+    cache->slots   = (Lru_Cache_Slot*) calloc(slot_count, sizeof(Lru_Cache_Slot));
+    assert(cache->entries != NULL && cache->slots != NULL && "Unable to allocate more memory.");
+
+    cache->capacity           = (uint32_t) capacity;
+    cache->used               = 0;
+    cache->free_entries       = NULL;
+    cache->slot_mask          = slot_count - 1;
+    cache->protected_capacity = protected_capacity;
+    cache->on_evict           = on_evict;
+    cache->evict_ctx          = evict_ctx;
+    cache->hits               = 0;
+    cache->misses             = 0;
+    cache->evictions          = 0;
+    doubly_list_init(&cache->probation);
+    doubly_list_init(&cache->protected_list);
+}
+
+void lru_cache_free(Lru_Cache* cache) {
+    assert(cache != NULL && "Cache handle is NULL.");
+
+    free(cache->entries);
+    free(cache->slots);
+    cache->entries      = NULL;
+    cache->slots        = NULL;
+    cache->free_entries = NULL;
+    cache->capacity     = 0;
+    cache->used         = 0;
+    doubly_list_init(&cache->probation);
+    doubly_list_init(&cache->protected_list);
+}
+
+size_t lru_cache_count(Lru_Cache* cache) {
+    assert(cache != NULL && "Cache handle is NULL.");
+
+    return cache->probation.count + cache->protected_list.count;
+}
+
+bool lru_cache_peek(Lru_Cache* cache, int key, void** value) {
+    assert(cache != NULL && "Cache handle is NULL.");
+
+    Lru_Cache_Slot slot = cache->slots[find_slot(cache, key)];
+    if (slot.entry == 0) {
+        return false;
+    }
+
+    if (value != NULL) {
+        *value = cache->entries[slot.entry - 1].value;
+    }
+    return true;
+}
+
+bool lru_cache_get(Lru_Cache* cache, int key, void** value) {
+    assert(cache != NULL && "Cache handle is NULL.");
+
+    Lru_Cache_Slot slot = cache->slots[find_slot(cache, key)];
+    if (slot.entry == 0) {
+        cache->misses += 1;
+        return false;
+    }
+
+    cache->hits += 1;
+    Lru_Cache_Entry* entry = &cache->entries[slot.entry - 1];
+    touch(cache, entry);
+    if (value != NULL) {
+        *value = entry->value;
+    }
+    return true;
+}
+
+bool lru_cache_put(Lru_Cache* cache, int key, void* value) {
+    assert(cache != NULL && "Cache handle is NULL.");
+
+    size_t slot = find_slot(cache, key);
+    if (cache->slots[slot].entry != 0) {
+        Lru_Cache_Entry* entry = &cache->entries[cache->slots[slot].entry - 1];
+        entry->value = value;
+        touch(cache, entry);
+        return false;
+    }
+
+    Lru_Cache_Entry* entry;
+    if (cache->free_entries != NULL) {
+        entry = entry_of(cache->free_entries);
+        cache->free_entries = cache->free_entries->next;
+    } else if (cache->used < cache->capacity) {
+        entry = &cache->entries[cache->used++];
+    } else {
+        // Full: the victim's entry is reused for `key`.
+        entry = evict_entry(cache);
+        // Clearing the victim's slot may have shifted the empty slot `key` probed to.
+        slot = find_slot(cache, key);
+    }
+
+    entry->node.val     = key;
+    entry->value        = value;
+    entry->is_protected = false;
+    link_front(&cache->probation, &entry->node);
+    cache->slots[slot].key   = key;
+    cache->slots[slot].entry = (uint32_t) (entry - cache->entries) + 1;
+    return true;
+}
+
+bool lru_cache_evict(Lru_Cache* cache, int* key, void** value) {
+    assert(cache != NULL && "Cache handle is NULL.");
+
+    if (cache->probation.tail == NULL && cache->protected_list.tail == NULL) {
+        return false;
+    }
+
+    Lru_Cache_Entry* entry = evict_entry(cache);
+    if (key != NULL) {
+        *key = entry->node.val;
+    }
+    if (value != NULL) {
+        *value = entry->value;
+    }
+
+    entry->node.next    = cache->free_entries;
+    cache->free_entries = &entry->node;
+    return true;
+}
+
+bool lru_cache_remove(Lru_Cache* cache, int key, void** removed_value) {
+    assert(cache != NULL && "Cache handle is NULL.");
+
+    size_t slot = find_slot(cache, key);
+    if (cache->slots[slot].entry == 0) {
+        return false;
+    }
+
+    Lru_Cache_Entry* entry = &cache->entries[cache->slots[slot].entry - 1];
+    clear_slot(cache, slot);
+    unlink_node(segment_of(cache, entry), &entry->node);
+    if (removed_value != NULL) {
+        *removed_value = entry->value;
+    }
+
+    entry->node.next    = cache->free_entries;
+    cache->free_entries = &entry->node;
+    return true;
+}
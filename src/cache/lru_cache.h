@@ -0,0 +1,221 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "linkedlist.h"
+
+/**
+ * @brief Called with the key and value of every entry the cache evicts to make room.
+ */
+typedef void (*Lru_Cache_Evict_Fn)(int key, void* value, void* ctx);
+
+/**
+ * @struct Lru_Cache_Entry
+ * @brief A cached key and value, linked in the recency list of its segment.
+ *
+ * Fields:
+ * - `node`:
+ *   The link in the recency list, `node.val` holding the key.
+ *
+ * - `value`:
+ *   The cached value.
+ *
+ * - `is_protected`:
+ *   Whether the entry is in the protected segment, rather than in probation.
+ */
+typedef struct Lru_Cache_Entry {
+    Doubly_Linked_List_Node node;
+    void*                   value;
+    bool                    is_protected;
+} Lru_Cache_Entry;
+
+/**
+ * @struct Lru_Cache_Slot
+ * @brief A slot of the hash index: a key and the index of its entry, plus one.
+ *
+ * The key is copied in the slot so that probing compares keys without loading the
+ * entries, `entry == 0` marks an empty slot.
+ */
+typedef struct Lru_Cache_Slot {
+    int      key;
+    uint32_t entry;
+} Lru_Cache_Slot;
+
+/**
+ * @struct Lru_Cache
+ * @brief A fixed capacity cache from `int` keys to `void*` values, evicting the least
+ *        recently used entry, optionally segmented.
+ *
+ * Looking a key up in a `Doubly_Linked_List_Node` recency list is a linear search.
+ * The cache pairs the lists with an open addressing hash index from key to entry, so
+ * a lookup, a move to the front and an eviction from the back are all O(1).
+ *
+ * With a protected capacity of `0` the cache is a plain LRU: one recency list, the
+ * least recently used entry is evicted. Otherwise it is a segmented LRU: new entries
+ * go to the probation segment, a hit moves an entry to the protected segment, and
+ * the least recently used protected entry goes back to probation when the protected
+ * segment is over its capacity. Evictions come from probation, so entries used once
+ * do not flush the ones used repeatedly.
+ *
+ * Fields:
+ * - `entries`:
+ *   The `capacity` entries, allocated once by `lru_cache_init`.
+ *
+ * - `capacity`:
+ *   The maximum number of entries.
+ *
+ * - `used`:
+ *   The number of entries handed out at least once.
+ *
+ * - `free_entries`:
+ *   The removed entries to reuse first, chained through `node.next`.
+ *
+ * - `slots`:
+ *   The hash index, linear probing over a power of two number of slots at most half full.
+ *
+ * - `slot_mask`:
+ *   The number of slots minus one.
+ *
+ * - `probation`, `protected_list`:
+ *   The recency lists of the segments, most recently used at `head`. Only `head`,
+ *   `tail` and `count` of the handles are used, the cache links its own nodes.
+ *
+ * - `protected_capacity`:
+ *   The maximum number of entries in the protected segment, `0` for a plain LRU.
+ *
+ * - `on_evict`, `evict_ctx`:
+ *   The eviction callback, which may be `NULL`, and its last argument.
+ *
+ * - `hits`, `misses`, `evictions`:
+ *   The counters of `lru_cache_get` results and of evicted entries, which the caller
+ *   may read and reset.
+ *
+ * Example:
+ *
+ * ```c
+ * Lru_Cache cache;
+ * lru_cache_init(&cache, 2, 0, NULL, NULL);
+ *
+ * lru_cache_put(&cache, 1, "one");
+ * lru_cache_put(&cache, 2, "two");
+ * void* value;
+ * lru_cache_get(&cache, 1, &value); // 2 is now the least recently used.
+ * lru_cache_put(&cache, 3, "three"); // Evicts 2.
+ * printf("%d\n", lru_cache_get(&cache, 2, &value)); // Output: 0
+ *
+ * lru_cache_free(&cache);
+ * ```
+ *
+ * Notes:
+ * - The cache is not thread safe.
+ * - The cache never frees values, the eviction callback is where to release them.
+ */
+typedef struct Lru_Cache {
+    Lru_Cache_Entry*         entries;
+    uint32_t                 capacity;
+    uint32_t                 used;
+    Doubly_Linked_List_Node* free_entries;
+    Lru_Cache_Slot*          slots;
+    size_t                   slot_mask;
+    Doubly_List              probation;
+    Doubly_List              protected_list;
+    size_t                   protected_capacity;
+    Lru_Cache_Evict_Fn       on_evict;
+    void*                    evict_ctx;
+    uint64_t                 hits;
+    uint64_t                 misses;
+    uint64_t                 evictions;
+} Lru_Cache;
+
+/**
+ * @brief Initializes an empty cache, allocating its entries and hash index.
+ *
+ * @param capacity
+ *        The maximum number of entries, between `1` and `UINT32_MAX - 1`.
+ *
+ * @param protected_capacity
+ *        The maximum number of entries of the protected segment, lower than
+ *        `capacity`, or `0` for a plain LRU. About 80% of the capacity is usual.
+ *
+ * @param on_evict
+ *        Called on every eviction, may be `NULL`.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void lru_cache_init(Lru_Cache* cache, size_t capacity, size_t protected_capacity, Lru_Cache_Evict_Fn on_evict,
+                    void* evict_ctx);
+
+/**
+ * @brief Frees the entries and the index, without calling the eviction callback.
+ */
+void lru_cache_free(Lru_Cache* cache);
+
+/**
+ * @brief Returns the number of cached entries.
+ */
+size_t lru_cache_count(Lru_Cache* cache);
+
+/**
+ * @brief Looks `key` up, counting a hit or a miss, and marks it as the most recently used.
+ *
+ * @param value
+ *        Where to store the value of `key` when it is cached, may be `NULL`.
+ *
+ * @return
+ *        `true` on a hit, `false` on a miss.
+ *
+ * Performance:
+ * - Time complexity: O(1) expected.
+ */
+bool lru_cache_get(Lru_Cache* cache, int key, void** value);
+
+/**
+ * @brief Looks `key` up without touching its recency nor the counters.
+ */
+bool lru_cache_peek(Lru_Cache* cache, int key, void** value);
+
+/**
+ * @brief Caches `value` for `key` and marks it as the most recently used.
+ *
+ * When `key` is not cached and the cache is full, the least recently used entry of
+ * probation (of the protected segment if probation is empty) is evicted first.
+ *
+ * @return
+ *        `true` if `key` was not cached, `false` if only its value was replaced.
+ *
+ * Performance:
+ * - Time complexity: O(1) expected.
+ */
+bool lru_cache_put(Lru_Cache* cache, int key, void* value);
+
+/**
+ * @brief Evicts the least recently used entry of probation, of the protected segment
+ *        if probation is empty, and calls the eviction callback with it.
+ *
+ * @param key, value
+ *        Where to store the key and the value of the evicted entry, may be `NULL`.
+ *
+ * @return
+ *        `true` if an entry was evicted, `false` if the cache is empty.
+ *
+ * Performance:
+ * - Time complexity: O(1) expected.
+ */
+bool lru_cache_evict(Lru_Cache* cache, int* key, void** value);
+
+/**
+ * @brief Removes `key`, without calling the eviction callback.
+ *
+ * @param removed_value
+ *        Where to store the value of the removed entry, may be `NULL`.
+ *
+ * @return
+ *        `true` if `key` was cached.
+ */
+bool lru_cache_remove(Lru_Cache* cache, int key, void** removed_value);
+
+#endif  // LRU_CACHE_H
@@ -0,0 +1,353 @@
+#include "compact_list.h"
+
+#define SENTINEL 0
+#define MIN_GROWTH 16
+
+static void resize(Compact_List* list, uint32_t capacity) {
+    Compact_List_Node* nodes = (Compact_List_Node*) realloc(list->nodes, (size_t) capacity * sizeof(Compact_List_Node));
+    assert(nodes != NULL && "Unable to allocate more memory.");
+    list->nodes    = nodes;
+    list->capacity = capacity;
+}
+
+// Returns the index of a node to link: a removed one if any, the next never used one
+// otherwise, doubling the array when it is full. Invalidates pointers to the nodes.
+static uint32_t alloc_node(Compact_List* list) {
+    if (list->free_head != SENTINEL) {
+        uint32_t node = list->free_head;
+        list->free_head = list->nodes[node].link[0];
+        return node;
+    }
+
+    if (list->used == list->capacity) {
+        assert(list->capacity < UINT32_MAX && "Compact list is full.");
+        uint32_t capacity = list->capacity < MIN_GROWTH ? MIN_GROWTH
+            : list->capacity > UINT32_MAX / 2 ? UINT32_MAX : list->capacity * 2;
+        resize(list, capacity);
+    }
+    return list->used++;
+}
+
+static uint32_t next_of(Compact_List* list, uint32_t node) {
+    return list->nodes[node].link[list->reversed];
+}
+
+static uint32_t prev_of(Compact_List* list, uint32_t node) {
+    return list->nodes[node].link[!list->reversed];
+}
+
+// Links a new node holding `val` between the adjacent `prev_node` and `next_node`,
+// either being the sentinel at the ends.
+static uint32_t link_between(Compact_List* list, uint32_t prev_node, uint32_t next_node, int val) {
+    uint32_t node = alloc_node(list);
+    Compact_List_Node* nodes = list->nodes;
+    bool dir = list->reversed;
+
+    nodes[node].val        = val;
+    nodes[node].link[dir]  = next_node;
+    nodes[node].link[!dir] = prev_node;
+    nodes[prev_node].link[dir]  = node;
+    nodes[next_node].link[!dir] = node;
+    list->count += 1;
+    return node;
+}
+
+// Returns the node at logical index `idx`, which must be in range, walking from the closer end.
+static uint32_t node_at(Compact_List* list, size_t idx) {
+    uint32_t node;
+    if (idx <= list->count / 2) {
+        node = next_of(list, SENTINEL);
+        for (size_t i = 0; i < idx; i += 1) {
+            node = next_of(list, node);
+        }
+    } else {
+        node = prev_of(list, SENTINEL);
+        for (size_t i = list->count - 1; i > idx; i -= 1) {
+            node = prev_of(list, node);
+        }
+    }
+    return node;
+}
+
+void compact_list_init(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    list->nodes     = NULL;
+    list->capacity  = 0;
+    resize(list, 1);
+    list->used      = 1;
+    list->free_head = SENTINEL;
+    list->count     = 0;
+    list->reversed  = false;
+    list->nodes[SENTINEL].link[0] = SENTINEL;
+    list->nodes[SENTINEL].link[1] = SENTINEL;
+}
+
+void compact_list_free(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    free(list->nodes);
+    list->nodes    = NULL;
+    list->capacity = 0;
+    list->used     = 0;
+    list->count    = 0;
+}
+
+void compact_list_reserve(Compact_List* list, size_t n) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(n < UINT32_MAX && "Compact list is full.");
+
+    if (n <= list->count) {
+        return;
+    }
+
+    // Removed nodes are reused first, only the others need never used slots.
+    size_t free_count = (size_t) list->used - 1 - list->count;
+    size_t missing    = n - list->count;
+    if (missing > free_count && list->used + (missing - free_count) > list->capacity) {
+        resize(list, (uint32_t) (list->used + (missing - free_count)));
+    }
+}
+
+void compact_list_shrink(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (list->used < list->capacity) {
+        resize(list, list->used);
+    }
+}
+
+size_t compact_list_count(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return list->count;
+}
+
+size_t compact_list_memory_usage(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return (size_t) list->capacity * sizeof(Compact_List_Node);
+}
+
+void compact_list_print(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    uint32_t node = next_of(list, SENTINEL);
+    if (node == SENTINEL) {
+        return;
+    }
+
+    printf("%d", list->nodes[node].val);
+    for (node = next_of(list, node); node != SENTINEL; node = next_of(list, node)) {
+        printf(" -> %d", list->nodes[node].val);
+    }
+}
+
+void compact_list_print_backward(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    uint32_t node = prev_of(list, SENTINEL);
+    if (node == SENTINEL) {
+        return;
+    }
+
+    printf("%d", list->nodes[node].val);
+    for (node = prev_of(list, node); node != SENTINEL; node = prev_of(list, node)) {
+        printf(" -> %d", list->nodes[node].val);
+    }
+}
+
+void compact_list_insert_head(Compact_List* list, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    link_between(list, SENTINEL, next_of(list, SENTINEL), val);
+}
+
+void compact_list_insert_tail(Compact_List* list, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    link_between(list, prev_of(list, SENTINEL), SENTINEL, val);
+}
+
+bool compact_list_insert(Compact_List* list, size_t idx, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx > list->count) {
+        return false;
+    }
+
+    compact_list_insert_before(list, idx < list->count ? node_at(list, idx) : SENTINEL, val);
+    return true;
+}
+
+// Removes `node`, which is the sentinel when the list is empty.
+static bool remove_node(Compact_List* list, uint32_t node, int* removed_val) {
+    if (node == SENTINEL) {
+        return false;
+    }
+
+    if (removed_val != NULL) {
+        *removed_val = list->nodes[node].val;
+    }
+    compact_list_erase(list, node);
+    return true;
+}
+
+bool compact_list_remove_head(Compact_List* list, int* removed_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return remove_node(list, next_of(list, SENTINEL), removed_val);
+}
+
+bool compact_list_remove_tail(Compact_List* list, int* removed_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return remove_node(list, prev_of(list, SENTINEL), removed_val);
+}
+
+bool compact_list_remove(Compact_List* list, size_t idx, int* removed_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->count) {
+        return false;
+    }
+
+    return remove_node(list, node_at(list, idx), removed_val);
+}
+
+bool compact_list_search(Compact_List* list, int needle_val, size_t* found_idx) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(found_idx != NULL && "Found index pointer is NULL.");
+
+    size_t idx = 0;
+    for (uint32_t node = next_of(list, SENTINEL); node != SENTINEL; node = next_of(list, node)) {
+        if (list->nodes[node].val == needle_val) {
+            *found_idx = idx;
+            return true;
+        }
+        idx += 1;
+    }
+
+    return false;
+}
+
+bool compact_list_get(Compact_List* list, size_t idx, int* get_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(get_val != NULL && "Get value pointer is NULL.");
+
+    if (idx >= list->count) {
+        return false;
+    }
+
+    *get_val = list->nodes[node_at(list, idx)].val;
+    return true;
+}
+
+bool compact_list_set(Compact_List* list, size_t idx, int new_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->count) {
+        return false;
+    }
+
+    list->nodes[node_at(list, idx)].val = new_val;
+    return true;
+}
+
+void compact_list_reverse(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    list->reversed = !list->reversed;
+}
+
+void compact_list_from_array(Compact_List* list, const int* vals, size_t n) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert((vals != NULL || n == 0) && "Values array is NULL.");
+    assert(n < UINT32_MAX && "Compact list is full.");
+
+    list->nodes = NULL;
+    resize(list, (uint32_t) n + 1);
+    list->used      = (uint32_t) n + 1;
+    list->free_head = SENTINEL;
+    list->count     = (uint32_t) n;
+    list->reversed  = false;
+
+    // Node `i + 1` holds `vals[i]`, the sentinel closes the circle at both ends.
+    Compact_List_Node* nodes = list->nodes;
+    for (uint32_t i = 1; i <= (uint32_t) n; i += 1) {
+        nodes[i].val     = vals[i - 1];
+        nodes[i].link[0] = i < (uint32_t) n ? i + 1 : SENTINEL;
+        nodes[i].link[1] = i - 1;
+    }
+    nodes[SENTINEL].link[0] = n > 0 ? 1 : SENTINEL;
+    nodes[SENTINEL].link[1] = (uint32_t) n;
+}
+
+Compact_List_Cursor compact_list_first(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return next_of(list, SENTINEL);
+}
+
+Compact_List_Cursor compact_list_last(Compact_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return prev_of(list, SENTINEL);
+}
+
+Compact_List_Cursor compact_list_next(Compact_List* list, Compact_List_Cursor cursor) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return cursor == COMPACT_LIST_END ? COMPACT_LIST_END : next_of(list, cursor);
+}
+
+Compact_List_Cursor compact_list_prev(Compact_List* list, Compact_List_Cursor cursor) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return cursor == COMPACT_LIST_END ? COMPACT_LIST_END : prev_of(list, cursor);
+}
+
+int compact_list_value(Compact_List* list, Compact_List_Cursor cursor) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(cursor != COMPACT_LIST_END && cursor < list->used && "Cursor is past the end of the list.");
+
+    return list->nodes[cursor].val;
+}
+
+void compact_list_set_value(Compact_List* list, Compact_List_Cursor cursor, int new_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(cursor != COMPACT_LIST_END && cursor < list->used && "Cursor is past the end of the list.");
+
+    list->nodes[cursor].val = new_val;
+}
+
+Compact_List_Cursor compact_list_insert_before(Compact_List* list, Compact_List_Cursor cursor, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(cursor < list->used && "Cursor is not a node of the list.");
+
+    return link_between(list, prev_of(list, cursor), cursor, val);
+}
+
+Compact_List_Cursor compact_list_insert_after(Compact_List* list, Compact_List_Cursor cursor, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(cursor < list->used && "Cursor is not a node of the list.");
+
+    return link_between(list, cursor, next_of(list, cursor), val);
+}
+
+Compact_List_Cursor compact_list_erase(Compact_List* list, Compact_List_Cursor cursor) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(cursor != COMPACT_LIST_END && cursor < list->used && "Cursor is past the end of the list.");
+
+    Compact_List_Node* nodes = list->nodes;
+    bool dir = list->reversed;
+    uint32_t prev_node = nodes[cursor].link[!dir];
+    uint32_t next_node = nodes[cursor].link[dir];
+    nodes[prev_node].link[dir]  = next_node;
+    nodes[next_node].link[!dir] = prev_node;
+
+    nodes[cursor].link[0] = list->free_head;
+    list->free_head       = cursor;
+    list->count -= 1;
+    return next_node;
+}
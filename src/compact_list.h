@@ -0,0 +1,272 @@
+#ifndef COMPACT_LIST_H
+#define COMPACT_LIST_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/**
+ * @struct Compact_List_Node
+ * @brief A doubly linked list node linking its neighbors by 32-bit indices.
+ *
+ * A `Doubly_Linked_List_Node` spends 16 of its 24 bytes on the two pointers around
+ * its 4 bytes `int`. The nodes of a `Compact_List` all live in a single array owned
+ * by the list, so a link only needs the index of the neighbor in that array: the node
+ * is 12 bytes, half the size, and indices stay valid when the array is reallocated.
+ *
+ * Fields:
+ * - `val`:
+ *   The value of the node.
+ *
+ * - `link`:
+ *   The indices of the next (`link[0]`) and previous (`link[1]`) nodes in the
+ *   physical order of the list, `0` being the sentinel of the list.
+ */
+typedef struct Compact_List_Node {
+    int      val;
+    uint32_t link[2];
+} Compact_List_Node;
+
+/**
+ * A position in a `Compact_List`, the index of its node. `COMPACT_LIST_END` is the
+ * position past the last node, and before the first one.
+ */
+typedef uint32_t Compact_List_Cursor;
+
+#define COMPACT_LIST_END ((Compact_List_Cursor) 0)
+
+/**
+ * @struct Compact_List
+ * @brief A doubly linked list of `int` storing its nodes in one array, with 32-bit links.
+ *
+ * The counterpart of `Doubly_List` for large lists: same operations, same O(1)
+ * reversal, half the memory per element. Nodes are allocated from the array, removed
+ * nodes are kept in a free list and reused before the array grows.
+ *
+ * Fields:
+ * - `nodes`:
+ *   The node array. `nodes[0]` is a sentinel, its links are the head and tail of the
+ *   list, which is circular through it, so linking never checks for `NULL`.
+ *
+ * - `capacity`:
+ *   The number of nodes of the array, sentinel included.
+ *
+ * - `used`:
+ *   The number of nodes of the array handed out at least once, sentinel included.
+ *
+ * - `free_head`:
+ *   The first removed node to reuse, chained through `link[0]`, `0` when there is none.
+ *
+ * - `count`:
+ *   The number of elements in the list.
+ *
+ * - `reversed`:
+ *   Whether the list is read in the opposite of its physical order. The logical next
+ *   node is `link[reversed]` and the previous one `link[!reversed]`.
+ *
+ * Example:
+ *
+ * ```c
+ * Compact_List list;
+ * compact_list_init(&list);
+ *
+ * compact_list_insert_tail(&list, 10);
+ * compact_list_insert_tail(&list, 30);
+ * Compact_List_Cursor cursor = compact_list_last(&list);
+ * compact_list_insert_before(&list, cursor, 20);
+ * compact_list_print(&list); // Output: 10 -> 20 -> 30
+ *
+ * for (cursor = compact_list_first(&list); cursor != COMPACT_LIST_END;) {
+ *     cursor = compact_list_value(&list, cursor) == 20
+ *         ? compact_list_erase(&list, cursor)
+ *         : compact_list_next(&list, cursor);
+ * }
+ * compact_list_print(&list); // Output: 10 -> 30
+ *
+ * compact_list_free(&list);
+ * ```
+ *
+ * Notes:
+ * - Nodes are addressed by index and never by pointer: a `Compact_List_Node*` is
+ *   invalidated when the array grows, a cursor is valid until its node is removed.
+ * - The list holds at most `UINT32_MAX - 1` elements.
+ * - The array never shrinks on removal, `compact_list_shrink` gives the unused tail
+ *   of the array back.
+ */
+typedef struct Compact_List {
+    Compact_List_Node* nodes;
+    uint32_t           capacity;
+    uint32_t           used;
+    uint32_t           free_head;
+    uint32_t           count;
+    bool               reversed;
+} Compact_List;
+
+/**
+ * @brief Initializes an empty list.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void compact_list_init(Compact_List* list);
+
+/**
+ * @brief Frees the node array and leaves the handle uninitialized.
+ */
+void compact_list_free(Compact_List* list);
+
+/**
+ * @brief Grows the node array to hold at least `n` elements without reallocating.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void compact_list_reserve(Compact_List* list, size_t n);
+
+/**
+ * @brief Shrinks the node array to the nodes handed out so far.
+ *
+ * Removed nodes in the middle of the array stay allocated, to be reused by the next
+ * insertions.
+ */
+void compact_list_shrink(Compact_List* list);
+
+/**
+ * @brief Returns the number of elements in the list.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+size_t compact_list_count(Compact_List* list);
+
+/**
+ * @brief Returns the number of bytes allocated by the list, handle excluded.
+ */
+size_t compact_list_memory_usage(Compact_List* list);
+
+void compact_list_print(Compact_List* list);
+
+void compact_list_print_backward(Compact_List* list);
+
+/**
+ * @brief Inserts a new element holding `val` at the front or the back of the list.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ *
+ * Performance:
+ * - Time complexity: O(1), amortized over the doublings of the node array.
+ */
+void compact_list_insert_head(Compact_List* list, int val);
+void compact_list_insert_tail(Compact_List* list, int val);
+
+/**
+ * @brief Inserts a new element holding `val` at the given index.
+ *
+ * @return
+ *        `true` if the element was inserted, `false` if `idx` is greater than the count.
+ *
+ * Performance:
+ * - Time complexity: O(min(idx, n - idx)), the walk starts from the closer end.
+ */
+bool compact_list_insert(Compact_List* list, size_t idx, int val);
+
+/**
+ * @brief Removes the first, last or `idx`-th element and optionally retrieves its value.
+ *
+ * @param removed_val
+ *        Where to store the value of the removed element, may be `NULL`.
+ *
+ * @return
+ *        `true` if an element was removed, `false` if the list is empty or `idx` is
+ *        out of range.
+ *
+ * Performance:
+ * - Time complexity: O(1) for the ends, O(min(idx, n - idx)) for an index.
+ */
+bool compact_list_remove_head(Compact_List* list, int* removed_val);
+bool compact_list_remove_tail(Compact_List* list, int* removed_val);
+bool compact_list_remove(Compact_List* list, size_t idx, int* removed_val);
+
+/**
+ * @brief Searches for the first element holding `needle_val`.
+ *
+ * @param found_idx
+ *        Where to store the index of the first match. Must not be `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(n).
+ */
+bool compact_list_search(Compact_List* list, int needle_val, size_t* found_idx);
+
+/**
+ * @brief Retrieves or overwrites the value at the given index.
+ *
+ * @return
+ *        `true` if `idx` is in range, `false` otherwise.
+ *
+ * Performance:
+ * - Time complexity: O(min(idx, n - idx)), the walk starts from the closer end.
+ */
+bool compact_list_get(Compact_List* list, size_t idx, int* get_val);
+bool compact_list_set(Compact_List* list, size_t idx, int new_val);
+
+/**
+ * @brief Reverses the order of the list.
+ *
+ * Performance:
+ * - Time complexity: O(1), only the `reversed` flag is flipped.
+ */
+void compact_list_reverse(Compact_List* list);
+
+/**
+ * @brief Initializes a list holding the `n` values of `vals`, in order.
+ *
+ * The node array is allocated at its exact size and laid out in list order.
+ *
+ * Performance:
+ * - Time complexity: O(n), with a single allocation.
+ */
+void compact_list_from_array(Compact_List* list, const int* vals, size_t n);
+
+// Cursor walk, `COMPACT_LIST_END` past either end or on an empty list.
+Compact_List_Cursor compact_list_first(Compact_List* list);
+Compact_List_Cursor compact_list_last(Compact_List* list);
+Compact_List_Cursor compact_list_next(Compact_List* list, Compact_List_Cursor cursor);
+Compact_List_Cursor compact_list_prev(Compact_List* list, Compact_List_Cursor cursor);
+
+// Value at a cursor, which must not be `COMPACT_LIST_END`.
+int compact_list_value(Compact_List* list, Compact_List_Cursor cursor);
+void compact_list_set_value(Compact_List* list, Compact_List_Cursor cursor, int new_val);
+
+/**
+ * @brief Inserts a new element holding `val` before or after the element at `cursor`.
+ *
+ * Inserting before `COMPACT_LIST_END` appends, inserting after it prepends.
+ *
+ * @return
+ *        The cursor of the new element.
+ *
+ * Performance:
+ * - Time complexity: O(1), amortized over the doublings of the node array.
+ */
+Compact_List_Cursor compact_list_insert_before(Compact_List* list, Compact_List_Cursor cursor, int val);
+Compact_List_Cursor compact_list_insert_after(Compact_List* list, Compact_List_Cursor cursor, int val);
+
+/**
+ * @brief Removes the element at `cursor`, which must not be `COMPACT_LIST_END`.
+ *
+ * @return
+ *        The cursor of the element that followed the removed one.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+Compact_List_Cursor compact_list_erase(Compact_List* list, Compact_List_Cursor cursor);
+
+#endif  // COMPACT_LIST_H
@@ -0,0 +1,152 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+
+#define EPOCH_COLLECT_INTERVAL 256
+
+typedef struct Retired_Node {
+    void*         node;
+    Epoch_Free_Fn free_fn;
+    unsigned      epoch;
+} Retired_Node;
+
+// Records are cache-line aligned so that entering a critical section never
+// invalidates the line of another thread.
+typedef struct Epoch_Record {
+    _Alignas(64) atomic_uint local_epoch;
+    atomic_bool   active;
+    atomic_bool   in_use;
+    unsigned      nesting;
+    Retired_Node* retired;
+    size_t        retired_count;
+    size_t        retired_capacity;
+    size_t        retired_since_collect;
+} Epoch_Record;
+
+static Epoch_Record records[EPOCH_MAX_THREADS];
+static _Alignas(64) atomic_uint global_epoch;
+static _Thread_local Epoch_Record* local_record = NULL;
+
+static Epoch_Record* claim_record(void) {
+    if (local_record != NULL) {
+        return local_record;
+    }
+
+    for (size_t i = 0; i < EPOCH_MAX_THREADS; i += 1) {
+        bool expected = false;
+        if (!atomic_load_explicit(&records[i].in_use, memory_order_relaxed) &&
+            atomic_compare_exchange_strong(&records[i].in_use, &expected, true)) {
+            local_record = &records[i];
+            return local_record;
+        }
+    }
+
+    assert(false && "Too many threads use epochs.");
+    return NULL;
+}
+
+void epoch_enter(void) {
+    Epoch_Record* record = claim_record();
+    if (record->nesting++ > 0) {
+        return;
+    }
+
+    // Publishing `active` before reading the global epoch (both sequentially
+    // consistent) guarantees that a thread advancing the epoch either sees this
+    // record active or the advanced epoch is the one recorded here.
+    atomic_store(&record->active, true);
+    atomic_store(&record->local_epoch, atomic_load(&global_epoch));
+}
+
+void epoch_exit(void) {
+    Epoch_Record* record = local_record;
+    assert(record != NULL && record->nesting > 0 && "Epoch exit without matching enter.");
+
+    if (--record->nesting == 0) {
+        atomic_store_explicit(&record->active, false, memory_order_release);
+    }
+}
+
+// Advances the global epoch if every active thread observed the current one.
+static unsigned try_advance(void) {
+    unsigned epoch = atomic_load(&global_epoch);
+    for (size_t i = 0; i < EPOCH_MAX_THREADS; i += 1) {
+        if (atomic_load(&records[i].active) && atomic_load(&records[i].local_epoch) != epoch) {
+            return epoch;
+        }
+    }
+
+    if (atomic_compare_exchange_strong(&global_epoch, &epoch, epoch + 1)) {
+        return epoch + 1;
+    }
+    return epoch;
+}
+
+// Frees the nodes retired in `record` at least two epochs before `epoch`.
+static void collect(Epoch_Record* record, unsigned epoch) {
+    size_t kept = 0;
+    for (size_t i = 0; i < record->retired_count; i += 1) {
+        Retired_Node retired = record->retired[i];
+        if (epoch - retired.epoch >= 2) {
+            retired.free_fn(retired.node);
+        } else {
+            record->retired[kept] = retired;
+            kept += 1;
+        }
+    }
+    record->retired_count = kept;
+    record->retired_since_collect = 0;
+}
+
+void epoch_retire(void* node, Epoch_Free_Fn free_fn) {
+    assert(node != NULL && "Retired node is NULL.");
+    assert(free_fn != NULL && "Free function is NULL.");
+
+    Epoch_Record* record = claim_record();
+    if (record->retired_count == record->retired_capacity) {
+        size_t capacity = record->retired_capacity != 0 ? record->retired_capacity * 2 : EPOCH_COLLECT_INTERVAL;
+        Retired_Node* retired = (Retired_Node*) realloc(record->retired, capacity * sizeof(Retired_Node));
+        assert(retired != NULL && "Unable to allocate more memory.");
+
+        record->retired          = retired;
+        record->retired_capacity = capacity;
+    }
+
+    record->retired[record->retired_count] = (Retired_Node) { node, free_fn, atomic_load(&global_epoch) };
+    record->retired_count += 1;
+    record->retired_since_collect += 1;
+
+    if (record->retired_since_collect >= EPOCH_COLLECT_INTERVAL) {
+        collect(record, try_advance());
+    }
+}
+
+void epoch_thread_exit(void) {
+    Epoch_Record* record = local_record;
+    if (record == NULL) {
+        return;
+    }
+    assert(record->nesting == 0 && "Epoch thread exit inside a critical section.");
+
+    collect(record, try_advance());
+
+    local_record = NULL;
+    atomic_store_explicit(&record->in_use, false, memory_order_release);
+}
+
+void epoch_drain(void) {
+    for (size_t i = 0; i < EPOCH_MAX_THREADS; i += 1) {
+        Epoch_Record* record = &records[i];
+        for (size_t j = 0; j < record->retired_count; j += 1) {
+            record->retired[j].free_fn(record->retired[j].node);
+        }
+        free(record->retired);
+        record->retired          = NULL;
+        record->retired_count    = 0;
+        record->retired_capacity = 0;
+        record->retired_since_collect = 0;
+    }
+}
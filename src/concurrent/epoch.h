@@ -0,0 +1,75 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <stddef.h>
+
+#define EPOCH_MAX_THREADS 128
+
+/**
+ * @brief Epoch based reclamation, for lock-free structures whose operations hold
+ *        more node references than hazard pointer slots can cover.
+ *
+ * Every access to the shared structure happens between `epoch_enter` and
+ * `epoch_exit`. A node unlinked from the structure is retired with the global epoch
+ * current at that time. The global epoch only advances once every thread inside a
+ * critical section has observed it, so a node retired at epoch `e` is freed once
+ * the global epoch reaches `e + 2`: no thread can still be in a critical section
+ * that started before the node was unlinked.
+ *
+ * Compared to hazard pointers, readers pay a single store on enter and exit instead
+ * of one per dereferenced node, the price being that a thread stalled inside a
+ * critical section delays the reclamation of every retired node.
+ *
+ * Every thread lazily claims one of the `EPOCH_MAX_THREADS` records.
+ *
+ * Notes:
+ * - Critical sections may nest, only the outermost `epoch_exit` leaves the section.
+ * - A thread done with the structures should call `epoch_thread_exit` so that its
+ *   record can be claimed by another thread.
+ */
+typedef void (*Epoch_Free_Fn)(void* node);
+
+/**
+ * @brief Enters a critical section, nodes read from now on stay valid until `epoch_exit`.
+ *
+ * Potential Errors:
+ * - Claiming a record when `EPOCH_MAX_THREADS` threads already hold one will cause
+ *   an assertion error.
+ */
+void epoch_enter(void);
+
+/**
+ * @brief Leaves the critical section entered by the matching `epoch_enter`.
+ */
+void epoch_exit(void);
+
+/**
+ * @brief Hands a node unlinked from a shared structure over for reclamation.
+ *
+ * `free_fn` is called on `node` two epochs later.
+ *
+ * Performance:
+ * - Time complexity: amortized O(1). Every `EPOCH_COLLECT_INTERVAL` retirements, the
+ *   thread tries to advance the global epoch, visiting every record, and frees its
+ *   retired nodes that became safe.
+ */
+void epoch_retire(void* node, Epoch_Free_Fn free_fn);
+
+/**
+ * @brief Frees what the calling thread can and gives its record back.
+ *
+ * Must not be called inside a critical section. The nodes not safe to free yet stay
+ * attached to the record and are reclaimed by the next thread claiming it, or by
+ * `epoch_drain`.
+ */
+void epoch_thread_exit(void);
+
+/**
+ * @brief Frees every retired node of every record.
+ *
+ * Must only be called once no other thread uses a structure relying on epochs,
+ * usually at the end of the program.
+ */
+void epoch_drain(void);
+
+#endif  // EPOCH_H
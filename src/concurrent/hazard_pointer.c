@@ -0,0 +1,143 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "hazard_pointer.h"
+
+#define HAZARD_POINTER_SCAN_THRESHOLD (2 * HAZARD_POINTER_MAX_THREADS * HAZARD_POINTER_SLOTS)
+
+typedef struct Retired_Node {
+    void*                  node;
+    Hazard_Pointer_Free_Fn free_fn;
+} Retired_Node;
+
+// Records are cache-line aligned so that the slots of two threads never share a line.
+typedef struct Hazard_Pointer_Record {
+    _Alignas(64) _Atomic(void*) slots[HAZARD_POINTER_SLOTS];
+    atomic_bool   in_use;
+    Retired_Node* retired;
+    size_t        retired_count;
+    size_t        retired_capacity;
+} Hazard_Pointer_Record;
+
+static Hazard_Pointer_Record records[HAZARD_POINTER_MAX_THREADS];
+static _Thread_local Hazard_Pointer_Record* local_record = NULL;
+
+static Hazard_Pointer_Record* claim_record(void) {
+    if (local_record != NULL) {
+        return local_record;
+    }
+
+    for (size_t i = 0; i < HAZARD_POINTER_MAX_THREADS; i += 1) {
+        bool expected = false;
+        if (!atomic_load_explicit(&records[i].in_use, memory_order_relaxed) &&
+            atomic_compare_exchange_strong(&records[i].in_use, &expected, true)) {
+            local_record = &records[i];
+            return local_record;
+        }
+    }
+
+    assert(false && "Too many threads use hazard pointers.");
+    return NULL;
+}
+
+void hazard_pointer_set(size_t slot, void* node) {
+    assert(slot < HAZARD_POINTER_SLOTS && "Hazard pointer slot out of range.");
+
+    // Sequentially consistent so that the store is visible before the caller
+    // reloads the shared pointer to validate it.
+    atomic_store(&claim_record()->slots[slot], node);
+}
+
+void hazard_pointer_clear(size_t slot) {
+    assert(slot < HAZARD_POINTER_SLOTS && "Hazard pointer slot out of range.");
+
+    atomic_store_explicit(&claim_record()->slots[slot], NULL, memory_order_release);
+}
+
+static int compare_addresses(const void* a, const void* b) {
+    uintptr_t lhs = (uintptr_t) *(void* const*) a;
+    uintptr_t rhs = (uintptr_t) *(void* const*) b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+// Frees the nodes retired in `record` that no slot of any record protects.
+static void scan(Hazard_Pointer_Record* record) {
+    void*  hazards[HAZARD_POINTER_MAX_THREADS * HAZARD_POINTER_SLOTS];
+    size_t hazard_count = 0;
+
+    for (size_t i = 0; i < HAZARD_POINTER_MAX_THREADS; i += 1) {
+        for (size_t slot = 0; slot < HAZARD_POINTER_SLOTS; slot += 1) {
+            void* hazard = atomic_load(&records[i].slots[slot]);
+            if (hazard != NULL) {
+                hazards[hazard_count] = hazard;
+                hazard_count += 1;
+            }
+        }
+    }
+    qsort(hazards, hazard_count, sizeof(void*), compare_addresses);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < record->retired_count; i += 1) {
+        Retired_Node retired = record->retired[i];
+        if (bsearch(&retired.node, hazards, hazard_count, sizeof(void*), compare_addresses) != NULL) {
+            record->retired[kept] = retired;
+            kept += 1;
+        } else {
+            retired.free_fn(retired.node);
+        }
+    }
+    record->retired_count = kept;
+}
+
+void hazard_pointer_retire(void* node, Hazard_Pointer_Free_Fn free_fn) {
+    assert(node != NULL && "Retired node is NULL.");
+    assert(free_fn != NULL && "Free function is NULL.");
+
+    Hazard_Pointer_Record* record = claim_record();
+    if (record->retired_count == record->retired_capacity) {
+        size_t capacity = record->retired_capacity != 0 ? record->retired_capacity * 2 : HAZARD_POINTER_SCAN_THRESHOLD;
+        Retired_Node* retired = (Retired_Node*) realloc(record->retired, capacity * sizeof(Retired_Node));
+        assert(retired != NULL && "Unable to allocate more memory.");
+
+        record->retired          = retired;
+        record->retired_capacity = capacity;
+    }
+
+    record->retired[record->retired_count] = (Retired_Node) { node, free_fn };
+    record->retired_count += 1;
+
+    if (record->retired_count >= HAZARD_POINTER_SCAN_THRESHOLD) {
+        scan(record);
+    }
+}
+
+void hazard_pointer_thread_exit(void) {
+    Hazard_Pointer_Record* record = local_record;
+    if (record == NULL) {
+        return;
+    }
+
+    for (size_t slot = 0; slot < HAZARD_POINTER_SLOTS; slot += 1) {
+        atomic_store(&record->slots[slot], NULL);
+    }
+    scan(record);
+
+    local_record = NULL;
+    atomic_store_explicit(&record->in_use, false, memory_order_release);
+}
+
+void hazard_pointer_drain(void) {
+    for (size_t i = 0; i < HAZARD_POINTER_MAX_THREADS; i += 1) {
+        Hazard_Pointer_Record* record = &records[i];
+        for (size_t j = 0; j < record->retired_count; j += 1) {
+            record->retired[j].free_fn(record->retired[j].node);
+        }
+        free(record->retired);
+        record->retired          = NULL;
+        record->retired_count    = 0;
+        record->retired_capacity = 0;
+    }
+}
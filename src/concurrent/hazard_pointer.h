@@ -0,0 +1,83 @@
+#ifndef HAZARD_POINTER_H
+#define HAZARD_POINTER_H
+
+#include <stddef.h>
+
+#define HAZARD_POINTER_MAX_THREADS 128
+#define HAZARD_POINTER_SLOTS       2
+
+/**
+ * @brief Hazard pointers, the memory reclamation scheme of the lock-free containers.
+ *
+ * A thread about to dereference a node shared with other threads first publishes its
+ * address in one of its hazard pointer slots, then checks that the node is still
+ * reachable. A node unlinked from a container is not freed right away but retired:
+ * it is only freed once no slot of any thread holds its address anymore. This both
+ * prevents use after free and the ABA problem, since the address of a protected node
+ * can not be handed out again by the allocator while a thread still compares to it.
+ *
+ * Every thread lazily claims one of the `HAZARD_POINTER_MAX_THREADS` records, holding
+ * `HAZARD_POINTER_SLOTS` slots and the list of the nodes the thread retired.
+ *
+ * Example:
+ *
+ * ```c
+ * Node* node;
+ * do {
+ *     node = atomic_load(&shared);
+ *     hazard_pointer_set(0, node);
+ * } while (node != atomic_load(&shared));
+ *
+ * // `node` can be dereferenced until the slot is cleared.
+ * hazard_pointer_clear(0);
+ * ```
+ *
+ * Notes:
+ * - A thread done with the lock-free containers should call `hazard_pointer_thread_exit`
+ *   so that its record can be claimed by another thread.
+ */
+typedef void (*Hazard_Pointer_Free_Fn)(void* node);
+
+/**
+ * @brief Publishes `node` in the slot `slot` of the calling thread.
+ *
+ * Potential Errors:
+ * - Claiming a record when `HAZARD_POINTER_MAX_THREADS` threads already hold one will
+ *   cause an assertion error.
+ */
+void hazard_pointer_set(size_t slot, void* node);
+
+/**
+ * @brief Clears the slot `slot` of the calling thread.
+ */
+void hazard_pointer_clear(size_t slot);
+
+/**
+ * @brief Hands a node unlinked from a shared structure over for reclamation.
+ *
+ * `free_fn` is called on `node` once no hazard pointer protects it anymore.
+ *
+ * Performance:
+ * - Time complexity: amortized O(1). Every `2 * HAZARD_POINTER_MAX_THREADS * HAZARD_POINTER_SLOTS`
+ *   retirements, the thread scans every published hazard pointer and frees the
+ *   nodes that are not protected.
+ */
+void hazard_pointer_retire(void* node, Hazard_Pointer_Free_Fn free_fn);
+
+/**
+ * @brief Clears the slots of the calling thread, reclaims what it can and gives its record back.
+ *
+ * The nodes still protected by other threads stay attached to the record and are
+ * reclaimed by the next thread claiming it, or by `hazard_pointer_drain`.
+ */
+void hazard_pointer_thread_exit(void);
+
+/**
+ * @brief Frees every retired node of every record.
+ *
+ * Must only be called once no other thread uses a lock-free container anymore,
+ * usually at the end of the program.
+ */
+void hazard_pointer_drain(void);
+
+#endif  // HAZARD_POINTER_H
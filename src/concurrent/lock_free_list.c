@@ -0,0 +1,176 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "hazard_pointer.h"
+#include "lock_free_list.h"
+
+static Lock_Free_Node* lock_free_node_new(int val) {
+    Lock_Free_Node* node = (Lock_Free_Node*) malloc(sizeof(Lock_Free_Node));
+    assert(node != NULL && "Unable to allocate more memory.");
+
+    node->val = val;
+    atomic_init(&node->next, NULL);
+    return node;
+}
+
+static void lock_free_node_free(void* node) {
+    free(node);
+}
+
+// Loads `*src` and publishes it in `slot` until the published node is still the one
+// in `*src`, at which point it can not be reclaimed until the slot is cleared.
+static Lock_Free_Node* protect(size_t slot, _Atomic(Lock_Free_Node*)* src) {
+    Lock_Free_Node* node = atomic_load(src);
+    for (;;) {
+        hazard_pointer_set(slot, node);
+        Lock_Free_Node* current = atomic_load(src);
+        if (current == node) {
+            return node;
+        }
+        node = current;
+    }
+}
+
+void lock_free_stack_init(Lock_Free_Stack* stack) {
+    assert(stack != NULL && "Lock-free stack is NULL.");
+
+    atomic_init(&stack->top, NULL);
+}
+
+void lock_free_stack_free(Lock_Free_Stack* stack) {
+    assert(stack != NULL && "Lock-free stack is NULL.");
+
+    Lock_Free_Node* node = atomic_load_explicit(&stack->top, memory_order_relaxed);
+    while (node != NULL) {
+        Lock_Free_Node* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+        free(node);
+        node = next;
+    }
+    atomic_store_explicit(&stack->top, NULL, memory_order_relaxed);
+}
+
+void lock_free_stack_push(Lock_Free_Stack* stack, int val) {
+    assert(stack != NULL && "Lock-free stack is NULL.");
+
+    Lock_Free_Node* node = lock_free_node_new(val);
+    Lock_Free_Node* top  = atomic_load_explicit(&stack->top, memory_order_relaxed);
+    do {
+        atomic_store_explicit(&node->next, top, memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&stack->top, &top, node,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+bool lock_free_stack_pop(Lock_Free_Stack* stack, int* popped_val) {
+    assert(stack != NULL && "Lock-free stack is NULL.");
+    assert(popped_val != NULL && "Popped value is NULL.");
+
+    Lock_Free_Node* top;
+    for (;;) {
+        top = protect(0, &stack->top);
+        if (top == NULL) {
+            hazard_pointer_clear(0);
+            return false;
+        }
+
+        Lock_Free_Node* next = atomic_load_explicit(&top->next, memory_order_acquire);
+        if (atomic_compare_exchange_weak_explicit(&stack->top, &top, next,
+                                                  memory_order_acquire, memory_order_relaxed)) {
+            break;
+        }
+    }
+    hazard_pointer_clear(0);
+
+    *popped_val = top->val;
+    hazard_pointer_retire(top, lock_free_node_free);
+    return true;
+}
+
+void lock_free_queue_init(Lock_Free_Queue* queue) {
+    assert(queue != NULL && "Lock-free queue is NULL.");
+
+    Lock_Free_Node* dummy = lock_free_node_new(0);
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+}
+
+void lock_free_queue_free(Lock_Free_Queue* queue) {
+    assert(queue != NULL && "Lock-free queue is NULL.");
+
+    Lock_Free_Node* node = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    while (node != NULL) {
+        Lock_Free_Node* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+        free(node);
+        node = next;
+    }
+    atomic_store_explicit(&queue->head, NULL, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, NULL, memory_order_relaxed);
+}
+
+void lock_free_queue_enqueue(Lock_Free_Queue* queue, int val) {
+    assert(queue != NULL && "Lock-free queue is NULL.");
+
+    Lock_Free_Node* node = lock_free_node_new(val);
+    Lock_Free_Node* tail;
+    for (;;) {
+        tail = protect(0, &queue->tail);
+        Lock_Free_Node* next = atomic_load(&tail->next);
+        if (tail != atomic_load(&queue->tail)) {
+            continue;
+        }
+
+        if (next != NULL) {
+            // Another enqueue linked its node but did not swing `tail` yet, help it.
+            atomic_compare_exchange_weak(&queue->tail, &tail, next);
+            continue;
+        }
+
+        Lock_Free_Node* expected = NULL;
+        if (atomic_compare_exchange_weak(&tail->next, &expected, node)) {
+            break;
+        }
+    }
+
+    // Failing is fine: some other thread already swung `tail` past our node.
+    atomic_compare_exchange_strong(&queue->tail, &tail, node);
+    hazard_pointer_clear(0);
+}
+
+bool lock_free_queue_dequeue(Lock_Free_Queue* queue, int* dequeued_val) {
+    assert(queue != NULL && "Lock-free queue is NULL.");
+    assert(dequeued_val != NULL && "Dequeued value is NULL.");
+
+    Lock_Free_Node* head;
+    for (;;) {
+        head = protect(0, &queue->head);
+        Lock_Free_Node* tail = atomic_load(&queue->tail);
+        Lock_Free_Node* next = atomic_load(&head->next);
+        hazard_pointer_set(1, next);
+        // `head` still being the head means `next` is still reachable, so it is safe
+        // to read its value once published.
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+
+        if (next == NULL) {
+            hazard_pointer_clear(0);
+            hazard_pointer_clear(1);
+            return false;
+        }
+
+        if (head == tail) {
+            // `tail` lags behind a half done enqueue, swing it before unlinking `head`.
+            atomic_compare_exchange_weak(&queue->tail, &tail, next);
+            continue;
+        }
+
+        *dequeued_val = next->val;
+        if (atomic_compare_exchange_weak(&queue->head, &head, next)) {
+            break;
+        }
+    }
+    hazard_pointer_clear(0);
+    hazard_pointer_clear(1);
+
+    hazard_pointer_retire(head, lock_free_node_free);
+    return true;
+}
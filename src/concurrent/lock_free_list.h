@@ -0,0 +1,154 @@
+#ifndef LOCK_FREE_LIST_H
+#define LOCK_FREE_LIST_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @struct Lock_Free_Node
+ * @brief A node of the lock-free stack and queue.
+ *
+ * Same layout as `Singly_Linked_List_Node`, with an atomic `next` link so that
+ * several threads can follow and swing it concurrently.
+ *
+ * Nodes are allocated by the push/enqueue procedures and reclaimed through hazard
+ * pointers (see `hazard_pointer.h`) once popped, since another thread may still be
+ * reading a node after it has been unlinked.
+ */
+typedef struct Lock_Free_Node {
+    int val;
+    _Atomic(struct Lock_Free_Node*) next;
+} Lock_Free_Node;
+
+/**
+ * @struct Lock_Free_Stack
+ * @brief A lock-free LIFO (Treiber stack) safe to share between any number of threads.
+ *
+ * Fields:
+ * - `top`:
+ *   The last pushed node, `NULL` when the stack is empty.
+ *
+ * Example:
+ *
+ * ```c
+ * Lock_Free_Stack stack;
+ * lock_free_stack_init(&stack);
+ *
+ * // From any thread.
+ * lock_free_stack_push(&stack, 42);
+ *
+ * int val;
+ * if (lock_free_stack_pop(&stack, &val)) {
+ *     printf("%d\n", val); // Output: 42
+ * }
+ *
+ * lock_free_stack_free(&stack);
+ * ```
+ *
+ * Notes:
+ * - A pop only succeeds if the top did not change since it was read. The popped
+ *   node is protected by a hazard pointer in between, so it can not be freed and
+ *   its address reused by a push, which rules out the ABA problem.
+ */
+typedef struct Lock_Free_Stack {
+    _Atomic(Lock_Free_Node*) top;
+} Lock_Free_Stack;
+
+/**
+ * @struct Lock_Free_Queue
+ * @brief A lock-free multi-producer multi-consumer FIFO (Michael-Scott queue).
+ *
+ * The queue always holds a dummy node: `head` points to the dummy and the first
+ * value is in `head->next`. A dequeue makes the node holding the value the new
+ * dummy and retires the old one.
+ *
+ * Fields:
+ * - `head`:
+ *   The dummy node, values are dequeued from its successor.
+ *
+ * - `tail`:
+ *   The last node, or the one before it while an enqueue is half done. Any thread
+ *   seeing a lagging `tail` swings it forward before going on.
+ *
+ * Notes:
+ * - `head` and `tail` are kept on separate cache lines so that producers and
+ *   consumers do not invalidate each other's line.
+ */
+typedef struct Lock_Free_Queue {
+    _Alignas(64) _Atomic(Lock_Free_Node*) head;
+    _Alignas(64) _Atomic(Lock_Free_Node*) tail;
+} Lock_Free_Queue;
+
+/**
+ * @brief Initializes an empty stack.
+ */
+void lock_free_stack_init(Lock_Free_Stack* stack);
+
+/**
+ * @brief Frees every node left in the stack.
+ *
+ * Must only be called once no other thread uses the stack.
+ */
+void lock_free_stack_free(Lock_Free_Stack* stack);
+
+/**
+ * @brief Pushes `val` on top of the stack.
+ *
+ * Performance:
+ * - Lock-free: the compare-and-swap on `top` only fails when another thread
+ *   succeeded in between.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void lock_free_stack_push(Lock_Free_Stack* stack, int val);
+
+/**
+ * @brief Pops the top of the stack.
+ *
+ * @param popped_val
+ *        Where the popped value is written. Must not be `NULL`.
+ *
+ * @return `true` if a value was popped, `false` if the stack was empty.
+ */
+bool lock_free_stack_pop(Lock_Free_Stack* stack, int* popped_val);
+
+/**
+ * @brief Initializes an empty queue, allocating its dummy node.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void lock_free_queue_init(Lock_Free_Queue* queue);
+
+/**
+ * @brief Frees the dummy node and every node left in the queue.
+ *
+ * Must only be called once no other thread uses the queue.
+ */
+void lock_free_queue_free(Lock_Free_Queue* queue);
+
+/**
+ * @brief Appends `val` at the end of the queue.
+ *
+ * Performance:
+ * - Lock-free: a thread only retries when another enqueue linked a node first, and
+ *   helps that enqueue complete by swinging `tail`.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void lock_free_queue_enqueue(Lock_Free_Queue* queue, int val);
+
+/**
+ * @brief Removes the first value of the queue.
+ *
+ * @param dequeued_val
+ *        Where the dequeued value is written. Must not be `NULL`.
+ *
+ * @return `true` if a value was dequeued, `false` if the queue was empty.
+ */
+bool lock_free_queue_dequeue(Lock_Free_Queue* queue, int* dequeued_val);
+
+#endif  // LOCK_FREE_LIST_H
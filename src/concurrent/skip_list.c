@@ -0,0 +1,313 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+#include "skip_list.h"
+
+#define SKIP_LIST_MARK ((uintptr_t) 1)
+
+static inline bool is_marked(uintptr_t link) {
+    return (link & SKIP_LIST_MARK) != 0;
+}
+
+static inline Skip_List_Node* link_node(uintptr_t link) {
+    return (Skip_List_Node*) (link & ~SKIP_LIST_MARK);
+}
+
+static Skip_List_Node* skip_list_node_new(uint32_t key, uint32_t top_level) {
+    Skip_List_Node* node = (Skip_List_Node*) malloc(sizeof(Skip_List_Node) + top_level * sizeof(uintptr_t));
+    assert(node != NULL && "Unable to allocate more memory.");
+
+    node->key       = key;
+    node->top_level = top_level;
+    atomic_init(&node->pending, 2);
+    for (uint32_t level = 0; level < top_level; level += 1) {
+        atomic_init(&node->next[level], (uintptr_t) NULL);
+    }
+    return node;
+}
+
+static void skip_list_node_free(void* node) {
+    free(node);
+}
+
+// Called by the inserting and the deleting thread once each is done with `node`.
+static void skip_list_node_release(Skip_List_Node* node) {
+    if (atomic_fetch_sub(&node->pending, 1) == 1) {
+        epoch_retire(node, skip_list_node_free);
+    }
+}
+
+// Geometric level with p = 1/2, drawn from a per-thread generator.
+static uint32_t random_level(void) {
+    static _Thread_local uint32_t seed = 0;
+    if (seed == 0) {
+        seed = (uint32_t) (uintptr_t) &seed | 1;
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return (uint32_t) __builtin_ctz(seed | (1u << (SKIP_LIST_MAX_LEVEL - 1))) + 1;
+}
+
+// Fills `preds`/`succs` with, at every level, the last node with a key below `key` and
+// the node following it. Marked nodes met on the way are unlinked, so that once `find`
+// returns no node marked before the call is linked in front of `succs`.
+// Must be called inside an epoch critical section.
+static bool find(Skip_List* list, uint32_t key, Skip_List_Node** preds, Skip_List_Node** succs) {
+retry:;
+    Skip_List_Node* pred = list->head;
+    Skip_List_Node* curr = NULL;
+    for (int level = SKIP_LIST_MAX_LEVEL - 1; level >= 0; level -= 1) {
+        curr = link_node(atomic_load(&pred->next[level]));
+        while (curr != NULL) {
+            uintptr_t succ = atomic_load(&curr->next[level]);
+            while (is_marked(succ)) {
+                uintptr_t expected = (uintptr_t) curr;
+                if (!atomic_compare_exchange_strong(&pred->next[level], &expected, (uintptr_t) link_node(succ))) {
+                    // `pred` got marked or gained a new successor, start over.
+                    goto retry;
+                }
+                curr = link_node(succ);
+                if (curr == NULL) {
+                    break;
+                }
+                succ = atomic_load(&curr->next[level]);
+            }
+            if (curr == NULL || curr->key >= key) {
+                break;
+            }
+            pred = curr;
+            curr = link_node(succ);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return curr != NULL && curr->key == key;
+}
+
+void skip_list_init(Skip_List* list) {
+    assert(list != NULL && "Skip list is NULL.");
+
+    list->head = skip_list_node_new(0, SKIP_LIST_MAX_LEVEL);
+    atomic_init(&list->count, 0);
+}
+
+void skip_list_free(Skip_List* list) {
+    assert(list != NULL && "Skip list is NULL.");
+
+    Skip_List_Node* node = list->head;
+    while (node != NULL) {
+        Skip_List_Node* next = link_node(atomic_load_explicit(&node->next[0], memory_order_relaxed));
+        free(node);
+        node = next;
+    }
+    list->head = NULL;
+    atomic_store_explicit(&list->count, 0, memory_order_relaxed);
+}
+
+size_t skip_list_count(Skip_List* list) {
+    assert(list != NULL && "Skip list is NULL.");
+
+    return atomic_load_explicit(&list->count, memory_order_relaxed);
+}
+
+bool skip_list_insert(Skip_List* list, uint32_t key) {
+    assert(list != NULL && "Skip list is NULL.");
+
+    Skip_List_Node* preds[SKIP_LIST_MAX_LEVEL];
+    Skip_List_Node* succs[SKIP_LIST_MAX_LEVEL];
+    Skip_List_Node* node = NULL;
+
+    epoch_enter();
+    for (;;) {
+        if (find(list, key, preds, succs)) {
+            free(node);
+            epoch_exit();
+            return false;
+        }
+
+        if (node == NULL) {
+            node = skip_list_node_new(key, random_level());
+        }
+        for (uint32_t level = 0; level < node->top_level; level += 1) {
+            atomic_store_explicit(&node->next[level], (uintptr_t) succs[level], memory_order_relaxed);
+        }
+
+        // Linking level 0 is the linearization point of the insertion.
+        uintptr_t expected = (uintptr_t) succs[0];
+        if (atomic_compare_exchange_strong(&preds[0]->next[0], &expected, (uintptr_t) node)) {
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&list->count, 1, memory_order_relaxed);
+
+    for (uint32_t level = 1; level < node->top_level; level += 1) {
+        for (;;) {
+            uintptr_t next = atomic_load(&node->next[level]);
+            if (is_marked(next)) {
+                // Deleted meanwhile, leave the remaining levels unlinked.
+                goto linked;
+            }
+            if (link_node(next) != succs[level]) {
+                atomic_compare_exchange_strong(&node->next[level], &next, (uintptr_t) succs[level]);
+                continue;
+            }
+
+            uintptr_t expected = (uintptr_t) succs[level];
+            if (atomic_compare_exchange_strong(&preds[level]->next[level], &expected, (uintptr_t) node)) {
+                break;
+            }
+            if (!find(list, key, preds, succs) || succs[0] != node) {
+                goto linked;
+            }
+        }
+    }
+
+linked:
+    // A deletion may have unlinked the node before some of the links above were
+    // made, unlink them again.
+    if (is_marked(atomic_load(&node->next[0]))) {
+        find(list, key, preds, succs);
+    }
+    skip_list_node_release(node);
+    epoch_exit();
+    return true;
+}
+
+bool skip_list_contains(Skip_List* list, uint32_t key) {
+    assert(list != NULL && "Skip list is NULL.");
+
+    epoch_enter();
+    Skip_List_Node* pred = list->head;
+    Skip_List_Node* curr = NULL;
+    bool found = false;
+    for (int level = SKIP_LIST_MAX_LEVEL - 1; level >= 0; level -= 1) {
+        curr = link_node(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        while (curr != NULL) {
+            uintptr_t succ = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (is_marked(succ)) {
+                curr = link_node(succ);
+                continue;
+            }
+            if (curr->key >= key) {
+                found = curr->key == key;
+                break;
+            }
+            pred = curr;
+            curr = link_node(succ);
+        }
+        if (found) {
+            break;
+        }
+    }
+    epoch_exit();
+    return found;
+}
+
+bool skip_list_delete(Skip_List* list, uint32_t key) {
+    assert(list != NULL && "Skip list is NULL.");
+
+    Skip_List_Node* preds[SKIP_LIST_MAX_LEVEL];
+    Skip_List_Node* succs[SKIP_LIST_MAX_LEVEL];
+
+    epoch_enter();
+    if (!find(list, key, preds, succs)) {
+        epoch_exit();
+        return false;
+    }
+
+    Skip_List_Node* node = succs[0];
+    for (uint32_t level = node->top_level - 1; level > 0; level -= 1) {
+        atomic_fetch_or(&node->next[level], SKIP_LIST_MARK);
+    }
+
+    // Marking level 0 is the linearization point, only one deleting thread gets to do it.
+    if (is_marked(atomic_fetch_or(&node->next[0], SKIP_LIST_MARK))) {
+        epoch_exit();
+        return false;
+    }
+    atomic_fetch_sub_explicit(&list->count, 1, memory_order_relaxed);
+
+    find(list, key, preds, succs);
+    skip_list_node_release(node);
+    epoch_exit();
+    return true;
+}
+
+size_t skip_list_range(Skip_List* list, uint32_t lo, uint32_t hi, Skip_List_Visit_Fn visit, void* ctx) {
+    assert(list != NULL && "Skip list is NULL.");
+    assert(visit != NULL && "Visit function is NULL.");
+
+    size_t visited = 0;
+    epoch_enter();
+
+    // Descends to the last node with a key below `lo`, skipping deleted nodes.
+    Skip_List_Node* pred = list->head;
+    for (int level = SKIP_LIST_MAX_LEVEL - 1; level >= 0; level -= 1) {
+        Skip_List_Node* curr = link_node(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        while (curr != NULL) {
+            uintptr_t succ = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (!is_marked(succ)) {
+                if (curr->key >= lo) {
+                    break;
+                }
+                pred = curr;
+            }
+            curr = link_node(succ);
+        }
+    }
+
+    Skip_List_Node* curr = link_node(atomic_load_explicit(&pred->next[0], memory_order_acquire));
+    while (curr != NULL && curr->key <= hi) {
+        uintptr_t succ = atomic_load_explicit(&curr->next[0], memory_order_acquire);
+        if (!is_marked(succ) && curr->key >= lo) {
+            visited += 1;
+            if (!visit(curr->key, ctx)) {
+                break;
+            }
+        }
+        curr = link_node(succ);
+    }
+
+    epoch_exit();
+    return visited;
+}
+
+bool skip_list_validate(Skip_List* list) {
+    assert(list != NULL && "Skip list is NULL.");
+
+    size_t count = 0;
+    for (int level = 0; level < SKIP_LIST_MAX_LEVEL; level += 1) {
+        Skip_List_Node* prev = NULL;
+        uintptr_t link = atomic_load(&list->head->next[level]);
+        while (link_node(link) != NULL) {
+            Skip_List_Node* node = link_node(link);
+            link = atomic_load(&node->next[level]);
+            if (is_marked(link)) {
+                printf("skip list: deleted key %u still linked at level %d\n", node->key, level);
+                return false;
+            }
+            if ((uint32_t) level >= node->top_level) {
+                printf("skip list: key %u linked above its top level %u\n", node->key, node->top_level);
+                return false;
+            }
+            if (prev != NULL && prev->key >= node->key) {
+                printf("skip list: level %d out of order, %u before %u\n", level, prev->key, node->key);
+                return false;
+            }
+            if (level == 0) {
+                count += 1;
+            }
+            prev = node;
+        }
+    }
+
+    if (count != skip_list_count(list)) {
+        printf("skip list: count is %zu but level 0 holds %zu keys\n", skip_list_count(list), count);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,161 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SKIP_LIST_MAX_LEVEL 24
+
+/**
+ * @struct Skip_List_Node
+ * @brief A node of the lock-free skip list, allocated with `top_level` links.
+ *
+ * The lowest bit of a link marks the node holding it as deleted at that level. A
+ * node is logically deleted once its level 0 link is marked, and is then unlinked
+ * (snipped) from every level by whichever thread runs into it.
+ *
+ * Fields:
+ * - `key`:
+ *   The key of the node.
+ *
+ * - `top_level`:
+ *   The number of levels the node is linked in, between 1 and `SKIP_LIST_MAX_LEVEL`.
+ *
+ * - `pending`:
+ *   The number of threads still to be done with the node, the inserting one and the
+ *   deleting one. The last one retires the node once it can no longer be linked
+ *   anywhere.
+ *
+ * - `next`:
+ *   The successor of the node at each level, tagged with the deletion mark.
+ */
+typedef struct Skip_List_Node {
+    uint32_t          key;
+    uint32_t          top_level;
+    atomic_uint       pending;
+    _Atomic uintptr_t next[];
+} Skip_List_Node;
+
+/**
+ * @struct Skip_List
+ * @brief A lock-free ordered set of `uint32_t` keys for many concurrent readers and writers.
+ *
+ * Unlike `Rb_Node`, whose rebalancing touches several nodes at once, every update of
+ * a skip list is a sequence of single word compare-and-swaps on a level of links, so
+ * inserts, deletes and lookups of any number of threads run concurrently without
+ * locks. Each node is linked in a random number of levels (half of the nodes of a
+ * level are also in the next one) which gives expected O(log n) operations.
+ *
+ * Unlinked nodes are reclaimed through epochs (see `epoch.h`): every operation runs
+ * in an epoch critical section, so a node read by a thread is never freed under it.
+ *
+ * Fields:
+ * - `head`:
+ *   The sentinel node linked in every level, its key is never compared.
+ *
+ * - `count`:
+ *   The number of keys, exact once no operation is in progress.
+ *
+ * Example:
+ *
+ * ```c
+ * Skip_List set;
+ * skip_list_init(&set);
+ *
+ * // From any thread.
+ * skip_list_insert(&set, 42);
+ * if (skip_list_contains(&set, 42)) {
+ *     skip_list_delete(&set, 42);
+ * }
+ * epoch_thread_exit();
+ *
+ * // Once every thread is done.
+ * skip_list_free(&set);
+ * epoch_drain();
+ * ```
+ */
+typedef struct Skip_List {
+    Skip_List_Node* head;
+    atomic_size_t   count;
+} Skip_List;
+
+// Called on every key of a range scan in increasing order, returning `false` stops the scan.
+typedef bool (*Skip_List_Visit_Fn)(uint32_t key, void* ctx);
+
+/**
+ * @brief Initializes an empty set, allocating its head sentinel.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void skip_list_init(Skip_List* list);
+
+/**
+ * @brief Frees every node of the set. Must only be called once no other thread uses it.
+ *
+ * Nodes already retired are freed by `epoch_drain`.
+ */
+void skip_list_free(Skip_List* list);
+
+/**
+ * @brief Returns the number of keys in the set.
+ */
+size_t skip_list_count(Skip_List* list);
+
+/**
+ * @brief Adds `key` to the set.
+ *
+ * @return `true` if the key was added, `false` if it was already in the set.
+ *
+ * Performance:
+ * - Time complexity: expected O(log n). The key is visible to other threads as soon
+ *   as it is linked at level 0, upper levels are linked afterwards.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+bool skip_list_insert(Skip_List* list, uint32_t key);
+
+/**
+ * @brief Tells whether `key` is in the set.
+ *
+ * Performance:
+ * - Time complexity: expected O(log n). Lookups never write to shared memory, deleted
+ *   nodes met on the way are skipped rather than unlinked.
+ */
+bool skip_list_contains(Skip_List* list, uint32_t key);
+
+/**
+ * @brief Removes `key` from the set.
+ *
+ * @return `true` if the key was removed by this call, `false` if it was not in the set.
+ *
+ * Performance:
+ * - Time complexity: expected O(log n).
+ */
+bool skip_list_delete(Skip_List* list, uint32_t key);
+
+/**
+ * @brief Calls `visit` on the keys of the set within `[lo, hi]`, in increasing order.
+ *
+ * The scan is weakly consistent: keys inserted or deleted concurrently may or may
+ * not be visited, every other key of the range is visited exactly once.
+ *
+ * @return The number of visited keys.
+ *
+ * Performance:
+ * - Time complexity: expected O(log n + k), where `k` is the number of visited keys.
+ */
+size_t skip_list_range(Skip_List* list, uint32_t lo, uint32_t hi, Skip_List_Visit_Fn visit, void* ctx);
+
+/**
+ * @brief Checks the structure of the set: every level sorted, no deleted node left and
+ *        `count` matching level 0. Must only be called once no other thread uses it.
+ *
+ * @return `true` if the set is valid, otherwise prints the first violation and returns `false`.
+ */
+bool skip_list_validate(Skip_List* list);
+
+#endif  // SKIP_LIST_H
@@ -0,0 +1,127 @@
+#include <string.h>
+#include <time.h>
+
+#include "instrument.h"
+
+#define INSTRUMENT_OP_NAME(suffix, name) name,
+static const char* const op_names[INSTRUMENT_OP_COUNT] = {
+    INSTRUMENT_OPS(INSTRUMENT_OP_NAME)
+};
+#undef INSTRUMENT_OP_NAME
+
+static Instrument_Op_Stats op_stats[INSTRUMENT_OP_COUNT];
+
+#if defined(DS_INSTRUMENT)
+
+Instrument_Op_Stats* instrument_current = &op_stats[INSTRUMENT_OP_OTHER];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+Instrument_Scope instrument_scope_begin(Instrument_Op op) {
+    Instrument_Scope scope = { .stats = NULL, .start_ns = 0, .start_visits = 0 };
+    // Nested calls count into the outermost one.
+    if (instrument_current != &op_stats[INSTRUMENT_OP_OTHER]) {
+        return scope;
+    }
+
+    scope.stats        = &op_stats[op];
+    scope.start_visits = scope.stats->node_visits;
+    scope.stats->calls += 1;
+    instrument_current = scope.stats;
+    scope.start_ns     = now_ns();
+    return scope;
+}
+
+void instrument_scope_end(Instrument_Scope* scope) {
+    if (scope->stats == NULL) {
+        return;
+    }
+
+    uint64_t elapsed_ns = now_ns() - scope->start_ns;
+    uint32_t bucket = elapsed_ns == 0 ? 0 : 64 - (uint32_t) __builtin_clzll(elapsed_ns);
+    if (bucket >= INSTRUMENT_HISTOGRAM_BUCKETS) {
+        bucket = INSTRUMENT_HISTOGRAM_BUCKETS - 1;
+    }
+    scope->stats->latency_histogram[bucket] += 1;
+
+    uint64_t visits = scope->stats->node_visits - scope->start_visits;
+    if (visits > scope->stats->max_visits) {
+        scope->stats->max_visits = visits;
+    }
+    instrument_current = &op_stats[INSTRUMENT_OP_OTHER];
+}
+
+bool instrument_enabled(void) {
+    return true;
+}
+
+#else
+
+bool instrument_enabled(void) {
+    return false;
+}
+
+#endif  // DS_INSTRUMENT
+
+const char* instrument_op_name(Instrument_Op op) {
+    return op < INSTRUMENT_OP_COUNT ? op_names[op] : "unknown";
+}
+
+const Instrument_Op_Stats* instrument_stats(Instrument_Op op) {
+    return &op_stats[op < INSTRUMENT_OP_COUNT ? op : INSTRUMENT_OP_OTHER];
+}
+
+uint64_t instrument_latency_percentile(Instrument_Op op, double percentile) {
+    const Instrument_Op_Stats* stats = instrument_stats(op);
+    if (stats->calls == 0) {
+        return 0;
+    }
+
+    // The rank of the call in latency order, rounded up so that p100 is the slowest one.
+    double rank = percentile / 100.0 * (double) stats->calls;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < INSTRUMENT_HISTOGRAM_BUCKETS; i += 1) {
+        seen += stats->latency_histogram[i];
+        if ((double) seen >= rank && seen > 0) {
+            return 1ull << i;
+        }
+    }
+    return 1ull << (INSTRUMENT_HISTOGRAM_BUCKETS - 1);
+}
+
+void instrument_reset(void) {
+    memset(op_stats, 0, sizeof(op_stats));
+}
+
+void instrument_dump_json(FILE* out) {
+    fprintf(out, "{\n  \"enabled\": %s,\n  \"ops\": [", instrument_enabled() ? "true" : "false");
+    bool first = true;
+    for (uint32_t op = 0; op < INSTRUMENT_OP_COUNT; op += 1) {
+        const Instrument_Op_Stats* stats = &op_stats[op];
+        bool used = stats->calls > 0 || stats->node_visits > 0 || stats->allocs > 0 || stats->frees > 0;
+        if (!used) {
+            continue;
+        }
+
+        fprintf(out, "%s\n    {\"op\": \"%s\", \"calls\": %llu, \"node_visits\": %llu, \"max_visits\": %llu, "
+                "\"allocs\": %llu, \"frees\": %llu, \"rotations\": %llu, \"recolors\": %llu, ",
+                first ? "" : ",", op_names[op],
+                (unsigned long long) stats->calls, (unsigned long long) stats->node_visits,
+                (unsigned long long) stats->max_visits, (unsigned long long) stats->allocs,
+                (unsigned long long) stats->frees, (unsigned long long) stats->rotations,
+                (unsigned long long) stats->recolors);
+        fprintf(out, "\"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"histogram\": [",
+                (unsigned long long) instrument_latency_percentile((Instrument_Op) op, 50.0),
+                (unsigned long long) instrument_latency_percentile((Instrument_Op) op, 99.0));
+        for (uint32_t i = 0; i < INSTRUMENT_HISTOGRAM_BUCKETS; i += 1) {
+            fprintf(out, "%s%llu", i == 0 ? "" : ", ", (unsigned long long) stats->latency_histogram[i]);
+        }
+        fprintf(out, "]}}");
+        first = false;
+    }
+    fprintf(out, "%s]\n}\n", first ? "" : "\n  ");
+}
@@ -0,0 +1,147 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Hot path instrumentation of the lists and the red-black tree, compiled out unless
+ * `DS_INSTRUMENT` is defined (`make CFLAGS_OPT=-DDS_INSTRUMENT`).
+ *
+ * Every instrumented procedure opens a scope with `INSTRUMENT_SCOPE`, which counts
+ * the call and records its latency in a histogram with power of two buckets. Inside
+ * the scope, the procedure counts the nodes it walks, the nodes it allocates and
+ * frees, and for the tree the rotations and recolors. Counts go to the outermost
+ * instrumented call: `rb_node_delete` looking its key up with `rb_node_find` counts
+ * one delete, whose visits include the lookup. Counts made outside any scope go to
+ * `INSTRUMENT_OP_OTHER`.
+ *
+ * Without `DS_INSTRUMENT` every macro expands to nothing, the instrumented code is
+ * exactly the uninstrumented one, and the stats procedures report empty stats.
+ *
+ * Notes:
+ * - The stats are process wide and not thread safe, like the structures they count.
+ * - A scope relies on the `cleanup` attribute of GCC and Clang to close on every return.
+ */
+
+#define INSTRUMENT_HISTOGRAM_BUCKETS 40
+
+// X(enumerator suffix, procedure name)
+#define INSTRUMENT_OPS(X)                                              \
+    X(OTHER,                        "other")                           \
+    X(SINGLY_LINKED_LIST_APPEND,    "singly_linked_list_append")       \
+    X(SINGLY_LINKED_LIST_INSERT,    "singly_linked_list_insert")       \
+    X(SINGLY_LINKED_LIST_REMOVE,    "singly_linked_list_remove")       \
+    X(SINGLY_LINKED_LIST_LOOKUP,    "singly_linked_list_lookup")       \
+    X(SINGLY_LIST_APPEND,           "singly_list_append")              \
+    X(SINGLY_LIST_INSERT,           "singly_list_insert")              \
+    X(SINGLY_LIST_REMOVE,           "singly_list_remove")              \
+    X(SINGLY_LIST_LOOKUP,           "singly_list_lookup")              \
+    X(SINGLY_LIST_GET,              "singly_list_get")                 \
+    X(SINGLY_LIST_SET,              "singly_list_set")                 \
+    X(DOUBLY_LINKED_LIST_INSERT,    "doubly_linked_list_insert")       \
+    X(DOUBLY_LINKED_LIST_REMOVE,    "doubly_linked_list_remove")       \
+    X(DOUBLY_LINKED_LIST_SEARCH,    "doubly_linked_list_search")       \
+    X(DOUBLY_LINKED_LIST_GET,       "doubly_linked_list_get")          \
+    X(DOUBLY_LINKED_LIST_SET,       "doubly_linked_list_set")          \
+    X(DOUBLY_LIST_INSERT,           "doubly_list_insert")              \
+    X(DOUBLY_LIST_REMOVE,           "doubly_list_remove")              \
+    X(DOUBLY_LIST_SEARCH,           "doubly_list_search")              \
+    X(DOUBLY_LIST_GET,              "doubly_list_get")                 \
+    X(DOUBLY_LIST_SET,              "doubly_list_set")                 \
+    X(RB_NODE_INSERT,               "rb_node_insert")                  \
+    X(RB_NODE_DELETE,               "rb_node_delete")                  \
+    X(RB_NODE_FIND,                 "rb_node_find")                    \
+    X(RB_NODE_LOWER_BOUND,          "rb_node_lower_bound")             \
+    X(RB_NODE_UPPER_BOUND,          "rb_node_upper_bound")
+
+#define INSTRUMENT_OP_ENUMERATOR(suffix, name) INSTRUMENT_OP_##suffix,
+typedef enum Instrument_Op {
+    INSTRUMENT_OPS(INSTRUMENT_OP_ENUMERATOR)
+    INSTRUMENT_OP_COUNT
+} Instrument_Op;
+#undef INSTRUMENT_OP_ENUMERATOR
+
+/**
+ * @struct Instrument_Op_Stats
+ * @brief The counters of one instrumented procedure, pooled and unpooled variants together.
+ *
+ * Fields:
+ * - `calls`:
+ *   The number of calls.
+ *
+ * - `node_visits`:
+ *   The number of nodes walked over, over all the calls.
+ *
+ * - `max_visits`:
+ *   The most nodes walked by a single call, for the tree the deepest level reached.
+ *
+ * - `allocs` / `frees`:
+ *   The number of nodes allocated and freed, from the heap or from a pool.
+ *
+ * - `rotations` / `recolors`:
+ *   The number of tree rotations and node color changes of the rebalancing.
+ *
+ * - `latency_histogram`:
+ *   `latency_histogram[i]` counts the calls that took less than `2^i` nanoseconds
+ *   and at least `2^(i-1)`, the last bucket counts every longer call.
+ */
+typedef struct Instrument_Op_Stats {
+    uint64_t calls;
+    uint64_t node_visits;
+    uint64_t max_visits;
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t rotations;
+    uint64_t recolors;
+    uint64_t latency_histogram[INSTRUMENT_HISTOGRAM_BUCKETS];
+} Instrument_Op_Stats;
+
+// Whether the instrumentation was compiled in.
+bool instrument_enabled(void);
+const char* instrument_op_name(Instrument_Op op);
+// Counters of `op`, all zero when the instrumentation is compiled out.
+const Instrument_Op_Stats* instrument_stats(Instrument_Op op);
+// Upper bound in nanoseconds of the latency of the `percentile` (0 to 100) slowest
+// call of `op`, at the resolution of the histogram. 0 when `op` was never called.
+uint64_t instrument_latency_percentile(Instrument_Op op, double percentile);
+void instrument_reset(void);
+// Writes every counter of the procedures called at least once as a JSON object.
+void instrument_dump_json(FILE* out);
+
+#if defined(DS_INSTRUMENT)
+
+typedef struct Instrument_Scope {
+    Instrument_Op_Stats* stats;
+    uint64_t             start_ns;
+    uint64_t             start_visits;
+} Instrument_Scope;
+
+// The counters the running scope counts into, `INSTRUMENT_OP_OTHER` outside any scope.
+extern Instrument_Op_Stats* instrument_current;
+
+Instrument_Scope instrument_scope_begin(Instrument_Op op);
+void instrument_scope_end(Instrument_Scope* scope);
+
+#define INSTRUMENT_SCOPE(op)                                                                 \
+    Instrument_Scope instrument_scope __attribute__((cleanup(instrument_scope_end))) =      \
+        instrument_scope_begin(INSTRUMENT_OP_##op)
+#define INSTRUMENT_VISIT()       (instrument_current->node_visits += 1)
+#define INSTRUMENT_ALLOC()       (instrument_current->allocs += 1)
+#define INSTRUMENT_FREE()        (instrument_current->frees += 1)
+#define INSTRUMENT_ROTATION()    (instrument_current->rotations += 1)
+#define INSTRUMENT_RECOLORS(n)   (instrument_current->recolors += (n))
+
+#else
+
+#define INSTRUMENT_SCOPE(op)     ((void) 0)
+#define INSTRUMENT_VISIT()       ((void) 0)
+#define INSTRUMENT_ALLOC()       ((void) 0)
+#define INSTRUMENT_FREE()        ((void) 0)
+#define INSTRUMENT_ROTATION()    ((void) 0)
+#define INSTRUMENT_RECOLORS(n)   ((void) 0)
+
+#endif  // DS_INSTRUMENT
+
+#endif  // INSTRUMENT_H
@@ -0,0 +1,126 @@
+#include "intrusive_list.h"
+
+void intrusive_list_init(Intrusive_List* list) {
+    assert(list != NULL && "Intrusive List is NULL.");
+
+    list->sentinel.prev = &list->sentinel;
+    list->sentinel.next = &list->sentinel;
+    list->count         = 0;
+}
+
+void intrusive_list_link_init(Intrusive_List_Link* link) {
+    assert(link != NULL && "Intrusive List link is NULL.");
+
+    link->prev = NULL;
+    link->next = NULL;
+}
+
+bool intrusive_list_link_is_linked(Intrusive_List_Link* link) {
+    assert(link != NULL && "Intrusive List link is NULL.");
+
+    return link->next != NULL;
+}
+
+bool intrusive_list_is_empty(Intrusive_List* list) {
+    assert(list != NULL && "Intrusive List is NULL.");
+
+    return list->sentinel.next == &list->sentinel;
+}
+
+size_t intrusive_list_count(Intrusive_List* list) {
+    assert(list != NULL && "Intrusive List is NULL.");
+
+    return list->count;
+}
+
+Intrusive_List_Link* intrusive_list_first(Intrusive_List* list) {
+    assert(list != NULL && "Intrusive List is NULL.");
+
+    return list->sentinel.next != &list->sentinel ? list->sentinel.next : NULL;
+}
+
+Intrusive_List_Link* intrusive_list_last(Intrusive_List* list) {
+    assert(list != NULL && "Intrusive List is NULL.");
+
+    return list->sentinel.prev != &list->sentinel ? list->sentinel.prev : NULL;
+}
+
+Intrusive_List_Link* intrusive_list_next(Intrusive_List* list, Intrusive_List_Link* link) {
+    assert(list != NULL && "Intrusive List is NULL.");
+    assert(link != NULL && "Intrusive List link is NULL.");
+
+    return link->next != &list->sentinel ? link->next : NULL;
+}
+
+Intrusive_List_Link* intrusive_list_prev(Intrusive_List* list, Intrusive_List_Link* link) {
+    assert(list != NULL && "Intrusive List is NULL.");
+    assert(link != NULL && "Intrusive List link is NULL.");
+
+    return link->prev != &list->sentinel ? link->prev : NULL;
+}
+
+// Links `link` between two adjacent links `prev` and `next`.
+static void link_between(Intrusive_List* list, Intrusive_List_Link* prev, Intrusive_List_Link* next, Intrusive_List_Link* link) {
+    assert(link != NULL && "Intrusive List link is NULL.");
+    assert(link->next == NULL && "Intrusive List link is already linked.");
+
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+    list->count += 1;
+}
+
+void intrusive_list_insert_before(Intrusive_List* list, Intrusive_List_Link* position, Intrusive_List_Link* link) {
+    assert(list != NULL && "Intrusive List is NULL.");
+    assert(position != NULL && "Intrusive List position is NULL.");
+
+    link_between(list, position->prev, position, link);
+}
+
+void intrusive_list_insert_after(Intrusive_List* list, Intrusive_List_Link* position, Intrusive_List_Link* link) {
+    assert(list != NULL && "Intrusive List is NULL.");
+    assert(position != NULL && "Intrusive List position is NULL.");
+
+    link_between(list, position, position->next, link);
+}
+
+void intrusive_list_unlink(Intrusive_List* list, Intrusive_List_Link* link) {
+    assert(list != NULL && "Intrusive List is NULL.");
+    assert(link != NULL && "Intrusive List link is NULL.");
+    assert(link->next != NULL && link != &list->sentinel && "Intrusive List link is not linked.");
+
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = NULL;
+    link->next = NULL;
+    list->count -= 1;
+}
+
+void intrusive_list_push_head(Intrusive_List* list, Intrusive_List_Link* link) {
+    assert(list != NULL && "Intrusive List is NULL.");
+
+    link_between(list, &list->sentinel, list->sentinel.next, link);
+}
+
+void intrusive_list_push_tail(Intrusive_List* list, Intrusive_List_Link* link) {
+    assert(list != NULL && "Intrusive List is NULL.");
+
+    link_between(list, list->sentinel.prev, &list->sentinel, link);
+}
+
+Intrusive_List_Link* intrusive_list_pop_head(Intrusive_List* list) {
+    Intrusive_List_Link* link = intrusive_list_first(list);
+    if (link != NULL) {
+        intrusive_list_unlink(list, link);
+    }
+    return link;
+}
+
+Intrusive_List_Link* intrusive_list_pop_tail(Intrusive_List* list) {
+    Intrusive_List_Link* link = intrusive_list_last(list);
+    if (link != NULL) {
+        intrusive_list_unlink(list, link);
+    }
+    return link;
+}
@@ -0,0 +1,201 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Retrieves the object embedding a link from a pointer to that link.
+ *
+ * @param link_ptr
+ *        A pointer to the `Intrusive_List_Link` member of the object.
+ *
+ * @param type
+ *        The type of the object embedding the link.
+ *
+ * @param member
+ *        The name of the link member within `type`.
+ */
+#define INTRUSIVE_LIST_CONTAINER_OF(link_ptr, type, member) \
+    ((type*) ((char*) (link_ptr) - offsetof(type, member)))
+
+/**
+ * @struct Intrusive_List_Link
+ * @brief The links of an intrusive doubly linked list, to embed in the listed objects.
+ *
+ * `Doubly_Linked_List_Node` owns an `int` and is allocated by the list procedures.
+ * An intrusive list works the other way around: the objects to list embed an
+ * `Intrusive_List_Link` member, and the list only links those members together.
+ * No procedure of the intrusive list allocates, and reaching an object from a link
+ * is a pointer subtraction (`INTRUSIVE_LIST_CONTAINER_OF`) instead of a pointer hop.
+ *
+ * Fields:
+ * - `prev`, `next`:
+ *   The neighbouring links, both `NULL` while the link is not in a list.
+ *
+ * Example:
+ *
+ * ```c
+ * typedef struct Request {
+ *     int                 id;
+ *     Intrusive_List_Link link;
+ * } Request;
+ *
+ * Intrusive_List pending;
+ * intrusive_list_init(&pending);
+ *
+ * Request a = { .id = 1 };
+ * Request b = { .id = 2 };
+ * intrusive_list_push_tail(&pending, &a.link);
+ * intrusive_list_push_tail(&pending, &b.link);
+ *
+ * Intrusive_List_Link* link = intrusive_list_pop_head(&pending);
+ * Request* next_request = INTRUSIVE_LIST_CONTAINER_OF(link, Request, link);
+ * printf("%d\n", next_request->id); // Output: 1
+ * ```
+ *
+ * Notes:
+ * - A link can be in a single list at a time. Objects listed in several lists at
+ *   once embed one link per list.
+ * - The list never frees the objects, their lifetime is managed by the caller.
+ */
+typedef struct Intrusive_List_Link {
+    struct Intrusive_List_Link* prev;
+    struct Intrusive_List_Link* next;
+} Intrusive_List_Link;
+
+/**
+ * @struct Intrusive_List
+ * @brief An intrusive doubly linked list.
+ *
+ * The list is circular around the `sentinel` link: the first link follows the
+ * sentinel and the last link precedes it, so that inserting or unlinking never has
+ * to special case the ends of the list.
+ *
+ * Fields:
+ * - `sentinel`:
+ *   The link standing for both ends of the list, not part of any object.
+ *
+ * - `count`:
+ *   The number of links in the list.
+ *
+ * Notes:
+ * - The sentinel points into the list structure itself, an initialized list must
+ *   not be copied or moved.
+ */
+typedef struct Intrusive_List {
+    Intrusive_List_Link sentinel;
+    size_t              count;
+} Intrusive_List;
+
+/**
+ * @brief Initializes an empty list.
+ */
+void intrusive_list_init(Intrusive_List* list);
+
+/**
+ * @brief Initializes a link as not being in any list.
+ */
+void intrusive_list_link_init(Intrusive_List_Link* link);
+
+/**
+ * @brief Tells whether a link is currently in a list.
+ */
+bool intrusive_list_link_is_linked(Intrusive_List_Link* link);
+
+/**
+ * @brief Tells whether the list holds no link.
+ */
+bool intrusive_list_is_empty(Intrusive_List* list);
+
+/**
+ * @brief Returns the number of links in the list.
+ */
+size_t intrusive_list_count(Intrusive_List* list);
+
+/**
+ * @brief Returns the first link of the list, `NULL` when the list is empty.
+ */
+Intrusive_List_Link* intrusive_list_first(Intrusive_List* list);
+
+/**
+ * @brief Returns the last link of the list, `NULL` when the list is empty.
+ */
+Intrusive_List_Link* intrusive_list_last(Intrusive_List* list);
+
+/**
+ * @brief Returns the link following `link`, `NULL` when `link` is the last one.
+ */
+Intrusive_List_Link* intrusive_list_next(Intrusive_List* list, Intrusive_List_Link* link);
+
+/**
+ * @brief Returns the link preceding `link`, `NULL` when `link` is the first one.
+ */
+Intrusive_List_Link* intrusive_list_prev(Intrusive_List* list, Intrusive_List_Link* link);
+
+/**
+ * @brief Links `link` right before `position`, which must be in `list`.
+ *
+ * Potential Errors:
+ * - The function asserts that `link` is not already in a list.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+void intrusive_list_insert_before(Intrusive_List* list, Intrusive_List_Link* position, Intrusive_List_Link* link);
+
+/**
+ * @brief Links `link` right after `position`, which must be in `list`.
+ *
+ * Potential Errors:
+ * - The function asserts that `link` is not already in a list.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+void intrusive_list_insert_after(Intrusive_List* list, Intrusive_List_Link* position, Intrusive_List_Link* link);
+
+/**
+ * @brief Removes `link`, which must be in `list`, from the list.
+ *
+ * The link is reset to the not linked state and can be inserted again.
+ *
+ * Performance:
+ * - Time complexity: O(1), no traversal is needed to find the neighbours.
+ */
+void intrusive_list_unlink(Intrusive_List* list, Intrusive_List_Link* link);
+
+/**
+ * @brief Links `link` in front of the list.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+void intrusive_list_push_head(Intrusive_List* list, Intrusive_List_Link* link);
+
+/**
+ * @brief Links `link` at the end of the list.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+void intrusive_list_push_tail(Intrusive_List* list, Intrusive_List_Link* link);
+
+/**
+ * @brief Unlinks and returns the first link of the list, `NULL` when the list is empty.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+Intrusive_List_Link* intrusive_list_pop_head(Intrusive_List* list);
+
+/**
+ * @brief Unlinks and returns the last link of the list, `NULL` when the list is empty.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+Intrusive_List_Link* intrusive_list_pop_tail(Intrusive_List* list);
+
+#endif
@@ -1,7 +1,65 @@
 #include "linkedlist.h"
+#include "instrument.h"
+#include "persist/export.h"
+
+#define PRINT_BUFFER_SIZE 4096
+
+// Hands a formatted chunk to `stdout`. A failed write is left in the error indicator
+// of the stream, like the one of a failed `printf`.
+static bool print_chunk(const void* chunk, size_t size, void* ctx) {
+    return fwrite(chunk, 1, size, (FILE*) ctx) == size;
+}
+
+// The print procedures format through an export writer rather than with one `printf`
+// per node, and write it to `stdout` a buffer at a time, through stdio like the rest
+// of the output.
+static void print_open(Export_Writer* writer, unsigned char* buffer) {
+    export_writer_init_buffer(writer, buffer, PRINT_BUFFER_SIZE, EXPORT_TEXT_ARROWS, print_chunk, stdout);
+}
+
+// Nodes come from `pool` when one is given, from the heap otherwise.
+static Singly_Linked_List_Node* singly_node_alloc(Node_Pool* pool) {
+    Singly_Linked_List_Node* node = pool != NULL
+        ? (Singly_Linked_List_Node*) node_pool_alloc(pool)
+        : (Singly_Linked_List_Node*) malloc(sizeof(Singly_Linked_List_Node));
+    assert(node != NULL && "Unable to allocate more memory.");
+    INSTRUMENT_ALLOC();
+    return node;
+}
+
+static void singly_node_release(Node_Pool* pool, Singly_Linked_List_Node* node) {
+    INSTRUMENT_FREE();
+    if (pool != NULL) {
+        node_pool_release(pool, node);
+    } else {
+        free(node);
+    }
+}
+
+static Doubly_Linked_List_Node* doubly_node_alloc(Node_Pool* pool) {
+    Doubly_Linked_List_Node* node = pool != NULL
+        ? (Doubly_Linked_List_Node*) node_pool_alloc(pool)
+        : (Doubly_Linked_List_Node*) malloc(sizeof(Doubly_Linked_List_Node));
+    assert(node != NULL && "Unable to allocate more memory.");
+    INSTRUMENT_ALLOC();
+    return node;
+}
+
+static void doubly_node_release(Node_Pool* pool, Doubly_Linked_List_Node* node) {
+    INSTRUMENT_FREE();
+    if (pool != NULL) {
+        node_pool_release(pool, node);
+    } else {
+        free(node);
+    }
+}
 
 Singly_Linked_List_Node* singly_linked_list_new(int head_val) {
-    Singly_Linked_List_Node* linked_list_head = (Singly_Linked_List_Node*) malloc(sizeof(Singly_Linked_List_Node));
+    return singly_linked_list_new_pooled(NULL, head_val);
+}
+
+Singly_Linked_List_Node* singly_linked_list_new_pooled(Node_Pool* pool, int head_val) {
+    Singly_Linked_List_Node* linked_list_head = singly_node_alloc(pool);
     linked_list_head->val              = head_val;
     linked_list_head->next             = NULL;
     return linked_list_head;
@@ -21,23 +79,28 @@ size_t singly_linked_list_len(Singly_Linked_List_Node* linked_list_head) {
 }
 
 void singly_linked_list_print(Singly_Linked_List_Node* linked_list_head) {
-    Singly_Linked_List_Node* curr_node = linked_list_head;
-    for (;curr_node != NULL;) {
-        if (curr_node != linked_list_head) {
-            printf(" -> %d", curr_node->val);
-        } else {
-            printf(" %d", curr_node->val);
-        }
-
-        curr_node = curr_node->next;
+    if (linked_list_head == NULL) {
+        return;
     }
+
+    unsigned char buffer[PRINT_BUFFER_SIZE];
+    Export_Writer writer;
+    print_open(&writer, buffer);
+    export_bytes(&writer, " ", 1);
+    export_singly_linked_list(&writer, linked_list_head);
+    export_writer_finish(&writer);
 }
 
 void singly_linked_list_append(Singly_Linked_List_Node* linked_list_head, int val) {
+    singly_linked_list_append_pooled(NULL, linked_list_head, val);
+}
+
+void singly_linked_list_append_pooled(Node_Pool* pool, Singly_Linked_List_Node* linked_list_head, int val) {
+    INSTRUMENT_SCOPE(SINGLY_LINKED_LIST_APPEND);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     if (linked_list_head->next == NULL) {
-        Singly_Linked_List_Node* new_node = (Singly_Linked_List_Node*) malloc(sizeof(Singly_Linked_List_Node));
+        Singly_Linked_List_Node* new_node = singly_node_alloc(pool);
         new_node->val              = val;
         new_node->next             = NULL;
         linked_list_head->next     = new_node;
@@ -46,11 +109,12 @@ void singly_linked_list_append(Singly_Linked_List_Node* linked_list_head, int va
 
     Singly_Linked_List_Node* last_node = linked_list_head->next;
     for (;last_node->next != NULL;) {
+        INSTRUMENT_VISIT();
         last_node = last_node->next;
     }
 
     if (last_node->next == NULL) {
-        Singly_Linked_List_Node* new_node = (Singly_Linked_List_Node*) malloc(sizeof(Singly_Linked_List_Node));
+        Singly_Linked_List_Node* new_node = singly_node_alloc(pool);
         new_node->val              = val;
         new_node->next             = NULL;
         last_node->next            = new_node;
@@ -59,11 +123,15 @@ void singly_linked_list_append(Singly_Linked_List_Node* linked_list_head, int va
 }
 
 void singly_linked_list_insert(Singly_Linked_List_Node* linked_list_head, size_t idx, int val) {
+    singly_linked_list_insert_pooled(NULL, linked_list_head, idx, val);
+}
+
+void singly_linked_list_insert_pooled(Node_Pool* pool, Singly_Linked_List_Node* linked_list_head, size_t idx, int val) {
+    INSTRUMENT_SCOPE(SINGLY_LINKED_LIST_INSERT);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     if (idx == 0) {
-        Singly_Linked_List_Node* prev_head_node = (Singly_Linked_List_Node*) malloc(sizeof(Singly_Linked_List_Node));
-        assert(prev_head_node != NULL && "Unable to allocate more memory.");
+        Singly_Linked_List_Node* prev_head_node = singly_node_alloc(pool);
         prev_head_node->val  = linked_list_head->val;
         prev_head_node->next = linked_list_head->next;
 
@@ -81,8 +149,7 @@ void singly_linked_list_insert(Singly_Linked_List_Node* linked_list_head, size_t
         }
 
         if (i == idx) {
-            Singly_Linked_List_Node* new_node = (Singly_Linked_List_Node*) malloc(sizeof(Singly_Linked_List_Node));
-            assert(new_node != NULL && "Unable to allocate more memory.");
+            Singly_Linked_List_Node* new_node = singly_node_alloc(pool);
             new_node->val              = val;
             new_node->next             = NULL;
             prev_node->next            = new_node;
@@ -93,6 +160,7 @@ void singly_linked_list_insert(Singly_Linked_List_Node* linked_list_head, size_t
             return;
         }
 
+        INSTRUMENT_VISIT();
         i += 1;
         prev_node = curr_node;
         if (curr_node != NULL) {
@@ -102,6 +170,11 @@ void singly_linked_list_insert(Singly_Linked_List_Node* linked_list_head, size_t
 }
 
 bool singly_linked_list_remove(Singly_Linked_List_Node* linked_list_head, size_t idx, int* removed_val) {
+    return singly_linked_list_remove_pooled(NULL, linked_list_head, idx, removed_val);
+}
+
+bool singly_linked_list_remove_pooled(Node_Pool* pool, Singly_Linked_List_Node* linked_list_head, size_t idx, int* removed_val) {
+    INSTRUMENT_SCOPE(SINGLY_LINKED_LIST_REMOVE);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     if (idx == 0) {
@@ -110,9 +183,9 @@ bool singly_linked_list_remove(Singly_Linked_List_Node* linked_list_head, size_t
             Singly_Linked_List_Node* to_free = linked_list_head->next;
             linked_list_head->val  = to_free->val;
             linked_list_head->next = to_free->next;
-            free(to_free);
+            singly_node_release(pool, to_free);
         } else {
-            free(linked_list_head);
+            singly_node_release(pool, linked_list_head);
         }
         return true;
     }
@@ -128,10 +201,11 @@ bool singly_linked_list_remove(Singly_Linked_List_Node* linked_list_head, size_t
         if (i == idx) {
             prev_node->next = curr_node->next;
             *removed_val = curr_node->val;
-            free(curr_node);
+            singly_node_release(pool, curr_node);
             return true;
         }
 
+        INSTRUMENT_VISIT();
         i += 1;
         prev_node = curr_node;
         if (curr_node != NULL) {
@@ -143,6 +217,7 @@ bool singly_linked_list_remove(Singly_Linked_List_Node* linked_list_head, size_t
 }
 
 bool singly_linked_list_lookup(Singly_Linked_List_Node* linked_list_head, int needle_val, size_t* found_idx) {
+    INSTRUMENT_SCOPE(SINGLY_LINKED_LIST_LOOKUP);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     size_t idx = 0;
@@ -153,6 +228,7 @@ bool singly_linked_list_lookup(Singly_Linked_List_Node* linked_list_head, int ne
             return true;
         }
 
+        INSTRUMENT_VISIT();
         curr_node = curr_node->next;
         idx += 1;
     }
@@ -167,15 +243,273 @@ void singly_linked_list_free(Singly_Linked_List_Node* linked_list_head) {
     Singly_Linked_List_Node* next    = linked_list_head->next;
     free(to_free);
 
-    for (;next->next != NULL;) {
+    for (;next != NULL;) {
         to_free = next;
         next = next->next;
         free(to_free);
     }
 }
 
+void singly_list_init(Singly_List* list) {
+    singly_list_init_pooled(list, NULL);
+}
+
+void singly_list_init_pooled(Singly_List* list, Node_Pool* pool) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    list->head       = NULL;
+    list->tail       = NULL;
+    list->len        = 0;
+    list->pool       = pool;
+    list->finger     = NULL;
+    list->finger_idx = 0;
+}
+
+void singly_list_wrap(Singly_List* list, Singly_Linked_List_Node* linked_list_head) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    list->head       = linked_list_head;
+    list->tail       = linked_list_head;
+    list->len        = 0;
+    list->pool       = NULL;
+    list->finger     = NULL;
+    list->finger_idx = 0;
+    if (linked_list_head == NULL) {
+        return;
+    }
+
+    list->len = 1;
+    for (;list->tail->next != NULL;) {
+        list->tail = list->tail->next;
+        list->len += 1;
+    }
+}
+
+void singly_list_free(Singly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    Singly_Linked_List_Node* curr_node = list->head;
+    for (;curr_node != NULL;) {
+        Singly_Linked_List_Node* to_free = curr_node;
+        curr_node = curr_node->next;
+        singly_node_release(list->pool, to_free);
+    }
+
+    singly_list_init_pooled(list, list->pool);
+}
+
+size_t singly_list_len(Singly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return list->len;
+}
+
+void singly_list_print(Singly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    singly_linked_list_print(list->head);
+}
+
+void singly_list_push_front(Singly_List* list, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    Singly_Linked_List_Node* new_node = singly_node_alloc(list->pool);
+    new_node->val  = val;
+    new_node->next = list->head;
+
+    list->head = new_node;
+    if (list->tail == NULL) {
+        list->tail = new_node;
+    }
+    list->len += 1;
+    // The finger node is still in the list, one position further.
+    if (list->finger != NULL) {
+        list->finger_idx += 1;
+    }
+}
+
+void singly_list_append(Singly_List* list, int val) {
+    INSTRUMENT_SCOPE(SINGLY_LIST_APPEND);
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    Singly_Linked_List_Node* new_node = singly_node_alloc(list->pool);
+    new_node->val  = val;
+    new_node->next = NULL;
+
+    if (list->tail == NULL) {
+        list->head = new_node;
+    } else {
+        list->tail->next = new_node;
+    }
+    list->tail = new_node;
+    list->len += 1;
+}
+
+// Returns the node at `idx`, which must be in range, and moves the finger to it. The
+// walk starts from the finger when it is not past `idx`, from the head otherwise.
+static Singly_Linked_List_Node* singly_list_node_at(Singly_List* list, size_t idx) {
+    Singly_Linked_List_Node* node = list->head;
+    size_t i = 0;
+    if (idx == list->len - 1) {
+        node = list->tail;
+        i    = idx;
+    } else if (list->finger != NULL && list->finger_idx <= idx) {
+        node = list->finger;
+        i    = list->finger_idx;
+    }
+
+    for (; i < idx; i += 1) {
+        INSTRUMENT_VISIT();
+        node = node->next;
+    }
+
+    list->finger     = node;
+    list->finger_idx = idx;
+    return node;
+}
+
+bool singly_list_insert(Singly_List* list, size_t idx, int val) {
+    INSTRUMENT_SCOPE(SINGLY_LIST_INSERT);
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx > list->len) {
+        return false;
+    }
+
+    if (idx == 0) {
+        singly_list_push_front(list, val);
+        return true;
+    }
+
+    if (idx == list->len) {
+        singly_list_append(list, val);
+        return true;
+    }
+
+    // The finger stays on the predecessor, whose index does not change.
+    Singly_Linked_List_Node* prev_node = singly_list_node_at(list, idx - 1);
+    Singly_Linked_List_Node* new_node = singly_node_alloc(list->pool);
+    new_node->val   = val;
+    new_node->next  = prev_node->next;
+    prev_node->next = new_node;
+    list->len += 1;
+    return true;
+}
+
+bool singly_list_remove(Singly_List* list, size_t idx, int* removed_val) {
+    INSTRUMENT_SCOPE(SINGLY_LIST_REMOVE);
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->len) {
+        return false;
+    }
+
+    // Past the head, the finger stays on the predecessor, whose index does not change.
+    Singly_Linked_List_Node* prev_node = NULL;
+    Singly_Linked_List_Node* to_free   = list->head;
+    if (idx > 0) {
+        prev_node = singly_list_node_at(list, idx - 1);
+        to_free   = prev_node->next;
+    } else if (list->finger == to_free) {
+        list->finger = NULL;
+    } else if (list->finger != NULL) {
+        list->finger_idx -= 1;
+    }
+
+    if (prev_node == NULL) {
+        list->head = to_free->next;
+    } else {
+        prev_node->next = to_free->next;
+    }
+
+    if (to_free == list->tail) {
+        list->tail = prev_node;
+    }
+
+    if (removed_val != NULL) {
+        *removed_val = to_free->val;
+    }
+
+    singly_node_release(list->pool, to_free);
+    list->len -= 1;
+    return true;
+}
+
+bool singly_list_lookup(Singly_List* list, int needle_val, size_t* found_idx) {
+    INSTRUMENT_SCOPE(SINGLY_LIST_LOOKUP);
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(found_idx != NULL && "Found index pointer is NULL.");
+
+    if (list->head == NULL) {
+        return false;
+    }
+
+    return singly_linked_list_lookup(list->head, needle_val, found_idx);
+}
+
+bool singly_list_get(Singly_List* list, size_t idx, int* get_val) {
+    INSTRUMENT_SCOPE(SINGLY_LIST_GET);
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(get_val != NULL && "Get value pointer is NULL.");
+
+    if (idx >= list->len) {
+        return false;
+    }
+
+    *get_val = singly_list_node_at(list, idx)->val;
+    return true;
+}
+
+bool singly_list_set(Singly_List* list, size_t idx, int new_val) {
+    INSTRUMENT_SCOPE(SINGLY_LIST_SET);
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->len) {
+        return false;
+    }
+
+    singly_list_node_at(list, idx)->val = new_val;
+    return true;
+}
+
+void singly_list_from_array(Singly_List* list, Node_Pool* pool, const int* vals, size_t n) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert((vals != NULL || n == 0) && "Values array is NULL.");
+
+    singly_list_init_pooled(list, pool);
+    if (n == 0) {
+        return;
+    }
+
+    Singly_Linked_List_Node* block = NULL;
+    if (pool != NULL) {
+        assert(pool->node_size == sizeof(Singly_Linked_List_Node) && "Node pool size does not match the node.");
+        block = (Singly_Linked_List_Node*) node_pool_alloc_array(pool, n);
+    }
+
+    Singly_Linked_List_Node* prev_node = NULL;
+    for (size_t i = 0; i < n; i += 1) {
+        Singly_Linked_List_Node* new_node = block != NULL ? &block[i] : singly_node_alloc(NULL);
+        new_node->val = vals[i];
+        if (prev_node == NULL) {
+            list->head = new_node;
+        } else {
+            prev_node->next = new_node;
+        }
+        prev_node = new_node;
+    }
+    prev_node->next = NULL;
+
+    list->tail = prev_node;
+    list->len  = n;
+}
+
 Doubly_Linked_List_Node* doubly_linked_list_new(int head_val) {
-    Doubly_Linked_List_Node* head = (Doubly_Linked_List_Node*) malloc(sizeof(Doubly_Linked_List_Node));
+    return doubly_linked_list_new_pooled(NULL, head_val);
+}
+
+Doubly_Linked_List_Node* doubly_linked_list_new_pooled(Node_Pool* pool, int head_val) {
+    Doubly_Linked_List_Node* head = doubly_node_alloc(pool);
     head->val  = head_val;
     head->prev = NULL;
     head->next = NULL;
@@ -207,40 +541,37 @@ size_t doubly_linked_list_count(Doubly_Linked_List_Node* linked_list_head) {
 void doubly_linked_list_print(Doubly_Linked_List_Node* linked_list_head) {
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
-    printf("%d", linked_list_head->val);
-
-    Doubly_Linked_List_Node* curr_node = linked_list_head->next;
-    for(;curr_node != NULL;) {
-        printf(" -> %d", curr_node->val);
-        curr_node = curr_node->next;
-    }
+    unsigned char buffer[PRINT_BUFFER_SIZE];
+    Export_Writer writer;
+    print_open(&writer, buffer);
+    export_doubly_linked_list(&writer, linked_list_head);
+    export_writer_finish(&writer);
 }
 
 void doubly_linked_list_print_backward(Doubly_Linked_List_Node* linked_list_head) {
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
-    Doubly_Linked_List_Node* last_node = linked_list_head;
-    for(;last_node->next != NULL;) {
-        last_node = last_node->next;
-    }
-
-    printf("%d", last_node->val);
-
-    Doubly_Linked_List_Node* curr_node = last_node->prev;
-    for(;curr_node != NULL;) {
-        printf(" -> %d", curr_node->val);
-        curr_node = curr_node->prev;
-    }
+    unsigned char buffer[PRINT_BUFFER_SIZE];
+    Export_Writer writer;
+    print_open(&writer, buffer);
+    export_doubly_linked_list_backward(&writer, linked_list_head);
+    export_writer_finish(&writer);
 }
 
 void doubly_linked_list_insert_head(Doubly_Linked_List_Node* linked_list_head, int val) {
+    doubly_linked_list_insert_head_pooled(NULL, linked_list_head, val);
+}
+
+void doubly_linked_list_insert_head_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int val) {
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
-    Doubly_Linked_List_Node* prev_head_node = (Doubly_Linked_List_Node*) malloc(sizeof(Doubly_Linked_List_Node));
+    Doubly_Linked_List_Node* prev_head_node = doubly_node_alloc(pool);
     prev_head_node->val = linked_list_head->val;
     prev_head_node->prev = linked_list_head;
     prev_head_node->next = linked_list_head->next;
-    prev_head_node->next->prev = prev_head_node;
+    if (prev_head_node->next != NULL) {
+        prev_head_node->next->prev = prev_head_node;
+    }
 
     linked_list_head->val = val;
     linked_list_head->next = prev_head_node;
@@ -248,6 +579,10 @@ void doubly_linked_list_insert_head(Doubly_Linked_List_Node* linked_list_head, i
 }
 
 void doubly_linked_list_insert_tail(Doubly_Linked_List_Node* linked_list_head, int val) {
+    doubly_linked_list_insert_tail_pooled(NULL, linked_list_head, val);
+}
+
+void doubly_linked_list_insert_tail_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int val) {
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     Doubly_Linked_List_Node* prev_last_node = linked_list_head;
@@ -255,7 +590,7 @@ void doubly_linked_list_insert_tail(Doubly_Linked_List_Node* linked_list_head, i
         prev_last_node = prev_last_node->next;
     }
 
-    Doubly_Linked_List_Node* new_last_node = (Doubly_Linked_List_Node*) malloc(sizeof(Doubly_Linked_List_Node));
+    Doubly_Linked_List_Node* new_last_node = doubly_node_alloc(pool);
     new_last_node->val = val;
     new_last_node->prev = prev_last_node;
     new_last_node->next = NULL;
@@ -264,10 +599,15 @@ void doubly_linked_list_insert_tail(Doubly_Linked_List_Node* linked_list_head, i
 }
 
 void doubly_linked_list_insert(Doubly_Linked_List_Node* linked_list_head, size_t idx, int val) {
+    doubly_linked_list_insert_pooled(NULL, linked_list_head, idx, val);
+}
+
+void doubly_linked_list_insert_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, size_t idx, int val) {
+    INSTRUMENT_SCOPE(DOUBLY_LINKED_LIST_INSERT);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     if (idx == 0) {
-        doubly_linked_list_insert_head(linked_list_head, val);
+        doubly_linked_list_insert_head_pooled(pool, linked_list_head, val);
         return;
     }
 
@@ -278,7 +618,7 @@ void doubly_linked_list_insert(Doubly_Linked_List_Node* linked_list_head, size_t
         }
 
         if (i == idx) {
-            Doubly_Linked_List_Node* new_node = (Doubly_Linked_List_Node*) malloc(sizeof(Doubly_Linked_List_Node));
+            Doubly_Linked_List_Node* new_node = doubly_node_alloc(pool);
             new_node->val = val;
             new_node->prev = curr_node->prev;
             new_node->next = curr_node;
@@ -289,7 +629,7 @@ void doubly_linked_list_insert(Doubly_Linked_List_Node* linked_list_head, size_t
         }
 
         if(i+1 == idx && curr_node->next == NULL) {
-            Doubly_Linked_List_Node* new_tail = (Doubly_Linked_List_Node*) malloc(sizeof(Doubly_Linked_List_Node));
+            Doubly_Linked_List_Node* new_tail = doubly_node_alloc(pool);
             new_tail->val = val;
             new_tail->prev = curr_node;
             new_tail->next = NULL;
@@ -298,16 +638,21 @@ void doubly_linked_list_insert(Doubly_Linked_List_Node* linked_list_head, size_t
             return;
         }
 
+        INSTRUMENT_VISIT();
         curr_node = curr_node->next;
     }
 }
 
 bool doubly_linked_list_remove_head(Doubly_Linked_List_Node* linked_list_head, int* removed_val) {
+    return doubly_linked_list_remove_head_pooled(NULL, linked_list_head, removed_val);
+}
+
+bool doubly_linked_list_remove_head_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int* removed_val) {
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     *removed_val = linked_list_head->val;
     if(linked_list_head->next == NULL) {
-        free(linked_list_head);
+        doubly_node_release(pool, linked_list_head);
     } else {
         Doubly_Linked_List_Node* to_free = linked_list_head->next;
         linked_list_head->val = to_free->val;
@@ -316,17 +661,21 @@ bool doubly_linked_list_remove_head(Doubly_Linked_List_Node* linked_list_head, i
             linked_list_head->next->prev = linked_list_head;
         }
         linked_list_head->prev = NULL;
-        free(to_free);
+        doubly_node_release(pool, to_free);
     }
 
     return true;
 }
 
 bool doubly_linked_list_remove_tail(Doubly_Linked_List_Node* linked_list_head, int* removed_val) {
+    return doubly_linked_list_remove_tail_pooled(NULL, linked_list_head, removed_val);
+}
+
+bool doubly_linked_list_remove_tail_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int* removed_val) {
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     if (linked_list_head->next == NULL) {
-        doubly_linked_list_remove_head(linked_list_head, removed_val);
+        return doubly_linked_list_remove_head_pooled(pool, linked_list_head, removed_val);
     }
 
     Doubly_Linked_List_Node* last_node = linked_list_head;
@@ -336,16 +685,21 @@ bool doubly_linked_list_remove_tail(Doubly_Linked_List_Node* linked_list_head, i
 
     *removed_val = last_node->val;
     last_node->prev->next = NULL;
-    free(last_node);
+    doubly_node_release(pool, last_node);
 
     return true;
 }
 
 bool doubly_linked_list_remove(Doubly_Linked_List_Node* linked_list_head, size_t idx, int* removed_val) {
+    return doubly_linked_list_remove_pooled(NULL, linked_list_head, idx, removed_val);
+}
+
+bool doubly_linked_list_remove_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, size_t idx, int* removed_val) {
+    INSTRUMENT_SCOPE(DOUBLY_LINKED_LIST_REMOVE);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     if (idx == 0) {
-        return doubly_linked_list_remove_head(linked_list_head, removed_val);
+        return doubly_linked_list_remove_head_pooled(pool, linked_list_head, removed_val);
     }
 
     Doubly_Linked_List_Node* curr_node = linked_list_head;
@@ -360,10 +714,11 @@ bool doubly_linked_list_remove(Doubly_Linked_List_Node* linked_list_head, size_t
             if(curr_node->next != NULL) {
                 curr_node->next->prev = curr_node->prev;
             }
-            free(curr_node);
+            doubly_node_release(pool, curr_node);
             return true;
         }
 
+        INSTRUMENT_VISIT();
         curr_node = curr_node->next;
     }
 
@@ -371,6 +726,7 @@ bool doubly_linked_list_remove(Doubly_Linked_List_Node* linked_list_head, size_t
 }
 
 bool doubly_linked_list_search(Doubly_Linked_List_Node* linked_list_head, int needle_val, size_t* found_idx) {
+    INSTRUMENT_SCOPE(DOUBLY_LINKED_LIST_SEARCH);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     Doubly_Linked_List_Node* curr_node = linked_list_head;
@@ -381,6 +737,7 @@ bool doubly_linked_list_search(Doubly_Linked_List_Node* linked_list_head, int ne
             return true;
         }
 
+        INSTRUMENT_VISIT();
         curr_node = curr_node->next;
     }
 
@@ -388,6 +745,7 @@ bool doubly_linked_list_search(Doubly_Linked_List_Node* linked_list_head, int ne
 }
 
 bool doubly_linked_list_get(Doubly_Linked_List_Node* linked_list_head, size_t idx, int* get_val) {
+    INSTRUMENT_SCOPE(DOUBLY_LINKED_LIST_GET);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     Doubly_Linked_List_Node* curr_node = linked_list_head;
@@ -401,6 +759,7 @@ bool doubly_linked_list_get(Doubly_Linked_List_Node* linked_list_head, size_t id
             return true;
         }
 
+        INSTRUMENT_VISIT();
         curr_node = curr_node->next;
     }
 
@@ -408,6 +767,7 @@ bool doubly_linked_list_get(Doubly_Linked_List_Node* linked_list_head, size_t id
 }
 
 bool doubly_linked_list_set(Doubly_Linked_List_Node* linked_list_head, size_t idx, int new_val) {
+    INSTRUMENT_SCOPE(DOUBLY_LINKED_LIST_SET);
     assert(linked_list_head != NULL && "Linked List head is NULL.");
 
     Doubly_Linked_List_Node* curr_node = linked_list_head;
@@ -421,6 +781,7 @@ bool doubly_linked_list_set(Doubly_Linked_List_Node* linked_list_head, size_t id
             return true;
         }
 
+        INSTRUMENT_VISIT();
         curr_node = curr_node->next;
     }
 
@@ -444,4 +805,313 @@ Doubly_Linked_List_Node* doubly_linked_list_reverse(Doubly_Linked_List_Node* lin
     }
 
     return curr_node;
-}
\ No newline at end of file
+}
+
+void doubly_list_init(Doubly_List* list) {
+    doubly_list_init_pooled(list, NULL);
+}
+
+void doubly_list_init_pooled(Doubly_List* list, Node_Pool* pool) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    list->head     = NULL;
+    list->tail     = NULL;
+    list->count    = 0;
+    list->reversed = false;
+    list->pool     = pool;
+}
+
+void doubly_list_wrap(Doubly_List* list, Doubly_Linked_List_Node* linked_list_head) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert((linked_list_head == NULL || linked_list_head->prev == NULL) && "Linked List head has a previous node.");
+
+    doubly_list_init(list);
+    if (linked_list_head == NULL) {
+        return;
+    }
+
+    list->head  = linked_list_head;
+    list->tail  = linked_list_head;
+    list->count = 1;
+    for (;list->tail->next != NULL;) {
+        list->tail = list->tail->next;
+        list->count += 1;
+    }
+}
+
+void doubly_list_free(Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    Doubly_Linked_List_Node* curr_node = list->head;
+    for (;curr_node != NULL;) {
+        Doubly_Linked_List_Node* to_free = curr_node;
+        curr_node = curr_node->next;
+        doubly_node_release(list->pool, to_free);
+    }
+
+    doubly_list_init_pooled(list, list->pool);
+}
+
+size_t doubly_list_count(Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return list->count;
+}
+
+// The handle procedures work in logical order: once the list is reversed, it starts
+// at the physical tail and moving forward follows the `prev` links.
+static Doubly_Linked_List_Node* logical_first(Doubly_List* list) {
+    return list->reversed ? list->tail : list->head;
+}
+
+static Doubly_Linked_List_Node* logical_last(Doubly_List* list) {
+    return list->reversed ? list->head : list->tail;
+}
+
+static Doubly_Linked_List_Node* logical_next(Doubly_List* list, Doubly_Linked_List_Node* node) {
+    return list->reversed ? node->prev : node->next;
+}
+
+static Doubly_Linked_List_Node* logical_prev(Doubly_List* list, Doubly_Linked_List_Node* node) {
+    return list->reversed ? node->next : node->prev;
+}
+
+// Links `new_node` physically before `next_node`, or after the tail when `next_node` is `NULL`.
+static void link_before(Doubly_List* list, Doubly_Linked_List_Node* next_node, Doubly_Linked_List_Node* new_node) {
+    Doubly_Linked_List_Node* prev_node = next_node != NULL ? next_node->prev : list->tail;
+    new_node->prev = prev_node;
+    new_node->next = next_node;
+
+    if (prev_node == NULL) {
+        list->head = new_node;
+    } else {
+        prev_node->next = new_node;
+    }
+
+    if (next_node == NULL) {
+        list->tail = new_node;
+    } else {
+        next_node->prev = new_node;
+    }
+
+    list->count += 1;
+}
+
+// Links `new_node` logically before `position`, or at the logical end when `position` is `NULL`.
+static void link_logical_before(Doubly_List* list, Doubly_Linked_List_Node* position, Doubly_Linked_List_Node* new_node) {
+    if (!list->reversed) {
+        link_before(list, position, new_node);
+        return;
+    }
+
+    // Logically before is physically after, and the logical end is the physical front.
+    link_before(list, position != NULL ? position->next : list->head, new_node);
+}
+
+static void unlink_node(Doubly_List* list, Doubly_Linked_List_Node* node) {
+    if (node->prev == NULL) {
+        list->head = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+
+    if (node->next == NULL) {
+        list->tail = node->prev;
+    } else {
+        node->next->prev = node->prev;
+    }
+
+    list->count -= 1;
+}
+
+// Returns the node at logical index `idx`, which must be in range, walking from the closer end.
+static Doubly_Linked_List_Node* node_at(Doubly_List* list, size_t idx) {
+    Doubly_Linked_List_Node* curr_node;
+    if (idx <= list->count / 2) {
+        curr_node = logical_first(list);
+        for (size_t i = 0; i < idx; i += 1) {
+            INSTRUMENT_VISIT();
+            curr_node = logical_next(list, curr_node);
+        }
+    } else {
+        curr_node = logical_last(list);
+        for (size_t i = list->count - 1; i > idx; i -= 1) {
+            INSTRUMENT_VISIT();
+            curr_node = logical_prev(list, curr_node);
+        }
+    }
+    return curr_node;
+}
+
+void doubly_list_print(Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    unsigned char buffer[PRINT_BUFFER_SIZE];
+    Export_Writer writer;
+    print_open(&writer, buffer);
+    export_doubly_list(&writer, list);
+    export_writer_finish(&writer);
+}
+
+void doubly_list_print_backward(Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    unsigned char buffer[PRINT_BUFFER_SIZE];
+    Export_Writer writer;
+    print_open(&writer, buffer);
+    for (Doubly_Linked_List_Node* curr_node = logical_last(list); curr_node != NULL;
+         curr_node = logical_prev(list, curr_node)) {
+        export_int(&writer, curr_node->val);
+    }
+    export_writer_finish(&writer);
+}
+
+void doubly_list_insert_head(Doubly_List* list, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    Doubly_Linked_List_Node* new_node = doubly_node_alloc(list->pool);
+    new_node->val = val;
+    link_logical_before(list, logical_first(list), new_node);
+}
+
+void doubly_list_insert_tail(Doubly_List* list, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    Doubly_Linked_List_Node* new_node = doubly_node_alloc(list->pool);
+    new_node->val = val;
+    link_logical_before(list, NULL, new_node);
+}
+
+bool doubly_list_insert(Doubly_List* list, size_t idx, int val) {
+    INSTRUMENT_SCOPE(DOUBLY_LIST_INSERT);
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx > list->count) {
+        return false;
+    }
+
+    Doubly_Linked_List_Node* position = idx < list->count ? node_at(list, idx) : NULL;
+    Doubly_Linked_List_Node* new_node = doubly_node_alloc(list->pool);
+    new_node->val = val;
+    link_logical_before(list, position, new_node);
+    return true;
+}
+
+// Unlinks and releases `node`, which may be `NULL` when the list is empty.
+static bool remove_node(Doubly_List* list, Doubly_Linked_List_Node* node, int* removed_val) {
+    if (node == NULL) {
+        return false;
+    }
+
+    unlink_node(list, node);
+    if (removed_val != NULL) {
+        *removed_val = node->val;
+    }
+    doubly_node_release(list->pool, node);
+    return true;
+}
+
+bool doubly_list_remove_head(Doubly_List* list, int* removed_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return remove_node(list, logical_first(list), removed_val);
+}
+
+bool doubly_list_remove_tail(Doubly_List* list, int* removed_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return remove_node(list, logical_last(list), removed_val);
+}
+
+bool doubly_list_remove(Doubly_List* list, size_t idx, int* removed_val) {
+    INSTRUMENT_SCOPE(DOUBLY_LIST_REMOVE);
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->count) {
+        return false;
+    }
+
+    return remove_node(list, node_at(list, idx), removed_val);
+}
+
+bool doubly_list_search(Doubly_List* list, int needle_val, size_t* found_idx) {
+    INSTRUMENT_SCOPE(DOUBLY_LIST_SEARCH);
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(found_idx != NULL && "Found index pointer is NULL.");
+
+    Doubly_Linked_List_Node* curr_node = logical_first(list);
+    for (size_t i = 0; curr_node != NULL; i += 1) {
+        if (curr_node->val == needle_val) {
+            *found_idx = i;
+            return true;
+        }
+        INSTRUMENT_VISIT();
+        curr_node = logical_next(list, curr_node);
+    }
+
+    return false;
+}
+
+bool doubly_list_get(Doubly_List* list, size_t idx, int* get_val) {
+    INSTRUMENT_SCOPE(DOUBLY_LIST_GET);
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(get_val != NULL && "Get value pointer is NULL.");
+
+    if (idx >= list->count) {
+        return false;
+    }
+
+    *get_val = node_at(list, idx)->val;
+    return true;
+}
+
+bool doubly_list_set(Doubly_List* list, size_t idx, int new_val) {
+    INSTRUMENT_SCOPE(DOUBLY_LIST_SET);
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->count) {
+        return false;
+    }
+
+    node_at(list, idx)->val = new_val;
+    return true;
+}
+
+void doubly_list_reverse(Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    list->reversed = !list->reversed;
+}
+
+void doubly_list_from_array(Doubly_List* list, Node_Pool* pool, const int* vals, size_t n) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert((vals != NULL || n == 0) && "Values array is NULL.");
+
+    doubly_list_init_pooled(list, pool);
+    if (n == 0) {
+        return;
+    }
+
+    Doubly_Linked_List_Node* block = NULL;
+    if (pool != NULL) {
+        assert(pool->node_size == sizeof(Doubly_Linked_List_Node) && "Node pool size does not match the node.");
+        block = (Doubly_Linked_List_Node*) node_pool_alloc_array(pool, n);
+    }
+
+    Doubly_Linked_List_Node* prev_node = NULL;
+    for (size_t i = 0; i < n; i += 1) {
+        Doubly_Linked_List_Node* new_node = block != NULL ? &block[i] : doubly_node_alloc(NULL);
+        new_node->val  = vals[i];
+        new_node->prev = prev_node;
+        if (prev_node == NULL) {
+            list->head = new_node;
+        } else {
+            prev_node->next = new_node;
+        }
+        prev_node = new_node;
+    }
+    prev_node->next = NULL;
+
+    list->tail  = prev_node;
+    list->count = n;
+}
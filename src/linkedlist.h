@@ -6,6 +6,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#include "memory/node_pool.h"
+
 /**
  * @struct Singly_Linked_List_Node
  * @brief Represents a node in a singly linked list.
@@ -462,6 +464,318 @@ bool singly_linked_list_lookup(Singly_Linked_List_Node* linked_list_head, int ne
  */
 void singly_linked_list_free(Singly_Linked_List_Node* linked_list_head);
 
+/**
+ * @brief Pool-aware variants of the singly linked list procedures.
+ *
+ * These procedures behave exactly like their counterpart without the `_pooled`
+ * suffix, except that nodes are taken from and given back to `pool` instead of
+ * going through `malloc` and `free`. Removing a node becomes a push on the pool free
+ * list, and every node of every list allocated from a pool is released at once by
+ * `node_pool_destroy`, without walking the lists.
+ *
+ * @param pool
+ *        A pool initialized with a node size of `sizeof(Singly_Linked_List_Node)`.
+ *        When `NULL`, nodes are allocated with `malloc` and freed with `free`.
+ *
+ * Example:
+ *
+ * ```c
+ * Node_Pool pool;
+ * node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+ *
+ * Singly_Linked_List_Node* head = singly_linked_list_new_pooled(&pool, 10);
+ * singly_linked_list_append_pooled(&pool, head, 20);
+ * singly_linked_list_insert_pooled(&pool, head, 1, 15);
+ *
+ * int removed_val;
+ * singly_linked_list_remove_pooled(&pool, head, 2, &removed_val); // 20 goes back to the pool.
+ *
+ * node_pool_destroy(&pool);
+ * ```
+ *
+ * Notes:
+ * - Nodes of a pooled list must not be passed to `singly_linked_list_free` nor to any
+ *   procedure without the `_pooled` suffix that frees nodes.
+ */
+Singly_Linked_List_Node* singly_linked_list_new_pooled(Node_Pool* pool, int head_val);
+
+void singly_linked_list_append_pooled(Node_Pool* pool, Singly_Linked_List_Node* linked_list_head, int val);
+
+void singly_linked_list_insert_pooled(Node_Pool* pool, Singly_Linked_List_Node* linked_list_head, size_t idx, int val);
+
+bool singly_linked_list_remove_pooled(Node_Pool* pool, Singly_Linked_List_Node* linked_list_head, size_t idx, int* removed_val);
+
+/**
+ * @struct Singly_List
+ * @brief A handle over a chain of `Singly_Linked_List_Node` caching its tail and length.
+ *
+ * The node based `singly_linked_list_*` procedures only know about the head, so
+ * appending or computing the length has to walk the whole chain. This handle keeps
+ * the head, the tail and the number of nodes up to date on every operation, which
+ * makes `singly_list_append`, `singly_list_push_front` and `singly_list_len` O(1).
+ *
+ * Fields:
+ * - `head`:
+ *   The first node of the list, `NULL` when the list is empty.
+ *
+ * - `tail`:
+ *   The last node of the list, `NULL` when the list is empty.
+ *
+ * - `len`:
+ *   The number of nodes reachable from `head`.
+ *
+ * - `pool`:
+ *   The pool the nodes are allocated from, `NULL` when they come from `malloc`.
+ *
+ * - `finger`:
+ *   The node last reached by index, `NULL` when there is none. Positional operations
+ *   at or after `finger_idx` resume their walk from it instead of from the head, so a
+ *   loop over increasing indices costs O(1) amortized per access instead of O(idx).
+ *
+ * - `finger_idx`:
+ *   The index of `finger`, kept up to date by every operation of the handle.
+ *
+ * Example:
+ *
+ * ```c
+ * Singly_List list;
+ * singly_list_init(&list);
+ *
+ * singly_list_append(&list, 20);
+ * singly_list_append(&list, 30);
+ * singly_list_push_front(&list, 10);
+ *
+ * singly_list_print(&list); // Output: 10 -> 20 -> 30
+ * printf("%zu\n", singly_list_len(&list)); // Output: 3
+ *
+ * singly_list_free(&list);
+ * ```
+ *
+ * Notes:
+ * - The nodes are regular `Singly_Linked_List_Node`, `list.head` can be handed to the
+ *   read only node procedures such as `singly_linked_list_lookup` or `singly_linked_list_print`.
+ * - Modifying the chain through the node procedures bypasses the handle, the cached
+ *   tail, length and finger are then stale.
+ */
+typedef struct Singly_List {
+    Singly_Linked_List_Node* head;
+    Singly_Linked_List_Node* tail;
+    size_t                   len;
+    Node_Pool*               pool;
+    Singly_Linked_List_Node* finger;
+    size_t                   finger_idx;
+} Singly_List;
+
+/**
+ * @brief Initializes an empty list handle.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ */
+void singly_list_init(Singly_List* list);
+
+/**
+ * @brief Initializes an empty list handle allocating its nodes from `pool`.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ *
+ * @param pool
+ *        A pool initialized with a node size of `sizeof(Singly_Linked_List_Node)`,
+ *        or `NULL` to allocate nodes with `malloc`.
+ */
+void singly_list_init_pooled(Singly_List* list, Node_Pool* pool);
+
+/**
+ * @brief Takes ownership of an existing chain of nodes.
+ *
+ * The chain is walked once to find its tail and length, every following operation
+ * on the handle is then able to use the cached values. The nodes of the chain must
+ * have been allocated with `malloc`.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ *
+ * @param linked_list_head
+ *        The head of the chain to wrap, may be `NULL` for an empty list.
+ *
+ * Performance:
+ * - Time complexity: O(n), where `n` is the number of nodes in the chain.
+ */
+void singly_list_wrap(Singly_List* list, Singly_Linked_List_Node* linked_list_head);
+
+/**
+ * @brief Frees every node of the list and resets the handle to an empty list.
+ *
+ * When the list is pooled, the nodes are given back to its pool.
+ *
+ * @param list
+ *        The handle of the list to free. Must not be `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(n), where `n` is the number of nodes in the list.
+ */
+void singly_list_free(Singly_List* list);
+
+/**
+ * @brief Returns the number of nodes in the list.
+ *
+ * @param list
+ *        The handle of the list. Must not be `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(1), the length is cached in the handle.
+ */
+size_t singly_list_len(Singly_List* list);
+
+/**
+ * @brief Prints the elements of the list to the standard output.
+ *
+ * The output format is the same as `singly_linked_list_print`.
+ *
+ * @param list
+ *        The handle of the list. Must not be `NULL`.
+ */
+void singly_list_print(Singly_List* list);
+
+/**
+ * @brief Inserts a new node holding `val` in front of the list.
+ *
+ * Unlike `singly_linked_list_insert` with an index of `0`, the existing head node is
+ * left untouched: the new node is linked before it and becomes the new head.
+ *
+ * @param list
+ *        The handle of the list. Must not be `NULL`.
+ *
+ * @param val
+ *        The integer value to store in the new node.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error if `malloc` returns `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+void singly_list_push_front(Singly_List* list, int val);
+
+/**
+ * @brief Appends a new node holding `val` at the end of the list.
+ *
+ * @param list
+ *        The handle of the list. Must not be `NULL`.
+ *
+ * @param val
+ *        The integer value to store in the new node.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error if `malloc` returns `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(1), the new node is linked after the cached tail.
+ */
+void singly_list_append(Singly_List* list, int val);
+
+/**
+ * @brief Inserts a new node holding `val` at the given index.
+ *
+ * @param list
+ *        The handle of the list. Must not be `NULL`.
+ *
+ * @param idx
+ *        The zero-based index the new node will have once inserted.
+ *        - If `idx == 0`, this is equivalent to `singly_list_push_front`.
+ *        - If `idx == len`, this is equivalent to `singly_list_append`.
+ *        - If `idx > len`, the list is left untouched.
+ *
+ * @param val
+ *        The integer value to store in the new node.
+ *
+ * @return
+ *        `true` if the node was inserted, `false` if `idx` is out of range.
+ *
+ * Performance:
+ * - Time complexity: O(idx), inserting at the front or the end is O(1). The walk
+ *   resumes from the finger when it is at or before `idx - 1`, so inserting at
+ *   increasing indices is O(1) amortized per insertion.
+ */
+bool singly_list_insert(Singly_List* list, size_t idx, int val);
+
+/**
+ * @brief Removes the node at the given index and optionally retrieves its value.
+ *
+ * @param list
+ *        The handle of the list. Must not be `NULL`.
+ *
+ * @param idx
+ *        The zero-based index of the node to remove.
+ *
+ * @param removed_val
+ *        Where to store the value of the removed node, may be `NULL`.
+ *
+ * @return
+ *        `true` if a node was removed, `false` if `idx` is out of range.
+ *
+ * Performance:
+ * - Time complexity: O(idx), the predecessor of the removed node has to be found
+ *   to unlink it, even when removing the tail. The walk resumes from the finger when
+ *   it is at or before `idx - 1`, like for `singly_list_insert`.
+ */
+bool singly_list_remove(Singly_List* list, size_t idx, int* removed_val);
+
+/**
+ * @brief Searches for the first node holding `needle_val`.
+ *
+ * @param list
+ *        The handle of the list. Must not be `NULL`.
+ *
+ * @param needle_val
+ *        The value to search for.
+ *
+ * @param found_idx
+ *        Where to store the index of the first matching node. Left unchanged when
+ *        the value is not found. Must not be `NULL`.
+ *
+ * @return
+ *        `true` if the value is found, `false` otherwise.
+ *
+ * Performance:
+ * - Time complexity: O(n), where `n` is the number of nodes in the list.
+ */
+bool singly_list_lookup(Singly_List* list, int needle_val, size_t* found_idx);
+
+/**
+ * @brief Retrieves or overwrites the value at the given index.
+ *
+ * @return
+ *        `true` if `idx` is in range, `false` otherwise.
+ *
+ * Performance:
+ * - Time complexity: O(idx), O(1) for the last node. The walk resumes from the finger
+ *   when it is at or before `idx`, so `for (i = 0; i < len; i += 1)` loops are O(n)
+ *   in total rather than O(n^2).
+ */
+bool singly_list_get(Singly_List* list, size_t idx, int* get_val);
+bool singly_list_set(Singly_List* list, size_t idx, int new_val);
+
+/**
+ * @brief Initializes a list handle holding the `n` values of `vals`, in order.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ *
+ * @param pool
+ *        The pool of the list, or `NULL` to allocate nodes with `malloc`. With a pool,
+ *        all the nodes come from a single `node_pool_alloc_array` block, laid out in
+ *        list order so that walking the list reads memory sequentially.
+ *
+ * @param vals
+ *        The values to store. May be `NULL` when `n` is `0`.
+ *
+ * Performance:
+ * - Time complexity: O(n), with a single allocation when pooled.
+ */
+void singly_list_from_array(Singly_List* list, Node_Pool* pool, const int* vals, size_t n);
+
 typedef struct Doubly_Linked_List_Node {
     int val;
     struct Doubly_Linked_List_Node* prev;
@@ -498,4 +812,292 @@ bool doubly_linked_list_set(Doubly_Linked_List_Node* linked_list_head, size_t id
 
 Doubly_Linked_List_Node* doubly_linked_list_reverse(Doubly_Linked_List_Node* linked_list_head);
 
-#endif
\ No newline at end of file
+/**
+ * @brief Pool-aware variants of the doubly linked list procedures.
+ *
+ * Same contract as the singly linked list `_pooled` procedures: nodes are taken from
+ * and given back to `pool`, which must have been initialized with a node size of
+ * `sizeof(Doubly_Linked_List_Node)`. A `NULL` pool falls back to `malloc` and `free`.
+ */
+Doubly_Linked_List_Node* doubly_linked_list_new_pooled(Node_Pool* pool, int head_val);
+
+void doubly_linked_list_insert_head_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int val);
+
+void doubly_linked_list_insert_tail_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int val);
+
+void doubly_linked_list_insert_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, size_t idx, int val);
+
+bool doubly_linked_list_remove_head_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int* removed_val);
+
+bool doubly_linked_list_remove_tail_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, int* removed_val);
+
+bool doubly_linked_list_remove_pooled(Node_Pool* pool, Doubly_Linked_List_Node* linked_list_head, size_t idx, int* removed_val);
+
+/**
+ * @struct Doubly_List
+ * @brief A handle over a chain of `Doubly_Linked_List_Node` caching both ends and the count.
+ *
+ * The node based `doubly_linked_list_*` procedures only know about the head, so every
+ * tail operation first walks the whole chain, and positional operations always walk
+ * forward even when the index is close to the end. This handle keeps the head, the
+ * tail and the number of nodes up to date, which makes tail operations O(1) and lets
+ * positional operations start from whichever end is closer to the index.
+ *
+ * Fields:
+ * - `head`:
+ *   The node at the physical front of the chain (its `prev` is `NULL`), `NULL` when
+ *   the list is empty.
+ *
+ * - `tail`:
+ *   The node at the physical back of the chain (its `next` is `NULL`), `NULL` when
+ *   the list is empty.
+ *
+ * - `count`:
+ *   The number of nodes in the chain.
+ *
+ * - `reversed`:
+ *   Whether the list is read from `tail` to `head`. Reversing the list only flips
+ *   this flag: the first element of the list is then `tail`, and walking forward
+ *   follows the `prev` links.
+ *
+ * - `pool`:
+ *   The pool the nodes are allocated from, `NULL` when they come from `malloc`.
+ *
+ * Example:
+ *
+ * ```c
+ * Doubly_List list;
+ * doubly_list_init(&list);
+ *
+ * doubly_list_insert_tail(&list, 20);
+ * doubly_list_insert_tail(&list, 30);
+ * doubly_list_insert_head(&list, 10);
+ * doubly_list_print(&list); // Output: 10 -> 20 -> 30
+ *
+ * doubly_list_reverse(&list);
+ * doubly_list_print(&list); // Output: 30 -> 20 -> 10
+ *
+ * doubly_list_free(&list);
+ * ```
+ *
+ * Notes:
+ * - Indices, head and tail in the `doubly_list_*` procedures are always logical: once
+ *   the list is reversed, `doubly_list_insert_head` links the new node after `tail`.
+ * - While `reversed` is set, the chain read from `head` through the node procedures
+ *   is in the opposite order of the list.
+ * - Modifying the chain through the node procedures bypasses the handle, the cached
+ *   ends and count are then stale.
+ */
+typedef struct Doubly_List {
+    Doubly_Linked_List_Node* head;
+    Doubly_Linked_List_Node* tail;
+    size_t                   count;
+    bool                     reversed;
+    Node_Pool*               pool;
+} Doubly_List;
+
+/**
+ * @brief Initializes an empty list handle.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ */
+void doubly_list_init(Doubly_List* list);
+
+/**
+ * @brief Initializes an empty list handle allocating its nodes from `pool`.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ *
+ * @param pool
+ *        A pool initialized with a node size of `sizeof(Doubly_Linked_List_Node)`,
+ *        or `NULL` to allocate nodes with `malloc`.
+ */
+void doubly_list_init_pooled(Doubly_List* list, Node_Pool* pool);
+
+/**
+ * @brief Takes ownership of an existing chain of nodes allocated with `malloc`.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ *
+ * @param linked_list_head
+ *        The first node of the chain, may be `NULL` for an empty list.
+ *
+ * Performance:
+ * - Time complexity: O(n), the chain is walked once to find its tail and count.
+ */
+void doubly_list_wrap(Doubly_List* list, Doubly_Linked_List_Node* linked_list_head);
+
+/**
+ * @brief Frees every node of the list and resets the handle to an empty list.
+ *
+ * When the list is pooled, the nodes are given back to its pool.
+ *
+ * Performance:
+ * - Time complexity: O(n), where `n` is the number of nodes in the list.
+ */
+void doubly_list_free(Doubly_List* list);
+
+/**
+ * @brief Returns the number of nodes in the list.
+ *
+ * Performance:
+ * - Time complexity: O(1), the count is cached in the handle.
+ */
+size_t doubly_list_count(Doubly_List* list);
+
+/**
+ * @brief Prints the elements of the list to the standard output, first to last.
+ *
+ * The output format is the same as `doubly_linked_list_print`, nothing is printed
+ * for an empty list.
+ */
+void doubly_list_print(Doubly_List* list);
+
+/**
+ * @brief Prints the elements of the list to the standard output, last to first.
+ *
+ * Performance:
+ * - Time complexity: O(n), without the walk to the tail `doubly_linked_list_print_backward` does first.
+ */
+void doubly_list_print_backward(Doubly_List* list);
+
+/**
+ * @brief Inserts a new node holding `val` in front of the list.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error if `malloc` returns `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+void doubly_list_insert_head(Doubly_List* list, int val);
+
+/**
+ * @brief Appends a new node holding `val` at the end of the list.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error if `malloc` returns `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(1), the new node is linked next to the cached end.
+ */
+void doubly_list_insert_tail(Doubly_List* list, int val);
+
+/**
+ * @brief Inserts a new node holding `val` at the given index.
+ *
+ * @param idx
+ *        The zero-based index the new node will have once inserted, from `0` to
+ *        `count` included.
+ *
+ * @return
+ *        `true` if the node was inserted, `false` if `idx` is out of range.
+ *
+ * Performance:
+ * - Time complexity: O(min(idx, n - idx)), the walk starts from the closer end.
+ */
+bool doubly_list_insert(Doubly_List* list, size_t idx, int val);
+
+/**
+ * @brief Removes the first node of the list and optionally retrieves its value.
+ *
+ * @param removed_val
+ *        Where to store the value of the removed node, may be `NULL`.
+ *
+ * @return
+ *        `true` if a node was removed, `false` if the list is empty.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+bool doubly_list_remove_head(Doubly_List* list, int* removed_val);
+
+/**
+ * @brief Removes the last node of the list and optionally retrieves its value.
+ *
+ * @param removed_val
+ *        Where to store the value of the removed node, may be `NULL`.
+ *
+ * @return
+ *        `true` if a node was removed, `false` if the list is empty.
+ *
+ * Performance:
+ * - Time complexity: O(1).
+ */
+bool doubly_list_remove_tail(Doubly_List* list, int* removed_val);
+
+/**
+ * @brief Removes the node at the given index and optionally retrieves its value.
+ *
+ * @param removed_val
+ *        Where to store the value of the removed node, may be `NULL`.
+ *
+ * @return
+ *        `true` if a node was removed, `false` if `idx` is out of range.
+ *
+ * Performance:
+ * - Time complexity: O(min(idx, n - idx)), the walk starts from the closer end.
+ */
+bool doubly_list_remove(Doubly_List* list, size_t idx, int* removed_val);
+
+/**
+ * @brief Searches for the first node holding `needle_val`.
+ *
+ * @param found_idx
+ *        Where to store the index of the first matching node. Left unchanged when
+ *        the value is not found. Must not be `NULL`.
+ *
+ * @return
+ *        `true` if the value is found, `false` otherwise.
+ *
+ * Performance:
+ * - Time complexity: O(n), where `n` is the number of nodes in the list.
+ */
+bool doubly_list_search(Doubly_List* list, int needle_val, size_t* found_idx);
+
+/**
+ * @brief Retrieves the value at the given index.
+ *
+ * @return
+ *        `true` if `idx` is in range and `get_val` was written, `false` otherwise.
+ *
+ * Performance:
+ * - Time complexity: O(min(idx, n - idx)), the walk starts from the closer end.
+ */
+bool doubly_list_get(Doubly_List* list, size_t idx, int* get_val);
+
+/**
+ * @brief Overwrites the value at the given index.
+ *
+ * @return
+ *        `true` if `idx` is in range and the value was written, `false` otherwise.
+ *
+ * Performance:
+ * - Time complexity: O(min(idx, n - idx)), the walk starts from the closer end.
+ */
+bool doubly_list_set(Doubly_List* list, size_t idx, int new_val);
+
+/**
+ * @brief Reverses the order of the list.
+ *
+ * Performance:
+ * - Time complexity: O(1), only the `reversed` flag of the handle is flipped, no
+ *   node is touched.
+ */
+void doubly_list_reverse(Doubly_List* list);
+
+/**
+ * @brief Initializes a list handle holding the `n` values of `vals`, in order.
+ *
+ * Same as `singly_list_from_array`: with a pool, the nodes come from a single
+ * contiguous block laid out in list order.
+ *
+ * Performance:
+ * - Time complexity: O(n), with a single allocation when pooled.
+ */
+void doubly_list_from_array(Doubly_List* list, Node_Pool* pool, const int* vals, size_t n);
+
+#endif
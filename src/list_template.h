@@ -0,0 +1,458 @@
+#ifndef LIST_TEMPLATE_H
+#define LIST_TEMPLATE_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "memory/node_pool.h"
+
+/**
+ * @brief Compile-time specialized list handles for an arbitrary element type.
+ *
+ * `Singly_List` and `Doubly_List` store `int` values. Storing anything else behind a
+ * `void*` costs an extra allocation and a pointer chase per element, and searching
+ * through a comparison function pointer costs an indirect call per node. These macros
+ * instead generate the node and handle types and their procedures for a given element
+ * type and equality, which is pasted in the generated code and inlined by the compiler.
+ *
+ * - `SINGLY_LIST_DECLARE(Name, name, T)` / `DOUBLY_LIST_DECLARE(Name, name, T)`
+ *   declare the types and the prototypes, in a header.
+ *
+ * - `SINGLY_LIST_DEFINE(Name, name, T, EQ)` / `DOUBLY_LIST_DEFINE(Name, name, T, EQ)`
+ *   define the procedures, in a single translation unit. `EQ(a, b)` must be an
+ *   expression (a function-like macro or an inline function) telling whether two
+ *   elements are equal, it is only used by `lookup` and `search`.
+ *
+ * Generated types:
+ * - `Name##_Singly_List_Node { T val; next; }` and
+ *   `Name##_Singly_List { head; tail; len; pool; }`.
+ * - `Name##_Doubly_List_Node { T val; prev; next; }` and
+ *   `Name##_Doubly_List { head; tail; count; pool; }`.
+ *
+ * Generated procedures, with the semantics of their `singly_list_*` and `doubly_list_*`
+ * counterparts:
+ *
+ * ```c
+ * void   name##_singly_list_init(List* list);
+ * void   name##_singly_list_init_pooled(List* list, Node_Pool* pool);
+ * void   name##_singly_list_free(List* list);
+ * size_t name##_singly_list_len(List* list);
+ * void   name##_singly_list_push_front(List* list, T val);
+ * void   name##_singly_list_append(List* list, T val);
+ * bool   name##_singly_list_insert(List* list, size_t idx, T val);
+ * bool   name##_singly_list_remove(List* list, size_t idx, T* removed_val);
+ * bool   name##_singly_list_lookup(List* list, T needle_val, size_t* found_idx);
+ * bool   name##_singly_list_get(List* list, size_t idx, T* get_val);
+ *
+ * void   name##_doubly_list_init(List* list);
+ * void   name##_doubly_list_init_pooled(List* list, Node_Pool* pool);
+ * void   name##_doubly_list_free(List* list);
+ * size_t name##_doubly_list_count(List* list);
+ * void   name##_doubly_list_insert_head(List* list, T val);
+ * void   name##_doubly_list_insert_tail(List* list, T val);
+ * bool   name##_doubly_list_insert(List* list, size_t idx, T val);
+ * bool   name##_doubly_list_remove_head(List* list, T* removed_val);
+ * bool   name##_doubly_list_remove_tail(List* list, T* removed_val);
+ * bool   name##_doubly_list_remove(List* list, size_t idx, T* removed_val);
+ * bool   name##_doubly_list_search(List* list, T needle_val, size_t* found_idx);
+ * bool   name##_doubly_list_get(List* list, size_t idx, T* get_val);
+ * bool   name##_doubly_list_set(List* list, size_t idx, T new_val);
+ * ```
+ *
+ * Example:
+ *
+ * ```c
+ * typedef struct Point { float x, y; } Point;
+ * #define POINT_EQ(a, b) ((a).x == (b).x && (a).y == (b).y)
+ *
+ * DOUBLY_LIST_DECLARE(Point, point, Point)
+ * DOUBLY_LIST_DEFINE(Point, point, Point, POINT_EQ)
+ *
+ * Point_Doubly_List list;
+ * point_doubly_list_init(&list);
+ * point_doubly_list_insert_tail(&list, (Point) { 1.0f, 2.0f });
+ * point_doubly_list_free(&list);
+ * ```
+ *
+ * Notes:
+ * - Elements are stored by value in the nodes, a pooled list needs a pool initialized
+ *   with a node size of `sizeof(Name##_Singly_List_Node)` or `sizeof(Name##_Doubly_List_Node)`.
+ * - `LIST_TEMPLATE_DEFAULT_EQ` compares elements with `==`.
+ */
+#define LIST_TEMPLATE_DEFAULT_EQ(a, b) ((a) == (b))
+
+#define SINGLY_LIST_DECLARE(Name, name, T)                                                                \
+    typedef struct Name##_Singly_List_Node {                                                              \
+        T val;                                                                                            \
+        struct Name##_Singly_List_Node* next;                                                             \
+    } Name##_Singly_List_Node;                                                                            \
+                                                                                                          \
+    typedef struct Name##_Singly_List {                                                                   \
+        Name##_Singly_List_Node* head;                                                                    \
+        Name##_Singly_List_Node* tail;                                                                    \
+        size_t                   len;                                                                     \
+        Node_Pool*               pool;                                                                    \
+    } Name##_Singly_List;                                                                                 \
+                                                                                                          \
+    void   name##_singly_list_init(Name##_Singly_List* list);                                             \
+    void   name##_singly_list_init_pooled(Name##_Singly_List* list, Node_Pool* pool);                     \
+    void   name##_singly_list_free(Name##_Singly_List* list);                                             \
+    size_t name##_singly_list_len(Name##_Singly_List* list);                                              \
+    void   name##_singly_list_push_front(Name##_Singly_List* list, T val);                                \
+    void   name##_singly_list_append(Name##_Singly_List* list, T val);                                    \
+    bool   name##_singly_list_insert(Name##_Singly_List* list, size_t idx, T val);                        \
+    bool   name##_singly_list_remove(Name##_Singly_List* list, size_t idx, T* removed_val);               \
+    bool   name##_singly_list_lookup(Name##_Singly_List* list, T needle_val, size_t* found_idx);          \
+    bool   name##_singly_list_get(Name##_Singly_List* list, size_t idx, T* get_val);
+
+#define SINGLY_LIST_DEFINE(Name, name, T, EQ)                                                             \
+    static Name##_Singly_List_Node* name##_singly_list_node_new(Name##_Singly_List* list, T val,          \
+                                                                Name##_Singly_List_Node* next) {          \
+        Name##_Singly_List_Node* node =                                                                   \
+            list->pool != NULL ? (Name##_Singly_List_Node*) node_pool_alloc(list->pool)                   \
+                               : (Name##_Singly_List_Node*) malloc(sizeof(Name##_Singly_List_Node));      \
+        assert(node != NULL && "Unable to allocate more memory.");                                        \
+        node->val  = val;                                                                                 \
+        node->next = next;                                                                                \
+        return node;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    static void name##_singly_list_node_release(Name##_Singly_List* list, Name##_Singly_List_Node* node) { \
+        if (list->pool != NULL) {                                                                         \
+            node_pool_release(list->pool, node);                                                          \
+        } else {                                                                                          \
+            free(node);                                                                                   \
+        }                                                                                                 \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_singly_list_init(Name##_Singly_List* list) {                                              \
+        name##_singly_list_init_pooled(list, NULL);                                                       \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_singly_list_init_pooled(Name##_Singly_List* list, Node_Pool* pool) {                      \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        list->head = NULL;                                                                                \
+        list->tail = NULL;                                                                                \
+        list->len  = 0;                                                                                   \
+        list->pool = pool;                                                                                \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_singly_list_free(Name##_Singly_List* list) {                                              \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        Name##_Singly_List_Node* node = list->head;                                                       \
+        while (node != NULL) {                                                                            \
+            Name##_Singly_List_Node* next = node->next;                                                   \
+            name##_singly_list_node_release(list, node);                                                  \
+            node = next;                                                                                  \
+        }                                                                                                 \
+        list->head = NULL;                                                                                \
+        list->tail = NULL;                                                                                \
+        list->len  = 0;                                                                                   \
+    }                                                                                                     \
+                                                                                                          \
+    size_t name##_singly_list_len(Name##_Singly_List* list) {                                             \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        return list->len;                                                                                 \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_singly_list_push_front(Name##_Singly_List* list, T val) {                                 \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        list->head = name##_singly_list_node_new(list, val, list->head);                                  \
+        if (list->tail == NULL) {                                                                         \
+            list->tail = list->head;                                                                      \
+        }                                                                                                 \
+        list->len++;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_singly_list_append(Name##_Singly_List* list, T val) {                                     \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        Name##_Singly_List_Node* node = name##_singly_list_node_new(list, val, NULL);                     \
+        if (list->tail == NULL) {                                                                         \
+            list->head = node;                                                                            \
+        } else {                                                                                          \
+            list->tail->next = node;                                                                      \
+        }                                                                                                 \
+        list->tail = node;                                                                                \
+        list->len++;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_singly_list_insert(Name##_Singly_List* list, size_t idx, T val) {                         \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        if (idx > list->len) {                                                                            \
+            return false;                                                                                 \
+        }                                                                                                 \
+        if (idx == 0) {                                                                                   \
+            name##_singly_list_push_front(list, val);                                                     \
+            return true;                                                                                  \
+        }                                                                                                 \
+        if (idx == list->len) {                                                                           \
+            name##_singly_list_append(list, val);                                                         \
+            return true;                                                                                  \
+        }                                                                                                 \
+        Name##_Singly_List_Node* prev = list->head;                                                       \
+        for (size_t i = 1; i < idx; i++) {                                                                \
+            prev = prev->next;                                                                            \
+        }                                                                                                 \
+        prev->next = name##_singly_list_node_new(list, val, prev->next);                                  \
+        list->len++;                                                                                      \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_singly_list_remove(Name##_Singly_List* list, size_t idx, T* removed_val) {                \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        if (idx >= list->len) {                                                                           \
+            return false;                                                                                 \
+        }                                                                                                 \
+        Name##_Singly_List_Node* prev = NULL;                                                             \
+        Name##_Singly_List_Node* node = list->head;                                                       \
+        for (size_t i = 0; i < idx; i++) {                                                                \
+            prev = node;                                                                                  \
+            node = node->next;                                                                            \
+        }                                                                                                 \
+        if (prev == NULL) {                                                                               \
+            list->head = node->next;                                                                      \
+        } else {                                                                                          \
+            prev->next = node->next;                                                                      \
+        }                                                                                                 \
+        if (list->tail == node) {                                                                         \
+            list->tail = prev;                                                                            \
+        }                                                                                                 \
+        if (removed_val != NULL) {                                                                        \
+            *removed_val = node->val;                                                                     \
+        }                                                                                                 \
+        name##_singly_list_node_release(list, node);                                                      \
+        list->len--;                                                                                      \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_singly_list_lookup(Name##_Singly_List* list, T needle_val, size_t* found_idx) {           \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        assert(found_idx != NULL && "Found index pointer is NULL.");                                      \
+        size_t idx = 0;                                                                                   \
+        for (Name##_Singly_List_Node* node = list->head; node != NULL; node = node->next, idx++) {        \
+            if (EQ(node->val, needle_val)) {                                                              \
+                *found_idx = idx;                                                                         \
+                return true;                                                                              \
+            }                                                                                             \
+        }                                                                                                 \
+        return false;                                                                                     \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_singly_list_get(Name##_Singly_List* list, size_t idx, T* get_val) {                       \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        assert(get_val != NULL && "Get value pointer is NULL.");                                          \
+        if (idx >= list->len) {                                                                           \
+            return false;                                                                                 \
+        }                                                                                                 \
+        Name##_Singly_List_Node* node = list->tail;                                                       \
+        if (idx != list->len - 1) {                                                                       \
+            node = list->head;                                                                            \
+            for (size_t i = 0; i < idx; i++) {                                                            \
+                node = node->next;                                                                        \
+            }                                                                                             \
+        }                                                                                                 \
+        *get_val = node->val;                                                                             \
+        return true;                                                                                      \
+    }
+
+#define DOUBLY_LIST_DECLARE(Name, name, T)                                                                \
+    typedef struct Name##_Doubly_List_Node {                                                              \
+        T val;                                                                                            \
+        struct Name##_Doubly_List_Node* prev;                                                             \
+        struct Name##_Doubly_List_Node* next;                                                             \
+    } Name##_Doubly_List_Node;                                                                            \
+                                                                                                          \
+    typedef struct Name##_Doubly_List {                                                                   \
+        Name##_Doubly_List_Node* head;                                                                    \
+        Name##_Doubly_List_Node* tail;                                                                    \
+        size_t                   count;                                                                   \
+        Node_Pool*               pool;                                                                    \
+    } Name##_Doubly_List;                                                                                 \
+                                                                                                          \
+    void   name##_doubly_list_init(Name##_Doubly_List* list);                                             \
+    void   name##_doubly_list_init_pooled(Name##_Doubly_List* list, Node_Pool* pool);                     \
+    void   name##_doubly_list_free(Name##_Doubly_List* list);                                             \
+    size_t name##_doubly_list_count(Name##_Doubly_List* list);                                            \
+    void   name##_doubly_list_insert_head(Name##_Doubly_List* list, T val);                               \
+    void   name##_doubly_list_insert_tail(Name##_Doubly_List* list, T val);                               \
+    bool   name##_doubly_list_insert(Name##_Doubly_List* list, size_t idx, T val);                        \
+    bool   name##_doubly_list_remove_head(Name##_Doubly_List* list, T* removed_val);                      \
+    bool   name##_doubly_list_remove_tail(Name##_Doubly_List* list, T* removed_val);                      \
+    bool   name##_doubly_list_remove(Name##_Doubly_List* list, size_t idx, T* removed_val);               \
+    bool   name##_doubly_list_search(Name##_Doubly_List* list, T needle_val, size_t* found_idx);          \
+    bool   name##_doubly_list_get(Name##_Doubly_List* list, size_t idx, T* get_val);                      \
+    bool   name##_doubly_list_set(Name##_Doubly_List* list, size_t idx, T new_val);
+
+#define DOUBLY_LIST_DEFINE(Name, name, T, EQ)                                                             \
+    /* Links a new node holding `val` between `prev` and `next`, either may be NULL at an end. */         \
+    static void name##_doubly_list_link(Name##_Doubly_List* list, T val, Name##_Doubly_List_Node* prev,   \
+                                        Name##_Doubly_List_Node* next) {                                  \
+        Name##_Doubly_List_Node* node =                                                                   \
+            list->pool != NULL ? (Name##_Doubly_List_Node*) node_pool_alloc(list->pool)                   \
+                               : (Name##_Doubly_List_Node*) malloc(sizeof(Name##_Doubly_List_Node));      \
+        assert(node != NULL && "Unable to allocate more memory.");                                        \
+        node->val  = val;                                                                                 \
+        node->prev = prev;                                                                                \
+        node->next = next;                                                                                \
+        if (prev != NULL) {                                                                               \
+            prev->next = node;                                                                            \
+        } else {                                                                                          \
+            list->head = node;                                                                            \
+        }                                                                                                 \
+        if (next != NULL) {                                                                               \
+            next->prev = node;                                                                            \
+        } else {                                                                                          \
+            list->tail = node;                                                                            \
+        }                                                                                                 \
+        list->count++;                                                                                    \
+    }                                                                                                     \
+                                                                                                          \
+    static void name##_doubly_list_unlink(Name##_Doubly_List* list, Name##_Doubly_List_Node* node,        \
+                                          T* removed_val) {                                               \
+        if (node->prev != NULL) {                                                                         \
+            node->prev->next = node->next;                                                                \
+        } else {                                                                                          \
+            list->head = node->next;                                                                      \
+        }                                                                                                 \
+        if (node->next != NULL) {                                                                         \
+            node->next->prev = node->prev;                                                                \
+        } else {                                                                                          \
+            list->tail = node->prev;                                                                      \
+        }                                                                                                 \
+        if (removed_val != NULL) {                                                                        \
+            *removed_val = node->val;                                                                     \
+        }                                                                                                 \
+        if (list->pool != NULL) {                                                                         \
+            node_pool_release(list->pool, node);                                                          \
+        } else {                                                                                          \
+            free(node);                                                                                   \
+        }                                                                                                 \
+        list->count--;                                                                                    \
+    }                                                                                                     \
+                                                                                                          \
+    /* Walks from the nearer end, `idx` must be in range. */                                              \
+    static Name##_Doubly_List_Node* name##_doubly_list_node_at(Name##_Doubly_List* list, size_t idx) {    \
+        Name##_Doubly_List_Node* node;                                                                    \
+        if (idx < list->count / 2) {                                                                      \
+            node = list->head;                                                                            \
+            for (size_t i = 0; i < idx; i++) {                                                            \
+                node = node->next;                                                                        \
+            }                                                                                             \
+        } else {                                                                                          \
+            node = list->tail;                                                                            \
+            for (size_t i = list->count - 1; i > idx; i--) {                                              \
+                node = node->prev;                                                                        \
+            }                                                                                             \
+        }                                                                                                 \
+        return node;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_doubly_list_init(Name##_Doubly_List* list) {                                              \
+        name##_doubly_list_init_pooled(list, NULL);                                                       \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_doubly_list_init_pooled(Name##_Doubly_List* list, Node_Pool* pool) {                      \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        list->head  = NULL;                                                                               \
+        list->tail  = NULL;                                                                               \
+        list->count = 0;                                                                                  \
+        list->pool  = pool;                                                                               \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_doubly_list_free(Name##_Doubly_List* list) {                                              \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        while (list->head != NULL) {                                                                      \
+            name##_doubly_list_unlink(list, list->head, NULL);                                            \
+        }                                                                                                 \
+    }                                                                                                     \
+                                                                                                          \
+    size_t name##_doubly_list_count(Name##_Doubly_List* list) {                                           \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        return list->count;                                                                               \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_doubly_list_insert_head(Name##_Doubly_List* list, T val) {                                \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        name##_doubly_list_link(list, val, NULL, list->head);                                             \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_doubly_list_insert_tail(Name##_Doubly_List* list, T val) {                                \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        name##_doubly_list_link(list, val, list->tail, NULL);                                             \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_doubly_list_insert(Name##_Doubly_List* list, size_t idx, T val) {                         \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        if (idx > list->count) {                                                                          \
+            return false;                                                                                 \
+        }                                                                                                 \
+        if (idx == list->count) {                                                                         \
+            name##_doubly_list_link(list, val, list->tail, NULL);                                         \
+        } else {                                                                                          \
+            Name##_Doubly_List_Node* next = name##_doubly_list_node_at(list, idx);                        \
+            name##_doubly_list_link(list, val, next->prev, next);                                         \
+        }                                                                                                 \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_doubly_list_remove_head(Name##_Doubly_List* list, T* removed_val) {                       \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        if (list->head == NULL) {                                                                         \
+            return false;                                                                                 \
+        }                                                                                                 \
+        name##_doubly_list_unlink(list, list->head, removed_val);                                         \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_doubly_list_remove_tail(Name##_Doubly_List* list, T* removed_val) {                       \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        if (list->tail == NULL) {                                                                         \
+            return false;                                                                                 \
+        }                                                                                                 \
+        name##_doubly_list_unlink(list, list->tail, removed_val);                                         \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_doubly_list_remove(Name##_Doubly_List* list, size_t idx, T* removed_val) {                \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        if (idx >= list->count) {                                                                         \
+            return false;                                                                                 \
+        }                                                                                                 \
+        name##_doubly_list_unlink(list, name##_doubly_list_node_at(list, idx), removed_val);              \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_doubly_list_search(Name##_Doubly_List* list, T needle_val, size_t* found_idx) {           \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        assert(found_idx != NULL && "Found index pointer is NULL.");                                      \
+        size_t idx = 0;                                                                                   \
+        for (Name##_Doubly_List_Node* node = list->head; node != NULL; node = node->next, idx++) {        \
+            if (EQ(node->val, needle_val)) {                                                              \
+                *found_idx = idx;                                                                         \
+                return true;                                                                              \
+            }                                                                                             \
+        }                                                                                                 \
+        return false;                                                                                     \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_doubly_list_get(Name##_Doubly_List* list, size_t idx, T* get_val) {                       \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        assert(get_val != NULL && "Get value pointer is NULL.");                                          \
+        if (idx >= list->count) {                                                                         \
+            return false;                                                                                 \
+        }                                                                                                 \
+        *get_val = name##_doubly_list_node_at(list, idx)->val;                                            \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_doubly_list_set(Name##_Doubly_List* list, size_t idx, T new_val) {                        \
+        assert(list != NULL && "Linked List handle is NULL.");                                            \
+        if (idx >= list->count) {                                                                         \
+            return false;                                                                                 \
+        }                                                                                                 \
+        name##_doubly_list_node_at(list, idx)->val = new_val;                                             \
+        return true;                                                                                      \
+    }
+
+#endif  // LIST_TEMPLATE_H
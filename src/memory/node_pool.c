@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+#include "node_pool.h"
+
+#define NODE_POOL_ALIGN alignof(max_align_t)
+
+static size_t align_up(size_t size, size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+void node_pool_init(Node_Pool* pool, size_t node_size, size_t nodes_per_slab) {
+    assert(pool != NULL && "Node pool is NULL.");
+    assert(node_size > 0 && "Node size is zero.");
+
+    if (node_size < sizeof(void*)) {
+        node_size = sizeof(void*);
+    }
+
+    pool->node_size      = align_up(node_size, sizeof(void*));
+    pool->nodes_per_slab = nodes_per_slab != 0 ? nodes_per_slab : NODE_POOL_DEFAULT_NODES_PER_SLAB;
+    pool->free_list      = NULL;
+    pool->slabs          = NULL;
+    pool->bump           = NULL;
+    pool->bump_end       = NULL;
+}
+
+static void node_pool_grow(Node_Pool* pool) {
+    size_t header_size = align_up(sizeof(Node_Pool_Slab), NODE_POOL_ALIGN);
+    Node_Pool_Slab* slab = (Node_Pool_Slab*) malloc(header_size + pool->node_size * pool->nodes_per_slab);
+    assert(slab != NULL && "Unable to allocate more memory.");
+
+    slab->next  = pool->slabs;
+    pool->slabs = slab;
+
+    pool->bump     = (unsigned char*) slab + header_size;
+    pool->bump_end = pool->bump + pool->node_size * pool->nodes_per_slab;
+}
+
+void* node_pool_alloc(Node_Pool* pool) {
+    assert(pool != NULL && "Node pool is NULL.");
+
+    if (pool->free_list != NULL) {
+        void* node = pool->free_list;
+        pool->free_list = *(void**) node;
+        return node;
+    }
+
+    if (pool->bump == pool->bump_end) {
+        node_pool_grow(pool);
+    }
+
+    void* node = pool->bump;
+    pool->bump += pool->node_size;
+    return node;
+}
+
+void* node_pool_alloc_array(Node_Pool* pool, size_t count) {
+    assert(pool != NULL && "Node pool is NULL.");
+
+    if (count == 0) {
+        return NULL;
+    }
+
+    // A dedicated slab, linked after the newest one so that the bump range of the
+    // newest slab stays in use.
+    size_t header_size = align_up(sizeof(Node_Pool_Slab), NODE_POOL_ALIGN);
+    Node_Pool_Slab* slab = (Node_Pool_Slab*) malloc(header_size + pool->node_size * count);
+    assert(slab != NULL && "Unable to allocate more memory.");
+
+    if (pool->slabs == NULL) {
+        slab->next  = NULL;
+        pool->slabs = slab;
+    } else {
+        slab->next        = pool->slabs->next;
+        pool->slabs->next = slab;
+    }
+
+    return (unsigned char*) slab + header_size;
+}
+
+void node_pool_release(Node_Pool* pool, void* node) {
+    assert(pool != NULL && "Node pool is NULL.");
+
+    if (node == NULL) {
+        return;
+    }
+
+    *(void**) node  = pool->free_list;
+    pool->free_list = node;
+}
+
+void node_pool_destroy(Node_Pool* pool) {
+    assert(pool != NULL && "Node pool is NULL.");
+
+    Node_Pool_Slab* slab = pool->slabs;
+    for (;slab != NULL;) {
+        Node_Pool_Slab* to_free = slab;
+        slab = slab->next;
+        free(to_free);
+    }
+
+    pool->free_list = NULL;
+    pool->slabs     = NULL;
+    pool->bump      = NULL;
+    pool->bump_end  = NULL;
+}
@@ -0,0 +1,131 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stddef.h>
+
+#define NODE_POOL_DEFAULT_NODES_PER_SLAB 4096
+
+/**
+ * @struct Node_Pool
+ * @brief Fixed size allocator handing out nodes from large contiguous slabs.
+ *
+ * Every node of a pool has the same size, which is set once by `node_pool_init`.
+ * Nodes are carved from slabs holding `nodes_per_slab` nodes each, a new slab is
+ * only allocated once every node of the previous ones has been handed out.
+ * Released nodes are pushed on an intrusive free list (the first bytes of a free
+ * node hold the pointer to the next free node) and are reused first.
+ *
+ * Fields:
+ * - `node_size`:
+ *   The size of a single node, rounded up so that every node is suitably aligned
+ *   and can hold the free list link.
+ *
+ * - `nodes_per_slab`:
+ *   The number of nodes allocated at once when the pool runs out of nodes.
+ *
+ * - `free_list`:
+ *   The last released node, `NULL` when no released node is waiting to be reused.
+ *
+ * - `slabs`:
+ *   The most recently allocated slab, each slab links to the previous one.
+ *
+ * - `bump` / `bump_end`:
+ *   The range of the newest slab that has never been handed out.
+ *
+ * Example:
+ *
+ * ```c
+ * Node_Pool pool;
+ * node_pool_init(&pool, sizeof(Singly_Linked_List_Node), 0);
+ *
+ * Singly_Linked_List_Node* head = singly_linked_list_new_pooled(&pool, 10);
+ * singly_linked_list_append_pooled(&pool, head, 20);
+ *
+ * // Releases every node of every list allocated from the pool at once.
+ * node_pool_destroy(&pool);
+ * ```
+ *
+ * Notes:
+ * - A pool is not thread safe.
+ * - Nodes allocated from a pool must never be passed to `free`, release them with
+ *   `node_pool_release` or drop them all with `node_pool_destroy`.
+ */
+typedef struct Node_Pool_Slab {
+    struct Node_Pool_Slab* next;
+} Node_Pool_Slab;
+
+typedef struct Node_Pool {
+    size_t          node_size;
+    size_t          nodes_per_slab;
+    void*           free_list;
+    Node_Pool_Slab* slabs;
+    unsigned char*  bump;
+    unsigned char*  bump_end;
+} Node_Pool;
+
+/**
+ * @brief Initializes an empty pool, no memory is allocated until the first node is requested.
+ *
+ * @param pool
+ *        The pool to initialize. Must not be `NULL`.
+ *
+ * @param node_size
+ *        The size of the nodes handed out by the pool, usually `sizeof` of the node type.
+ *
+ * @param nodes_per_slab
+ *        The number of nodes per slab, `0` selects `NODE_POOL_DEFAULT_NODES_PER_SLAB`.
+ */
+void node_pool_init(Node_Pool* pool, size_t node_size, size_t nodes_per_slab);
+
+/**
+ * @brief Hands out an uninitialized node.
+ *
+ * Performance:
+ * - Time complexity: O(1). A released node is popped from the free list, otherwise
+ *   the next node of the newest slab is used, a new slab is allocated once per
+ *   `nodes_per_slab` calls.
+ *
+ * Potential Errors:
+ * - Memory allocation failure of a new slab will cause an assertion error.
+ */
+void* node_pool_alloc(Node_Pool* pool);
+
+/**
+ * @brief Hands out `count` uninitialized nodes laid out contiguously, `node_size` bytes apart.
+ *
+ * Meant for bulk construction: building a whole structure from a single block keeps
+ * its nodes adjacent in memory and costs one allocation. The nodes belong to the
+ * pool like any other, each one can be released individually with `node_pool_release`.
+ *
+ * @return The first node of the block, `NULL` when `count` is `0`.
+ *
+ * Performance:
+ * - Time complexity: O(1), the block is allocated as a slab of its own.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void* node_pool_alloc_array(Node_Pool* pool, size_t count);
+
+/**
+ * @brief Gives a node back to the pool so that it can be reused by `node_pool_alloc`.
+ *
+ * @param node
+ *        A node previously returned by `node_pool_alloc` on the same pool, may be `NULL`.
+ *
+ * Performance:
+ * - Time complexity: O(1), the node is pushed on the free list.
+ */
+void node_pool_release(Node_Pool* pool, void* node);
+
+/**
+ * @brief Frees every slab of the pool, releasing all the nodes ever handed out at once.
+ *
+ * The pool is left empty and can be used again.
+ *
+ * Performance:
+ * - Time complexity: O(s), where `s` is the number of slabs.
+ */
+void node_pool_destroy(Node_Pool* pool);
+
+#endif  // NODE_POOL_H
@@ -0,0 +1,260 @@
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "export.h"
+
+// Longest formatted element: " -> " and "-2147483648".
+#define MAX_ELEMENT_SIZE 15
+
+static_assert(MAX_ELEMENT_SIZE <= EXPORT_MIN_BUFFER_SIZE, "A buffer holds at least one element.");
+
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+static void init_writer(Export_Writer* writer, Export_Format format, void* buffer, size_t capacity) {
+    assert(writer != NULL && "Export writer is NULL.");
+
+    writer->owns_buffer = buffer == NULL;
+    if (buffer == NULL) {
+        capacity = EXPORT_DEFAULT_BUFFER_SIZE;
+        buffer   = malloc(capacity);
+        assert(buffer != NULL && "Unable to allocate more memory.");
+    }
+    assert(capacity >= EXPORT_MIN_BUFFER_SIZE && "Export buffer is too small.");
+
+    writer->buffer    = (unsigned char*) buffer;
+    writer->capacity  = capacity;
+    writer->len       = 0;
+    writer->fd        = -1;
+    writer->on_chunk  = NULL;
+    writer->chunk_ctx = NULL;
+    writer->format    = format;
+    writer->count     = 0;
+    writer->failed    = false;
+}
+
+void export_writer_init_fd(Export_Writer* writer, int fd, Export_Format format, void* buffer, size_t capacity) {
+    init_writer(writer, format, buffer, capacity);
+    writer->fd = fd;
+}
+
+void export_writer_init_buffer(Export_Writer* writer, void* buffer, size_t capacity, Export_Format format,
+                               Export_Chunk_Fn on_chunk, void* chunk_ctx) {
+    assert(buffer != NULL && "Export buffer is NULL.");
+    init_writer(writer, format, buffer, capacity);
+    writer->on_chunk  = on_chunk;
+    writer->chunk_ctx = chunk_ctx;
+}
+
+// Hands the buffer to the sink and empties it. Returns false, with `failed` set, when
+// the sink fails or when a buffer sink without callback is full.
+static bool flush(Export_Writer* writer) {
+    if (writer->failed) {
+        return false;
+    }
+
+    if (writer->fd >= 0) {
+        size_t written = 0;
+        while (written < writer->len) {
+            ssize_t result = write(writer->fd, writer->buffer + written, writer->len - written);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) {
+                writer->failed = true;
+                return false;
+            }
+            written += (size_t) result;
+        }
+    } else if (writer->on_chunk != NULL) {
+        if (writer->len > 0 && !writer->on_chunk(writer->buffer, writer->len, writer->chunk_ctx)) {
+            writer->failed = true;
+            return false;
+        }
+    } else {
+        writer->failed = true;
+        return false;
+    }
+
+    writer->len = 0;
+    return true;
+}
+
+// Makes room for `size` bytes, at most the capacity. Returns false when the writer failed.
+static inline bool reserve(Export_Writer* writer, size_t size) {
+    return writer->len + size <= writer->capacity ? !writer->failed : flush(writer);
+}
+
+bool export_writer_finish(Export_Writer* writer) {
+    assert(writer != NULL && "Export writer is NULL.");
+
+    // A buffer sink without callback keeps its output in the buffer.
+    bool ok = writer->fd < 0 && writer->on_chunk == NULL ? !writer->failed : flush(writer);
+    if (writer->owns_buffer) {
+        free(writer->buffer);
+        writer->buffer   = NULL;
+        writer->capacity = 0;
+    }
+    return ok;
+}
+
+void export_bytes(Export_Writer* writer, const void* bytes, size_t size) {
+    assert(writer != NULL && "Export writer is NULL.");
+
+    const unsigned char* data = (const unsigned char*) bytes;
+    while (size > 0 && !writer->failed) {
+        if (writer->len == writer->capacity && !flush(writer)) {
+            return;
+        }
+        size_t chunk = writer->capacity - writer->len < size ? writer->capacity - writer->len : size;
+        memcpy(writer->buffer + writer->len, data, chunk);
+        writer->len += chunk;
+        data        += chunk;
+        size        -= chunk;
+    }
+}
+
+// Formats `val` in decimal at `out`, two digits per step, and returns its length.
+static inline size_t format_int(unsigned char* out, int val) {
+    unsigned char digits[11];
+    unsigned char* start = digits + sizeof(digits);
+    uint32_t magnitude = val < 0 ? 0u - (uint32_t) val : (uint32_t) val;
+    while (magnitude >= 100) {
+        uint32_t pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        start -= 2;
+        memcpy(start, digit_pairs + pair, 2);
+    }
+    if (magnitude >= 10) {
+        start -= 2;
+        memcpy(start, digit_pairs + magnitude * 2, 2);
+    } else {
+        *--start = (unsigned char) ('0' + magnitude);
+    }
+    if (val < 0) {
+        *--start = '-';
+    }
+
+    size_t len = (size_t) (digits + sizeof(digits) - start);
+    memcpy(out, start, len);
+    return len;
+}
+
+static inline void store_le32(unsigned char* out, int val) {
+    uint32_t bits = (uint32_t) val;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    bits = __builtin_bswap32(bits);
+#endif
+    memcpy(out, &bits, sizeof(bits));
+}
+
+// Formats `val` in the format of the writer at `out`, which has room for
+// `MAX_ELEMENT_SIZE` bytes, and returns its length.
+static inline size_t format_element(const Export_Writer* writer, unsigned char* out, int val) {
+    unsigned char* start = out;
+    switch (writer->format) {
+        case EXPORT_TEXT_LINES:
+            out += format_int(out, val);
+            *out++ = '\n';
+            break;
+        case EXPORT_TEXT_ARROWS:
+            if (writer->count > 0) {
+                memcpy(out, " -> ", 4);
+                out += 4;
+            }
+            out += format_int(out, val);
+            break;
+        case EXPORT_BINARY_LE32:
+            store_le32(out, val);
+            out += 4;
+            break;
+    }
+    return (size_t) (out - start);
+}
+
+void export_int(Export_Writer* writer, int val) {
+    assert(writer != NULL && "Export writer is NULL.");
+
+    if (writer->failed) {
+        return;
+    }
+
+    if (writer->len + MAX_ELEMENT_SIZE <= writer->capacity) {
+        writer->len += format_element(writer, writer->buffer + writer->len, val);
+    } else {
+        // Near the end of the buffer, the element is formatted aside so that only its
+        // actual size is reserved: a buffer sink without callback is filled to the last byte.
+        unsigned char element[MAX_ELEMENT_SIZE];
+        size_t size = format_element(writer, element, val);
+        if (!reserve(writer, size)) {
+            return;
+        }
+        memcpy(writer->buffer + writer->len, element, size);
+        writer->len += size;
+    }
+    writer->count += 1;
+}
+
+void export_ints(Export_Writer* writer, const int* vals, size_t n) {
+    assert(writer != NULL && "Export writer is NULL.");
+    assert((vals != NULL || n == 0) && "Values array is NULL.");
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // The values are already in their binary layout, copied a buffer at a time.
+    if (writer->format == EXPORT_BINARY_LE32) {
+        export_bytes(writer, vals, n * sizeof(int32_t));
+        writer->count += n;
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; i += 1) {
+        export_int(writer, vals[i]);
+    }
+}
+
+void export_singly_linked_list(Export_Writer* writer, const Singly_Linked_List_Node* linked_list_head) {
+    for (const Singly_Linked_List_Node* node = linked_list_head; node != NULL; node = node->next) {
+        export_int(writer, node->val);
+    }
+}
+
+void export_doubly_linked_list(Export_Writer* writer, const Doubly_Linked_List_Node* linked_list_head) {
+    for (const Doubly_Linked_List_Node* node = linked_list_head; node != NULL; node = node->next) {
+        export_int(writer, node->val);
+    }
+}
+
+void export_doubly_linked_list_backward(Export_Writer* writer, const Doubly_Linked_List_Node* linked_list_head) {
+    if (linked_list_head == NULL) {
+        return;
+    }
+
+    const Doubly_Linked_List_Node* node = linked_list_head;
+    while (node->next != NULL) {
+        node = node->next;
+    }
+    for (; node != NULL; node = node->prev) {
+        export_int(writer, node->val);
+    }
+}
+
+void export_singly_list(Export_Writer* writer, const Singly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    export_singly_linked_list(writer, list->head);
+}
+
+void export_doubly_list(Export_Writer* writer, const Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (list->reversed) {
+        for (const Doubly_Linked_List_Node* node = list->tail; node != NULL; node = node->prev) {
+            export_int(writer, node->val);
+        }
+    } else {
+        export_doubly_linked_list(writer, list->head);
+    }
+}
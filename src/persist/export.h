@@ -0,0 +1,148 @@
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "linkedlist.h"
+
+// Size of the buffer a writer allocates when the caller does not provide one.
+#define EXPORT_DEFAULT_BUFFER_SIZE ((size_t) 1 << 16)
+
+// Smallest buffer a writer accepts: one formatted element and its separator.
+#define EXPORT_MIN_BUFFER_SIZE 16
+
+typedef enum Export_Format {
+    // One decimal value per line, each followed by '\n'.
+    EXPORT_TEXT_LINES,
+    // Decimal values separated by " -> ", the format of the `_print` procedures.
+    EXPORT_TEXT_ARROWS,
+    // Raw 32-bit little-endian two's complement values, whatever the host byte order.
+    EXPORT_BINARY_LE32,
+} Export_Format;
+
+/**
+ * @brief Receives the buffer of a writer each time it is full, and once more on
+ *        `export_writer_finish`. Returns `false` to fail the export.
+ */
+typedef bool (*Export_Chunk_Fn)(const void* chunk, size_t size, void* ctx);
+
+/**
+ * @struct Export_Writer
+ * @brief Streams the values of lists or arrays to a file descriptor or a caller
+ *        buffer, in text or binary, through one fixed size buffer.
+ *
+ * Printing a list with one `printf` per node spends most of its time parsing the
+ * format and locking the stream. A writer formats the values itself, two digits at
+ * a time, into its buffer and hands the buffer to its sink each time it is full: a
+ * `write` to the file descriptor, or the chunk callback. The memory used is the
+ * buffer, whatever the number of elements.
+ *
+ * Fields:
+ * - `buffer`, `capacity`, `len`:
+ *   The buffer, its size and the number of bytes waiting in it.
+ *
+ * - `owns_buffer`:
+ *   Whether the buffer was allocated by the writer, and is freed by `export_writer_finish`.
+ *
+ * - `fd`:
+ *   The file descriptor to write to, `-1` for a buffer sink.
+ *
+ * - `on_chunk`, `chunk_ctx`:
+ *   The callback of a buffer sink, `NULL` when the whole output has to fit in the buffer.
+ *
+ * - `format`:
+ *   The `Export_Format` of the values.
+ *
+ * - `count`:
+ *   The number of values written so far.
+ *
+ * - `failed`:
+ *   Set by the first failed write, callback or buffer overflow. Every following
+ *   write is dropped, the failure is reported by `export_writer_finish`.
+ *
+ * Example:
+ *
+ * ```c
+ * Export_Writer writer;
+ * export_writer_init_fd(&writer, STDOUT_FILENO, EXPORT_TEXT_LINES, NULL, 0);
+ * export_doubly_list(&writer, &list);
+ * if (!export_writer_finish(&writer)) {
+ *     perror("export");
+ * }
+ * ```
+ *
+ * Notes:
+ * - Output written through `stdio` to the same descriptor must be flushed first,
+ *   the writer bypasses the `FILE` buffer.
+ */
+typedef struct Export_Writer {
+    unsigned char*  buffer;
+    size_t          capacity;
+    size_t          len;
+    bool            owns_buffer;
+    int             fd;
+    Export_Chunk_Fn on_chunk;
+    void*           chunk_ctx;
+    Export_Format   format;
+    size_t          count;
+    bool            failed;
+} Export_Writer;
+
+/**
+ * @brief Initializes a writer to the file descriptor `fd`.
+ *
+ * @param buffer
+ *        The buffer to format into, of `capacity` bytes (at least
+ *        `EXPORT_MIN_BUFFER_SIZE`), or `NULL` for an `EXPORT_DEFAULT_BUFFER_SIZE`
+ *        buffer allocated by the writer.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ */
+void export_writer_init_fd(Export_Writer* writer, int fd, Export_Format format, void* buffer, size_t capacity);
+
+/**
+ * @brief Initializes a writer to the caller buffer `buffer` of `capacity` bytes.
+ *
+ * @param on_chunk
+ *        Called with the buffer each time it is full, after which it is reused: the
+ *        output is streamed in chunks of at most `capacity` bytes. When `NULL`, the
+ *        whole output must fit in the buffer, where it is left, `writer.len` bytes long.
+ */
+void export_writer_init_buffer(Export_Writer* writer, void* buffer, size_t capacity, Export_Format format,
+                               Export_Chunk_Fn on_chunk, void* chunk_ctx);
+
+/**
+ * @brief Writes what is left in the buffer and releases the buffer allocated by the writer.
+ *
+ * @return
+ *        `true` if every byte was written, `false` after a failed write or callback,
+ *        or an overflow of a buffer sink without callback.
+ */
+bool export_writer_finish(Export_Writer* writer);
+
+// Writes raw bytes, which count as no value: headers, prefixes or line breaks.
+void export_bytes(Export_Writer* writer, const void* bytes, size_t size);
+
+// Writes one value, or the `n` values of `vals`.
+void export_int(Export_Writer* writer, int val);
+void export_ints(Export_Writer* writer, const int* vals, size_t n);
+
+/**
+ * @brief Writes the values of a chain of nodes, from `linked_list_head` to the end,
+ *        or from the end back to `linked_list_head` for `_backward`.
+ *
+ * Performance:
+ * - Time complexity: O(n), with one system call per buffer.
+ */
+void export_singly_linked_list(Export_Writer* writer, const Singly_Linked_List_Node* linked_list_head);
+void export_doubly_linked_list(Export_Writer* writer, const Doubly_Linked_List_Node* linked_list_head);
+void export_doubly_linked_list_backward(Export_Writer* writer, const Doubly_Linked_List_Node* linked_list_head);
+
+// Writes the values of a list handle in its logical order, reversed or not.
+void export_singly_list(Export_Writer* writer, const Singly_List* list);
+void export_doubly_list(Export_Writer* writer, const Doubly_List* list);
+
+#endif  // EXPORT_H
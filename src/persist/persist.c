@@ -0,0 +1,434 @@
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "persist.h"
+
+static_assert(sizeof(Persist_Header) == 64, "The header is 64 bytes.");
+static_assert(sizeof(Persist_Singly_Node) % 8 == 0 && sizeof(Persist_Doubly_Node) % 8 == 0
+              && sizeof(Persist_Rb_Node) % 8 == 0, "The checksum reads the nodes 8 bytes at a time.");
+
+#define PERSIST_CHECKSUM_SEED 0xcbf29ce484222325ull
+
+// Offset of the first node, right after the header.
+#define NODES_OFFSET ((uint64_t) sizeof(Persist_Header))
+
+static size_t node_size(Persist_Kind kind) {
+    switch (kind) {
+        case PERSIST_SINGLY_LIST: return sizeof(Persist_Singly_Node);
+        case PERSIST_DOUBLY_LIST: return sizeof(Persist_Doubly_Node);
+        case PERSIST_RB_TREE:     return sizeof(Persist_Rb_Node);
+    }
+    return 0;
+}
+
+const char* persist_result_name(Persist_Result result) {
+    switch (result) {
+        case PERSIST_OK:           return "ok";
+        case PERSIST_IO_ERROR:     return "i/o error";
+        case PERSIST_BAD_MAGIC:    return "not a saved structure";
+        case PERSIST_BAD_VERSION:  return "unsupported version";
+        case PERSIST_BAD_KIND:     return "unexpected kind of structure";
+        case PERSIST_BAD_SIZE:     return "file size does not match the header";
+        case PERSIST_BAD_CHECKSUM: return "checksum mismatch";
+        case PERSIST_BAD_OFFSET:   return "link to a non node offset";
+    }
+    return "unknown";
+}
+
+static inline uint64_t checksum_step(uint64_t hash, uint64_t word) {
+    hash ^= word * 0x9e3779b97f4a7c15ull;
+    hash  = (hash << 27) | (hash >> 37);
+    return hash * 0x100000001b3ull;
+}
+
+static uint64_t checksum_update(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*) data;
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = checksum_step(hash, word);
+    }
+    return hash;
+}
+
+uint64_t persist_checksum(const void* data, size_t size) {
+    assert(size % 8 == 0 && "Checksummed size is not a multiple of 8.");
+    return checksum_update(PERSIST_CHECKSUM_SEED, data, size);
+}
+
+// ========= writing =========
+
+// Streams the nodes of a file after a header written last, once the checksum is known.
+typedef struct Persist_Writer {
+    FILE*          file;
+    Persist_Header header;
+    bool           failed;
+} Persist_Writer;
+
+static bool writer_open(Persist_Writer* writer, const char* path, Persist_Kind kind, size_t count) {
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        return false;
+    }
+    memset(&writer->header, 0, sizeof(writer->header));
+    writer->header.magic     = PERSIST_MAGIC;
+    writer->header.version   = PERSIST_VERSION;
+    writer->header.kind      = (uint16_t) kind;
+    writer->header.count     = count;
+    writer->header.file_size = NODES_OFFSET + (uint64_t) count * node_size(kind);
+    writer->header.checksum  = PERSIST_CHECKSUM_SEED;
+    writer->failed = fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1;
+    return true;
+}
+
+static void writer_put(Persist_Writer* writer, const void* node, size_t size) {
+    writer->header.checksum = checksum_update(writer->header.checksum, node, size);
+    writer->failed = writer->failed || fwrite(node, size, 1, writer->file) != 1;
+}
+
+static Persist_Result writer_close(Persist_Writer* writer) {
+    bool failed = writer->failed
+        || fseek(writer->file, 0, SEEK_SET) != 0
+        || fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1;
+    failed = fclose(writer->file) != 0 || failed;
+    return failed ? PERSIST_IO_ERROR : PERSIST_OK;
+}
+
+Persist_Result persist_save_singly_list(const char* path, Singly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    Persist_Writer writer;
+    if (!writer_open(&writer, path, PERSIST_SINGLY_LIST, list->len)) {
+        return PERSIST_IO_ERROR;
+    }
+    if (list->len > 0) {
+        writer.header.first = NODES_OFFSET;
+        writer.header.last  = NODES_OFFSET + (list->len - 1) * sizeof(Persist_Singly_Node);
+    }
+
+    uint64_t offset = NODES_OFFSET;
+    for (Singly_Linked_List_Node* node = list->head; node != NULL; node = node->next) {
+        offset += sizeof(Persist_Singly_Node);
+        Persist_Singly_Node record = {
+            .next     = node->next != NULL ? offset : 0,
+            .val      = node->val,
+            .reserved = 0,
+        };
+        writer_put(&writer, &record, sizeof(record));
+    }
+    return writer_close(&writer);
+}
+
+Persist_Result persist_save_doubly_list(const char* path, Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    Persist_Writer writer;
+    if (!writer_open(&writer, path, PERSIST_DOUBLY_LIST, list->count)) {
+        return PERSIST_IO_ERROR;
+    }
+    if (list->count > 0) {
+        writer.header.first = NODES_OFFSET;
+        writer.header.last  = NODES_OFFSET + (list->count - 1) * sizeof(Persist_Doubly_Node);
+    }
+
+    uint64_t offset = NODES_OFFSET;
+    Doubly_Linked_List_Node* node = list->reversed ? list->tail : list->head;
+    while (node != NULL) {
+        Doubly_Linked_List_Node* next = list->reversed ? node->prev : node->next;
+        Persist_Doubly_Node record = {
+            .prev     = offset != NODES_OFFSET ? offset - sizeof(Persist_Doubly_Node) : 0,
+            .next     = next != NULL ? offset + sizeof(Persist_Doubly_Node) : 0,
+            .val      = node->val,
+            .reserved = 0,
+        };
+        writer_put(&writer, &record, sizeof(record));
+        offset += sizeof(Persist_Doubly_Node);
+        node = next;
+    }
+    return writer_close(&writer);
+}
+
+typedef struct Rb_Queue_Entry {
+    Rb_Node* node;
+    uint64_t parent_offset;
+} Rb_Queue_Entry;
+
+Persist_Result persist_save_rb_tree(const char* path, Rb_Node* root) {
+    Persist_Writer writer;
+    if (!writer_open(&writer, path, PERSIST_RB_TREE, 0)) {
+        return PERSIST_IO_ERROR;
+    }
+
+    // Breadth-first: the children of the `i`-th node are queued when it is written, so
+    // their offsets follow from the number of nodes queued so far. The queue grows as
+    // needed rather than counting the nodes first, which would walk the tree twice.
+    size_t capacity = 1024;
+    size_t queued   = 0;
+    Rb_Queue_Entry* queue = (Rb_Queue_Entry*) malloc(capacity * sizeof(Rb_Queue_Entry));
+    if (queue == NULL) {
+        printf("Unable to allocate memory for the tree queue.");
+        exit(1);
+    }
+    if (root != NULL) {
+        queue[queued++] = (Rb_Queue_Entry) { .node = root, .parent_offset = 0 };
+    }
+    for (size_t i = 0; i < queued; i += 1) {
+        if (queued + 2 > capacity) {
+            capacity *= 2;
+            queue = (Rb_Queue_Entry*) realloc(queue, capacity * sizeof(Rb_Queue_Entry));
+            if (queue == NULL) {
+                printf("Unable to allocate memory for the tree queue.");
+                exit(1);
+            }
+        }
+        Rb_Node* node = queue[i].node;
+        uint64_t offset = NODES_OFFSET + i * sizeof(Persist_Rb_Node);
+        Persist_Rb_Node record;
+        memset(&record, 0, sizeof(record));
+        record.parent = queue[i].parent_offset;
+        record.value  = (uint64_t) (uintptr_t) node->value;
+        record.key    = node->key;
+        record.count  = node->count;
+        record.color  = node->color;
+        if (node->left != NULL) {
+            record.left = NODES_OFFSET + queued * sizeof(Persist_Rb_Node);
+            queue[queued++] = (Rb_Queue_Entry) { .node = node->left, .parent_offset = offset };
+        }
+        if (node->right != NULL) {
+            record.right = NODES_OFFSET + queued * sizeof(Persist_Rb_Node);
+            queue[queued++] = (Rb_Queue_Entry) { .node = node->right, .parent_offset = offset };
+        }
+        writer_put(&writer, &record, sizeof(record));
+    }
+    free(queue);
+
+    writer.header.count     = queued;
+    writer.header.first     = queued > 0 ? NODES_OFFSET : 0;
+    writer.header.file_size = NODES_OFFSET + queued * sizeof(Persist_Rb_Node);
+    return writer_close(&writer);
+}
+
+// ========= mapping =========
+
+Persist_Result persist_map(Persist_Image* image, const char* path, Persist_Kind kind, bool copy_on_write) {
+    assert(image != NULL && "Persist image is NULL.");
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return PERSIST_IO_ERROR;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return PERSIST_IO_ERROR;
+    }
+    size_t size = (size_t) st.st_size;
+    if (size < sizeof(Persist_Header)) {
+        close(fd);
+        return PERSIST_BAD_SIZE;
+    }
+
+    int prot  = copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+    int flags = copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+    void* base = mmap(NULL, size, prot, flags, fd, 0);
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (base == MAP_FAILED) {
+        return PERSIST_IO_ERROR;
+    }
+
+    const Persist_Header* header = (const Persist_Header*) base;
+    Persist_Result result = PERSIST_OK;
+    if (header->magic != PERSIST_MAGIC) {
+        result = PERSIST_BAD_MAGIC;
+    } else if (header->version != PERSIST_VERSION) {
+        result = PERSIST_BAD_VERSION;
+    } else if (header->kind != (uint16_t) kind) {
+        result = PERSIST_BAD_KIND;
+    } else if (header->file_size != size
+               || header->count > (size - NODES_OFFSET) / node_size(kind)
+               || NODES_OFFSET + header->count * node_size(kind) != size) {
+        result = PERSIST_BAD_SIZE;
+    }
+    if (result != PERSIST_OK) {
+        munmap(base, size);
+        return result;
+    }
+
+    image->base     = (unsigned char*) base;
+    image->size     = size;
+    image->writable = copy_on_write;
+    return PERSIST_OK;
+}
+
+void persist_unmap(Persist_Image* image) {
+    assert(image != NULL && "Persist image is NULL.");
+    munmap(image->base, image->size);
+    image->base = NULL;
+    image->size = 0;
+}
+
+static bool is_node_offset(const Persist_Image* image, uint64_t offset, size_t size) {
+    return offset == 0 || (offset >= NODES_OFFSET && offset < image->size && (offset - NODES_OFFSET) % size == 0);
+}
+
+Persist_Result persist_verify(Persist_Image* image) {
+    assert(image != NULL && "Persist image is NULL.");
+    const Persist_Header* header = persist_header(image);
+    if (persist_checksum(image->base + NODES_OFFSET, image->size - NODES_OFFSET) != header->checksum) {
+        return PERSIST_BAD_CHECKSUM;
+    }
+
+    Persist_Kind kind = (Persist_Kind) header->kind;
+    size_t size = node_size(kind);
+    if (!is_node_offset(image, header->first, size) || !is_node_offset(image, header->last, size)
+        || (header->count == 0) != (header->first == 0)) {
+        return PERSIST_BAD_OFFSET;
+    }
+    for (size_t i = 0; i < header->count; i += 1) {
+        const unsigned char* node = image->base + NODES_OFFSET + i * size;
+        bool valid = true;
+        if (kind == PERSIST_SINGLY_LIST) {
+            valid = is_node_offset(image, ((const Persist_Singly_Node*) node)->next, size);
+        } else if (kind == PERSIST_DOUBLY_LIST) {
+            const Persist_Doubly_Node* doubly = (const Persist_Doubly_Node*) node;
+            valid = is_node_offset(image, doubly->prev, size) && is_node_offset(image, doubly->next, size);
+        } else {
+            const Persist_Rb_Node* rb = (const Persist_Rb_Node*) node;
+            valid = is_node_offset(image, rb->parent, size) && is_node_offset(image, rb->left, size)
+                 && is_node_offset(image, rb->right, size);
+        }
+        if (!valid) {
+            return PERSIST_BAD_OFFSET;
+        }
+    }
+    return PERSIST_OK;
+}
+
+// ========= lists =========
+
+Persist_Singly_Node* persist_singly_head(const Persist_Image* image) {
+    return (Persist_Singly_Node*) persist_at(image, persist_header(image)->first);
+}
+
+Persist_Singly_Node* persist_singly_next(const Persist_Image* image, const Persist_Singly_Node* node) {
+    return (Persist_Singly_Node*) persist_at(image, node->next);
+}
+
+bool persist_singly_get(const Persist_Image* image, size_t idx, int* get_val) {
+    assert(get_val != NULL && "Get value pointer is NULL.");
+    if (idx >= persist_count(image)) {
+        return false;
+    }
+    *get_val = ((const Persist_Singly_Node*) (image->base + NODES_OFFSET))[idx].val;
+    return true;
+}
+
+bool persist_singly_lookup(const Persist_Image* image, int needle_val, size_t* found_idx) {
+    assert(found_idx != NULL && "Found index pointer is NULL.");
+    const Persist_Singly_Node* nodes = (const Persist_Singly_Node*) (image->base + NODES_OFFSET);
+    size_t count = persist_count(image);
+    for (size_t i = 0; i < count; i += 1) {
+        if (nodes[i].val == needle_val) {
+            *found_idx = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+Persist_Doubly_Node* persist_doubly_head(const Persist_Image* image) {
+    return (Persist_Doubly_Node*) persist_at(image, persist_header(image)->first);
+}
+
+Persist_Doubly_Node* persist_doubly_tail(const Persist_Image* image) {
+    return (Persist_Doubly_Node*) persist_at(image, persist_header(image)->last);
+}
+
+Persist_Doubly_Node* persist_doubly_next(const Persist_Image* image, const Persist_Doubly_Node* node) {
+    return (Persist_Doubly_Node*) persist_at(image, node->next);
+}
+
+Persist_Doubly_Node* persist_doubly_prev(const Persist_Image* image, const Persist_Doubly_Node* node) {
+    return (Persist_Doubly_Node*) persist_at(image, node->prev);
+}
+
+bool persist_doubly_get(const Persist_Image* image, size_t idx, int* get_val) {
+    assert(get_val != NULL && "Get value pointer is NULL.");
+    if (idx >= persist_count(image)) {
+        return false;
+    }
+    *get_val = ((const Persist_Doubly_Node*) (image->base + NODES_OFFSET))[idx].val;
+    return true;
+}
+
+// ========= red-black tree =========
+
+Persist_Rb_Node* persist_rb_root(const Persist_Image* image) {
+    return (Persist_Rb_Node*) persist_at(image, persist_header(image)->first);
+}
+
+bool persist_rb_find(const Persist_Image* image, uint32_t key, uint64_t* value) {
+    const Persist_Rb_Node* node = persist_rb_root(image);
+    while (node != NULL && node->key != key) {
+        node = (const Persist_Rb_Node*) persist_at(image, key < node->key ? node->left : node->right);
+    }
+    if (node == NULL) {
+        return false;
+    }
+    if (value != NULL) {
+        *value = node->value;
+    }
+    return true;
+}
+
+uint32_t persist_rb_count(const Persist_Image* image, uint32_t key) {
+    const Persist_Rb_Node* node = persist_rb_root(image);
+    while (node != NULL && node->key != key) {
+        node = (const Persist_Rb_Node*) persist_at(image, key < node->key ? node->left : node->right);
+    }
+    return node != NULL ? node->count : 0;
+}
+
+Persist_Rb_Node* persist_rb_lower_bound(const Persist_Image* image, uint32_t key) {
+    Persist_Rb_Node* bound = NULL;
+    Persist_Rb_Node* node  = persist_rb_root(image);
+    while (node != NULL) {
+        if (node->key >= key) {
+            bound = node;
+            node  = (Persist_Rb_Node*) persist_at(image, node->left);
+        } else {
+            node = (Persist_Rb_Node*) persist_at(image, node->right);
+        }
+    }
+    return bound;
+}
+
+Persist_Rb_Node* persist_rb_first(const Persist_Image* image) {
+    Persist_Rb_Node* node = persist_rb_root(image);
+    while (node != NULL && node->left != 0) {
+        node = (Persist_Rb_Node*) persist_at(image, node->left);
+    }
+    return node;
+}
+
+Persist_Rb_Node* persist_rb_next(const Persist_Image* image, const Persist_Rb_Node* node) {
+    if (node->right != 0) {
+        Persist_Rb_Node* next = (Persist_Rb_Node*) persist_at(image, node->right);
+        while (next->left != 0) {
+            next = (Persist_Rb_Node*) persist_at(image, next->left);
+        }
+        return next;
+    }
+
+    uint64_t offset = (uint64_t) ((const unsigned char*) node - image->base);
+    Persist_Rb_Node* parent = (Persist_Rb_Node*) persist_at(image, node->parent);
+    while (parent != NULL && parent->right == offset) {
+        offset = (uint64_t) ((unsigned char*) parent - image->base);
+        parent = (Persist_Rb_Node*) persist_at(image, parent->parent);
+    }
+    return parent;
+}
@@ -0,0 +1,226 @@
+#ifndef PERSIST_H
+#define PERSIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "linkedlist.h"
+#include "tree/red_black_tree.h"
+
+// "DSPF" read as a little-endian `uint32_t`, a file written on a big-endian host, or
+// read on one, fails the magic check.
+#define PERSIST_MAGIC   0x46505344u
+// Version 2 added the occurrence count of the tree nodes, version 1 files are rejected.
+#define PERSIST_VERSION 2
+
+typedef enum Persist_Kind {
+    PERSIST_SINGLY_LIST = 1,
+    PERSIST_DOUBLY_LIST = 2,
+    PERSIST_RB_TREE     = 3,
+} Persist_Kind;
+
+typedef enum Persist_Result {
+    PERSIST_OK = 0,
+    PERSIST_IO_ERROR,
+    PERSIST_BAD_MAGIC,
+    PERSIST_BAD_VERSION,
+    PERSIST_BAD_KIND,
+    PERSIST_BAD_SIZE,
+    PERSIST_BAD_CHECKSUM,
+    PERSIST_BAD_OFFSET,
+} Persist_Result;
+
+/**
+ * @struct Persist_Header
+ * @brief The first 64 bytes of a saved file.
+ *
+ * A file is this header followed by `count` nodes of the size of its kind, in a
+ * single array. Nodes link to each other by byte offsets from the start of the file,
+ * `0` (the header) standing for `NULL`, so a file is valid wherever it is mapped and
+ * is queried in place without any parsing or copy.
+ *
+ * Fields:
+ * - `magic` / `version` / `kind`:
+ *   `PERSIST_MAGIC`, `PERSIST_VERSION` and the `Persist_Kind` of the saved structure.
+ *
+ * - `count`:
+ *   The number of nodes following the header.
+ *
+ * - `first` / `last`:
+ *   The offsets of the head and tail of a list, or of the root of a tree (`last` is
+ *   then `0`). Both are `0` for an empty structure.
+ *
+ * - `file_size`:
+ *   The size of the whole file, checked against the mapping.
+ *
+ * - `checksum`:
+ *   `persist_checksum` of the nodes, only checked by `persist_verify`.
+ */
+typedef struct Persist_Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t kind;
+    uint64_t count;
+    uint64_t first;
+    uint64_t last;
+    uint64_t file_size;
+    uint64_t checksum;
+    uint64_t reserved[2];
+} Persist_Header;
+
+// On-disk nodes, laid out in list order for the lists and in breadth-first order for
+// the tree so that the top levels, which every lookup goes through, are contiguous.
+typedef struct Persist_Singly_Node {
+    uint64_t next;
+    int32_t  val;
+    uint32_t reserved;
+} Persist_Singly_Node;
+
+typedef struct Persist_Doubly_Node {
+    uint64_t prev;
+    uint64_t next;
+    int32_t  val;
+    uint32_t reserved;
+} Persist_Doubly_Node;
+
+// `Rb_Node` values are pointers, which mean nothing to another process: they are
+// saved as integers (`uintptr_t`), for trees mapping keys to indices or offsets.
+// `count` is the number of occurrences of the key, 1 in a map.
+typedef struct Persist_Rb_Node {
+    uint64_t parent;
+    uint64_t left;
+    uint64_t right;
+    uint64_t value;
+    uint32_t key;
+    uint32_t count;
+    uint8_t  color;
+    uint8_t  reserved[7];
+} Persist_Rb_Node;
+
+/**
+ * @struct Persist_Image
+ * @brief A saved file mapped in memory.
+ *
+ * Fields:
+ * - `base`:
+ *   The start of the mapping, the header. Offsets of the nodes are relative to it.
+ *
+ * - `size`:
+ *   The size of the mapping.
+ *
+ * - `writable`:
+ *   Whether the image was mapped copy-on-write: the nodes may then be modified in
+ *   place, the changes are private to the process and never reach the file.
+ *
+ * Example:
+ *
+ * ```c
+ * persist_save_rb_tree("index.bin", root);
+ *
+ * // In another process, in O(1) whatever the size of the tree.
+ * Persist_Image image;
+ * if (persist_map(&image, "index.bin", PERSIST_RB_TREE, false) == PERSIST_OK) {
+ *     uint64_t value;
+ *     if (persist_rb_find(&image, 42, &value)) {
+ *         printf("%lu\n", value);
+ *     }
+ *     persist_unmap(&image);
+ * }
+ * ```
+ */
+typedef struct Persist_Image {
+    unsigned char* base;
+    size_t         size;
+    bool           writable;
+} Persist_Image;
+
+// Human readable name of a result, for error messages.
+const char* persist_result_name(Persist_Result result);
+
+// Checksum of `size` bytes (a multiple of 8) as stored in the header, 8 bytes per step.
+uint64_t persist_checksum(const void* data, size_t size);
+
+/**
+ * @brief Writes a structure to `path`, replacing the file.
+ *
+ * The nodes are streamed through a buffered file, the structure is walked once.
+ * A doubly list is saved in its logical order, reversed or not.
+ *
+ * @return
+ *        `PERSIST_OK`, or `PERSIST_IO_ERROR` when the file cannot be written.
+ *
+ * Performance:
+ * - Time complexity: O(n). The tree also allocates a breadth-first queue of up to `n` nodes.
+ */
+Persist_Result persist_save_singly_list(const char* path, Singly_List* list);
+Persist_Result persist_save_doubly_list(const char* path, Doubly_List* list);
+Persist_Result persist_save_rb_tree(const char* path, Rb_Node* root);
+
+/**
+ * @brief Maps the file at `path` and checks its header.
+ *
+ * Only the header is read: the magic, version, kind and the size of the file against
+ * the node count. The checksum and the node links are trusted, call `persist_verify`
+ * for files that may be corrupted or come from an untrusted source.
+ *
+ * @param image
+ *        The image to fill. Untouched unless `PERSIST_OK` is returned.
+ *
+ * @param kind
+ *        The expected kind of structure.
+ *
+ * @param copy_on_write
+ *        `false` maps the file read-only and shared, `true` maps it private and
+ *        writable: pages are copied on their first write, the file never changes.
+ *
+ * Performance:
+ * - Time complexity: O(1), pages are loaded lazily by the first accesses.
+ */
+Persist_Result persist_map(Persist_Image* image, const char* path, Persist_Kind kind, bool copy_on_write);
+void persist_unmap(Persist_Image* image);
+
+/**
+ * @brief Checks the checksum of the nodes and that every link is the offset of a node.
+ *
+ * Performance:
+ * - Time complexity: O(n), every page of the file is read.
+ */
+Persist_Result persist_verify(Persist_Image* image);
+
+static inline const Persist_Header* persist_header(const Persist_Image* image) {
+    return (const Persist_Header*) image->base;
+}
+
+// Node at `offset` in the image, NULL for the offset `0`.
+static inline void* persist_at(const Persist_Image* image, uint64_t offset) {
+    return offset != 0 ? image->base + offset : NULL;
+}
+
+// Number of elements of the saved structure.
+static inline size_t persist_count(const Persist_Image* image) {
+    return (size_t) persist_header(image)->count;
+}
+
+// In-place list queries. The nodes are laid out in list order, so the element at an
+// index is found in O(1) instead of walking the links.
+Persist_Singly_Node* persist_singly_head(const Persist_Image* image);
+Persist_Singly_Node* persist_singly_next(const Persist_Image* image, const Persist_Singly_Node* node);
+bool persist_singly_get(const Persist_Image* image, size_t idx, int* get_val);
+bool persist_singly_lookup(const Persist_Image* image, int needle_val, size_t* found_idx);
+
+Persist_Doubly_Node* persist_doubly_head(const Persist_Image* image);
+Persist_Doubly_Node* persist_doubly_tail(const Persist_Image* image);
+Persist_Doubly_Node* persist_doubly_next(const Persist_Image* image, const Persist_Doubly_Node* node);
+Persist_Doubly_Node* persist_doubly_prev(const Persist_Image* image, const Persist_Doubly_Node* node);
+bool persist_doubly_get(const Persist_Image* image, size_t idx, int* get_val);
+
+// In-place tree queries, with the semantics of their `rb_node_*` counterparts.
+Persist_Rb_Node* persist_rb_root(const Persist_Image* image);
+bool persist_rb_find(const Persist_Image* image, uint32_t key, uint64_t* value);
+uint32_t persist_rb_count(const Persist_Image* image, uint32_t key);
+Persist_Rb_Node* persist_rb_lower_bound(const Persist_Image* image, uint32_t key);
+Persist_Rb_Node* persist_rb_first(const Persist_Image* image);
+Persist_Rb_Node* persist_rb_next(const Persist_Image* image, const Persist_Rb_Node* node);
+
+#endif  // PERSIST_H
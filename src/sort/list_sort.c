@@ -0,0 +1,474 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "list_sort.h"
+
+#define SORT_BINS 64
+
+// Sets the link of `node` opposite to the one the sort follows, which the doubly
+// lists keep pointing to the previous node of the run.
+#define NO_BACK_LINK(node, prev_node)   ((void) 0)
+#define BACK_LINK_PREV(node, prev_node) ((node)->prev = (prev_node))
+#define BACK_LINK_NEXT(node, prev_node) ((node)->next = (prev_node))
+
+// Runs `work` on `n` tasks `stride` bytes apart, task 0 on the calling thread and the
+// others on their own threads, and waits for all of them.
+static void run_tasks(void* (*work)(void*), unsigned char* tasks, size_t stride, size_t n) {
+    assert(n <= LIST_SORT_MAX_THREADS && "Too many sort tasks.");
+
+    pthread_t threads[LIST_SORT_MAX_THREADS];
+    bool      started[LIST_SORT_MAX_THREADS];
+    for (size_t i = 1; i < n; i += 1) {
+        started[i] = pthread_create(&threads[i], NULL, work, tasks + i * stride) == 0;
+        if (!started[i]) {
+            work(tasks + i * stride);
+        }
+    }
+
+    work(tasks);
+    for (size_t i = 1; i < n; i += 1) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+static size_t parallel_threads(size_t count, size_t threads) {
+    if (threads > LIST_SORT_MAX_THREADS) {
+        threads = LIST_SORT_MAX_THREADS;
+    }
+    if (threads > count / LIST_SORT_MIN_NODES_PER_THREAD) {
+        threads = count / LIST_SORT_MIN_NODES_PER_THREAD;
+    }
+    return threads;
+}
+
+/*
+ * Defines the merge sort of chains of `Node` linked through `NEXT`:
+ * - `name##_sort_run`, sorting a `NULL` terminated chain,
+ * - `name##_sort_parallel`, sorting the first `count` nodes of a chain on `threads`
+ *   threads.
+ * Both return the first and last node of the sorted chain.
+ */
+#define LIST_SORT_DEFINE(name, Node, NEXT, BACK_LINK)                                                  \
+    typedef struct name##_Run {                                                                        \
+        Node* head;                                                                                    \
+        Node* tail;                                                                                    \
+    } name##_Run;                                                                                      \
+                                                                                                       \
+    /* Merges two sorted runs, the nodes of `a` going first on equal values. */                        \
+    static name##_Run name##_merge(name##_Run a, name##_Run b) {                                       \
+        if (a.head == NULL) {                                                                          \
+            return b;                                                                                  \
+        }                                                                                              \
+        if (b.head == NULL) {                                                                          \
+            return a;                                                                                  \
+        }                                                                                              \
+        if (a.tail->val <= b.head->val) {                                                              \
+            a.tail->NEXT = b.head;                                                                     \
+            BACK_LINK(b.head, a.tail);                                                                 \
+            return (name##_Run) { a.head, b.tail };                                                    \
+        }                                                                                              \
+                                                                                                       \
+        Node* a_node = a.head;                                                                         \
+        Node* b_node = b.head;                                                                         \
+        Node* head;                                                                                    \
+        if (b_node->val < a_node->val) {                                                               \
+            head   = b_node;                                                                           \
+            b_node = b_node->NEXT;                                                                     \
+        } else {                                                                                       \
+            head   = a_node;                                                                           \
+            a_node = a_node->NEXT;                                                                     \
+        }                                                                                              \
+        BACK_LINK(head, NULL);                                                                         \
+                                                                                                       \
+        Node* tail = head;                                                                             \
+        while (a_node != NULL && b_node != NULL) {                                                     \
+            /* Selects without branching, the comparison being a coin flip on random input, */         \
+            /* and fetches the node after the next one while this one is linked. */                    \
+            bool  take_b    = b_node->val < a_node->val;                                               \
+            Node* node      = take_b ? b_node : a_node;                                                \
+            Node* next_node = node->NEXT;                                                              \
+            if (next_node != NULL) {                                                                   \
+                __builtin_prefetch(next_node->NEXT);                                                   \
+            }                                                                                          \
+            a_node = take_b ? a_node : next_node;                                                      \
+            b_node = take_b ? next_node : b_node;                                                      \
+            tail->NEXT = node;                                                                         \
+            BACK_LINK(node, tail);                                                                     \
+            tail = node;                                                                               \
+        }                                                                                              \
+                                                                                                       \
+        /* The rest of the run left is already linked in order, up to its tail. */                     \
+        if (a_node != NULL) {                                                                          \
+            tail->NEXT = a_node;                                                                       \
+            BACK_LINK(a_node, tail);                                                                   \
+            return (name##_Run) { head, a.tail };                                                      \
+        }                                                                                              \
+        tail->NEXT = b_node;                                                                           \
+        BACK_LINK(b_node, tail);                                                                       \
+        return (name##_Run) { head, b.tail };                                                          \
+    }                                                                                                  \
+                                                                                                       \
+    static name##_Run name##_sort_run(Node* chain) {                                                   \
+        /* bins[i] is empty or holds a sorted run of 2^i nodes, the higher bins holding */             \
+        /* the nodes that came first. */                                                               \
+        name##_Run bins[SORT_BINS];                                                                    \
+        size_t used_bins = 0;                                                                          \
+        while (chain != NULL) {                                                                        \
+            Node* node = chain;                                                                        \
+            chain      = chain->NEXT;                                                                  \
+            node->NEXT = NULL;                                                                         \
+            BACK_LINK(node, NULL);                                                                     \
+                                                                                                       \
+            name##_Run run = { node, node };                                                           \
+            size_t bin = 0;                                                                            \
+            for (; bin < used_bins && bins[bin].head != NULL; bin += 1) {                              \
+                run = name##_merge(bins[bin], run);                                                    \
+                bins[bin].head = NULL;                                                                 \
+            }                                                                                          \
+            bins[bin] = run;                                                                           \
+            if (bin == used_bins) {                                                                    \
+                used_bins += 1;                                                                        \
+            }                                                                                          \
+        }                                                                                              \
+                                                                                                       \
+        name##_Run sorted = { NULL, NULL };                                                            \
+        for (size_t bin = 0; bin < used_bins; bin += 1) {                                              \
+            if (bins[bin].head != NULL) {                                                              \
+                sorted = name##_merge(bins[bin], sorted);                                              \
+            }                                                                                          \
+        }                                                                                              \
+        return sorted;                                                                                 \
+    }                                                                                                  \
+                                                                                                       \
+    typedef struct name##_Task {                                                                       \
+        name##_Run run;                                                                                \
+        name##_Run other;                                                                              \
+        bool       merge;                                                                              \
+    } name##_Task;                                                                                     \
+                                                                                                       \
+    /* Sorts the chain of `run.head`, or merges `other` after `run`. */                                \
+    static void* name##_task_work(void* arg) {                                                         \
+        name##_Task* task = (name##_Task*) arg;                                                        \
+        if (task->merge) {                                                                             \
+            task->run = name##_merge(task->run, task->other);                                          \
+        } else {                                                                                       \
+            task->run = name##_sort_run(task->run.head);                                               \
+        }                                                                                              \
+        return NULL;                                                                                   \
+    }                                                                                                  \
+                                                                                                       \
+    static name##_Run name##_sort_parallel(Node* chain, size_t count, size_t threads) {                \
+        threads = parallel_threads(count, threads);                                                    \
+        if (threads <= 1) {                                                                            \
+            return name##_sort_run(chain);                                                             \
+        }                                                                                              \
+                                                                                                       \
+        /* Cuts the chain into one run per thread, in order. */                                        \
+        name##_Task tasks[LIST_SORT_MAX_THREADS];                                                      \
+        Node* node = chain;                                                                            \
+        for (size_t i = 0; i < threads; i += 1) {                                                      \
+            size_t len = count / threads + (i < count % threads ? 1 : 0);                              \
+            tasks[i].run.head = node;                                                                  \
+            tasks[i].merge    = false;                                                                 \
+            for (size_t j = 1; j < len; j += 1) {                                                      \
+                node = node->NEXT;                                                                     \
+            }                                                                                          \
+            Node* next_node = node->NEXT;                                                              \
+            node->NEXT      = NULL;                                                                    \
+            node            = next_node;                                                               \
+        }                                                                                              \
+        run_tasks(name##_task_work, (unsigned char*) tasks, sizeof(name##_Task), threads);             \
+                                                                                                       \
+        /* Merges runs `width` apart into tasks[i], the pairs of a round concurrently. */              \
+        for (size_t width = 1; width < threads; width *= 2) {                                          \
+            size_t merges = 0;                                                                         \
+            for (size_t i = 0; i + width < threads; i += 2 * width) {                                  \
+                tasks[i].other = tasks[i + width].run;                                                 \
+                tasks[i].merge = true;                                                                 \
+                merges += 1;                                                                           \
+            }                                                                                          \
+            size_t stride = 2 * width * sizeof(name##_Task);                                           \
+            run_tasks(name##_task_work, (unsigned char*) tasks, stride, merges);                       \
+        }                                                                                              \
+        return tasks[0].run;                                                                           \
+    }
+
+LIST_SORT_DEFINE(singly, Singly_Linked_List_Node, next, NO_BACK_LINK)
+// Doubly chains in their physical order, and reversed `Doubly_List` in their logical
+// order, following the `prev` links from the tail.
+LIST_SORT_DEFINE(doubly, Doubly_Linked_List_Node, next, BACK_LINK_PREV)
+LIST_SORT_DEFINE(doubly_backward, Doubly_Linked_List_Node, prev, BACK_LINK_NEXT)
+
+// Digits of the radix sort: 3 passes cover 32-bit keys, and the 2048 bucket ends
+// still fit in the L1 cache.
+#define RADIX_BITS    11
+#define RADIX_BUCKETS ((size_t) 1 << RADIX_BITS)
+
+// Radix keys order the signed values like `<`: flipping the sign bit puts the
+// negative values, in order, before the positive ones.
+static inline uint32_t radix_key(int val) {
+    return (uint32_t) val ^ 0x80000000u;
+}
+
+static bool below_pivot(int val, void* ctx) {
+    return val < *(const int*) ctx;
+}
+
+/*
+ * Defines the relinking operations of chains of `Node` linked through `NEXT`, on the
+ * `name##_Run` of `LIST_SORT_DEFINE`:
+ * - `name##_radix_sort`, the LSD radix sort of a `NULL` terminated chain,
+ * - `name##_partition`, the stable partition of a chain by a predicate.
+ */
+#define LIST_RELINK_DEFINE(name, Node, NEXT, BACK_LINK)                                                \
+    /* Links run `b` after run `a`. */                                                                 \
+    static name##_Run name##_concat(name##_Run a, name##_Run b) {                                      \
+        if (a.head == NULL) {                                                                          \
+            return b;                                                                                  \
+        }                                                                                              \
+        if (b.head != NULL) {                                                                          \
+            a.tail->NEXT = b.head;                                                                     \
+            BACK_LINK(b.head, a.tail);                                                                 \
+            a.tail = b.tail;                                                                           \
+        }                                                                                              \
+        return a;                                                                                      \
+    }                                                                                                  \
+                                                                                                       \
+    /* Appends `node` to `run`, leaving the link after it to the caller. */                            \
+    static inline void name##_push(name##_Run* run, Node* node) {                                      \
+        if (run->tail == NULL) {                                                                       \
+            run->head = node;                                                                          \
+        } else {                                                                                       \
+            run->tail->NEXT = node;                                                                    \
+        }                                                                                              \
+        BACK_LINK(node, run->tail);                                                                    \
+        run->tail = node;                                                                              \
+    }                                                                                                  \
+                                                                                                       \
+    static name##_Run name##_radix_sort(Node* chain) {                                                 \
+        name##_Run sorted = { chain, NULL };                                                           \
+        if (chain == NULL) {                                                                           \
+            return sorted;                                                                             \
+        }                                                                                              \
+                                                                                                       \
+        /* The keys are sorted relative to the lowest: only the digits of the span */                  \
+        /* between the lowest and the highest key are dealt, none when in order. */                    \
+        uint32_t min_key  = UINT32_MAX;                                                                \
+        uint32_t max_key  = 0;                                                                         \
+        bool     in_order = true;                                                                      \
+        for (Node* node = chain; node != NULL; node = node->NEXT) {                                    \
+            uint32_t key = radix_key(node->val);                                                       \
+            in_order = in_order && key >= max_key;                                                     \
+            min_key  = key < min_key ? key : min_key;                                                  \
+            max_key  = key > max_key ? key : max_key;                                                  \
+            sorted.tail = node;                                                                        \
+        }                                                                                              \
+        if (in_order) {                                                                                \
+            return sorted;                                                                             \
+        }                                                                                              \
+                                                                                                       \
+        uint32_t span = max_key - min_key;                                                             \
+        name##_Run buckets[RADIX_BUCKETS];                                                             \
+        for (uint32_t shift = 0; shift < 32 && (span >> shift) != 0; shift += RADIX_BITS) {            \
+            /* Deals the nodes to the buckets of their digit, in order, then chains */                 \
+            /* the buckets: each pass is stable. */                                                    \
+            for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket += 1) {                             \
+                buckets[bucket].head = NULL;                                                           \
+                buckets[bucket].tail = NULL;                                                           \
+            }                                                                                          \
+            for (Node* node = sorted.head; node != NULL;) {                                            \
+                Node* next_node = node->NEXT;                                                          \
+                uint32_t digit = ((radix_key(node->val) - min_key) >> shift) & (RADIX_BUCKETS - 1);    \
+                name##_push(&buckets[digit], node);                                                    \
+                node = next_node;                                                                      \
+            }                                                                                          \
+                                                                                                       \
+            sorted = (name##_Run) { NULL, NULL };                                                      \
+            for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket += 1) {                             \
+                sorted = name##_concat(sorted, buckets[bucket]);                                       \
+            }                                                                                          \
+            sorted.tail->NEXT = NULL;                                                                  \
+        }                                                                                              \
+        return sorted;                                                                                 \
+    }                                                                                                  \
+                                                                                                       \
+    /* Splits the chain into the nodes `pred` accepts and the others, both in order, */                \
+    /* and returns the number of accepted nodes. */                                                    \
+    static size_t name##_partition(Node* chain, List_Predicate_Fn pred, void* ctx,                     \
+                                   name##_Run* accepted, name##_Run* rejected) {                       \
+        *accepted = (name##_Run) { NULL, NULL };                                                       \
+        *rejected = (name##_Run) { NULL, NULL };                                                       \
+        size_t accepted_count = 0;                                                                     \
+        for (Node* node = chain; node != NULL;) {                                                      \
+            Node* next_node = node->NEXT;                                                              \
+            if (pred(node->val, ctx)) {                                                                \
+                name##_push(accepted, node);                                                           \
+                accepted_count += 1;                                                                   \
+            } else {                                                                                   \
+                name##_push(rejected, node);                                                           \
+            }                                                                                          \
+            node = next_node;                                                                          \
+        }                                                                                              \
+                                                                                                       \
+        if (accepted->tail != NULL) {                                                                  \
+            accepted->tail->NEXT = NULL;                                                               \
+        }                                                                                              \
+        if (rejected->tail != NULL) {                                                                  \
+            rejected->tail->NEXT = NULL;                                                               \
+        }                                                                                              \
+        return accepted_count;                                                                         \
+    }
+
+LIST_RELINK_DEFINE(singly, Singly_Linked_List_Node, next, NO_BACK_LINK)
+LIST_RELINK_DEFINE(doubly, Doubly_Linked_List_Node, next, BACK_LINK_PREV)
+LIST_RELINK_DEFINE(doubly_backward, Doubly_Linked_List_Node, prev, BACK_LINK_NEXT)
+
+Singly_Linked_List_Node* singly_linked_list_sort(Singly_Linked_List_Node* linked_list_head) {
+    return singly_sort_run(linked_list_head).head;
+}
+
+Doubly_Linked_List_Node* doubly_linked_list_sort(Doubly_Linked_List_Node* linked_list_head) {
+    return doubly_sort_run(linked_list_head).head;
+}
+
+void singly_list_sort(Singly_List* list) {
+    singly_list_sort_parallel(list, 1);
+}
+
+void doubly_list_sort(Doubly_List* list) {
+    doubly_list_sort_parallel(list, 1);
+}
+
+void singly_list_sort_parallel(Singly_List* list, size_t threads) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    singly_Run sorted = singly_sort_parallel(list->head, list->len, threads);
+    list->head   = sorted.head;
+    list->tail   = sorted.tail;
+    list->finger = NULL;
+}
+
+void doubly_list_sort_parallel(Doubly_List* list, size_t threads) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (list->reversed) {
+        doubly_backward_Run sorted = doubly_backward_sort_parallel(list->tail, list->count, threads);
+        list->tail = sorted.head;
+        list->head = sorted.tail;
+    } else {
+        doubly_Run sorted = doubly_sort_parallel(list->head, list->count, threads);
+        list->head = sorted.head;
+        list->tail = sorted.tail;
+    }
+}
+
+Singly_Linked_List_Node* singly_linked_list_radix_sort(Singly_Linked_List_Node* linked_list_head) {
+    return singly_radix_sort(linked_list_head).head;
+}
+
+Doubly_Linked_List_Node* doubly_linked_list_radix_sort(Doubly_Linked_List_Node* linked_list_head) {
+    return doubly_radix_sort(linked_list_head).head;
+}
+
+void singly_list_radix_sort(Singly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    singly_Run sorted = singly_radix_sort(list->head);
+    list->head   = sorted.head;
+    list->tail   = sorted.tail;
+    list->finger = NULL;
+}
+
+void doubly_list_radix_sort(Doubly_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (list->reversed) {
+        doubly_backward_Run sorted = doubly_backward_radix_sort(list->tail);
+        list->tail = sorted.head;
+        list->head = sorted.tail;
+    } else {
+        doubly_Run sorted = doubly_radix_sort(list->head);
+        list->head = sorted.head;
+        list->tail = sorted.tail;
+    }
+}
+
+size_t singly_list_partition(Singly_List* list, List_Predicate_Fn pred, void* ctx) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(pred != NULL && "Predicate is NULL.");
+
+    singly_Run accepted, rejected;
+    size_t accepted_count = singly_partition(list->head, pred, ctx, &accepted, &rejected);
+    singly_Run all = singly_concat(accepted, rejected);
+    list->head   = all.head;
+    list->tail   = all.tail;
+    list->finger = NULL;
+    return accepted_count;
+}
+
+size_t doubly_list_partition(Doubly_List* list, List_Predicate_Fn pred, void* ctx) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(pred != NULL && "Predicate is NULL.");
+
+    if (list->reversed) {
+        doubly_backward_Run accepted, rejected;
+        size_t accepted_count = doubly_backward_partition(list->tail, pred, ctx, &accepted, &rejected);
+        doubly_backward_Run all = doubly_backward_concat(accepted, rejected);
+        list->tail = all.head;
+        list->head = all.tail;
+        return accepted_count;
+    }
+
+    doubly_Run accepted, rejected;
+    size_t accepted_count = doubly_partition(list->head, pred, ctx, &accepted, &rejected);
+    doubly_Run all = doubly_concat(accepted, rejected);
+    list->head = all.head;
+    list->tail = all.tail;
+    return accepted_count;
+}
+
+void singly_list_split(Singly_List* list, int pivot, Singly_List* upper) {
+    assert(list != NULL && upper != NULL && "Linked List handle is NULL.");
+
+    singly_Run lower_run, upper_run;
+    size_t lower_len = singly_partition(list->head, below_pivot, &pivot, &lower_run, &upper_run);
+    singly_list_init_pooled(upper, list->pool);
+    upper->head = upper_run.head;
+    upper->tail = upper_run.tail;
+    upper->len  = list->len - lower_len;
+
+    list->head   = lower_run.head;
+    list->tail   = lower_run.tail;
+    list->len    = lower_len;
+    list->finger = NULL;
+}
+
+void doubly_list_split(Doubly_List* list, int pivot, Doubly_List* upper) {
+    assert(list != NULL && upper != NULL && "Linked List handle is NULL.");
+
+    doubly_list_init_pooled(upper, list->pool);
+    upper->reversed = list->reversed;
+    size_t lower_count;
+    if (list->reversed) {
+        doubly_backward_Run lower_run, upper_run;
+        lower_count =
+            doubly_backward_partition(list->tail, below_pivot, &pivot, &lower_run, &upper_run);
+        list->tail  = lower_run.head;
+        list->head  = lower_run.tail;
+        upper->tail = upper_run.head;
+        upper->head = upper_run.tail;
+    } else {
+        doubly_Run lower_run, upper_run;
+        lower_count = doubly_partition(list->head, below_pivot, &pivot, &lower_run, &upper_run);
+        list->head  = lower_run.head;
+        list->tail  = lower_run.tail;
+        upper->head = upper_run.head;
+        upper->tail = upper_run.tail;
+    }
+    upper->count = list->count - lower_count;
+    list->count  = lower_count;
+}
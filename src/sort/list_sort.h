@@ -0,0 +1,138 @@
+#ifndef LIST_SORT_H
+#define LIST_SORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "linkedlist.h"
+
+/**
+ * In-place sorting of the lists of `linkedlist.h` by relinking their nodes.
+ *
+ * The sort is a stable bottom-up merge sort: nodes are taken one at a time and
+ * merged into sorted runs of 1, 2, 4, ... nodes kept in 64 bins, like binary
+ * counting, then the bins are merged together. It allocates nothing, does at most
+ * `n log2(n)` comparisons, and merging a run that is already in order after another
+ * is O(1), so sorted input is sorted in O(n).
+ *
+ * The parallel variants cut the list into one run per thread, sort the runs
+ * concurrently and merge them pairwise, pairs of a round being merged concurrently
+ * too.
+ *
+ * Notes:
+ * - Values are sorted in ascending order, equal values keep their relative order.
+ * - Nodes keep their values and addresses, only the links change: after sorting a
+ *   shuffled list, walking it jumps around memory. Rebuilding the list from a sorted
+ *   array lays pooled nodes out in order instead, at the cost of an allocation.
+ */
+
+// Upper bound of the `threads` argument of the parallel sorts.
+#define LIST_SORT_MAX_THREADS 64
+// Lists shorter than this many nodes per thread are sorted on the calling thread.
+#define LIST_SORT_MIN_NODES_PER_THREAD 16384
+
+/**
+ * @brief Sorts the chain starting at `linked_list_head`.
+ *
+ * @param linked_list_head
+ *        The first node of the chain, may be `NULL`.
+ *
+ * @return
+ *        The new first node of the chain.
+ *
+ * Performance:
+ * - Time complexity: O(n log n), O(n) when already sorted.
+ * - Space complexity: O(1).
+ */
+Singly_Linked_List_Node* singly_linked_list_sort(Singly_Linked_List_Node* linked_list_head);
+Doubly_Linked_List_Node* doubly_linked_list_sort(Doubly_Linked_List_Node* linked_list_head);
+
+/**
+ * @brief Sorts the list, keeping the cached ends of the handle up to date.
+ *
+ * A reversed `Doubly_List` is sorted in its logical order and stays reversed.
+ *
+ * Performance:
+ * - Time complexity: O(n log n), O(n) when already sorted.
+ * - Space complexity: O(1).
+ */
+void singly_list_sort(Singly_List* list);
+void doubly_list_sort(Doubly_List* list);
+
+/**
+ * @brief Sorts the list on up to `threads` threads, the calling one included.
+ *
+ * The result is the same as the sequential sort. Fewer threads are used when the list
+ * has less than `LIST_SORT_MIN_NODES_PER_THREAD` nodes per thread, and a thread that
+ * cannot be created runs its share on the calling thread.
+ *
+ * @param threads
+ *        The number of threads, clamped to `1 .. LIST_SORT_MAX_THREADS`.
+ *
+ * Performance:
+ * - Time complexity: O(n) to cut the list, O((n / t) log(n / t)) for the runs and
+ *   O(n) for the last merge, which is sequential.
+ */
+void singly_list_sort_parallel(Singly_List* list, size_t threads);
+void doubly_list_sort_parallel(Doubly_List* list, size_t threads);
+
+/**
+ * @brief Decides whether a value goes to the front of a partition.
+ */
+typedef bool (*List_Predicate_Fn)(int val, void* ctx);
+
+/**
+ * @brief Sorts the chain, or the list, by LSD radix on 11-bit digits of the values.
+ *
+ * Each pass deals the nodes, in order, to 2048 buckets by one digit of their value
+ * and chains the buckets back: nodes are relinked, never copied nor allocated. A
+ * first pass finds the lowest and highest values, and only the digits of their
+ * difference are dealt, so values within a span of 2048 take one pass. The result is
+ * the same as the merge sort. A reversed `Doubly_List` is sorted in its logical order
+ * and stays reversed.
+ *
+ * Performance:
+ * - Time complexity: O(n), at most 4 passes over the list, 1 when already sorted.
+ * - Space complexity: O(1), 32 KiB of bucket ends on the stack.
+ * - Every pass walks the list in its current order: once the nodes are scattered in
+ *   memory, each pass is a cache miss per node, and the merge sort may be as fast on
+ *   long lists of values spanning the whole `int` range.
+ */
+Singly_Linked_List_Node* singly_linked_list_radix_sort(Singly_Linked_List_Node* linked_list_head);
+Doubly_Linked_List_Node* doubly_linked_list_radix_sort(Doubly_Linked_List_Node* linked_list_head);
+void singly_list_radix_sort(Singly_List* list);
+void doubly_list_radix_sort(Doubly_List* list);
+
+/**
+ * @brief Moves the values `pred` accepts to the front of the list, in one pass.
+ *
+ * The partition is stable: the accepted values, then the others, keep their relative
+ * order. A reversed `Doubly_List` is partitioned in its logical order.
+ *
+ * @return
+ *        The number of accepted values.
+ *
+ * Performance:
+ * - Time complexity: O(n), one call of `pred` per value.
+ * - Space complexity: O(1), no node is allocated.
+ */
+size_t singly_list_partition(Singly_List* list, List_Predicate_Fn pred, void* ctx);
+size_t doubly_list_partition(Doubly_List* list, List_Predicate_Fn pred, void* ctx);
+
+/**
+ * @brief Splits the list at `pivot`: the values lower than `pivot` stay in `list`, the
+ *        others move to `upper`, both in their order.
+ *
+ * @param upper
+ *        The handle to initialize with the moved nodes, sharing the pool of `list`.
+ *        Its previous content is overwritten, not freed. A reversed `Doubly_List`
+ *        gives a reversed `upper`.
+ *
+ * Performance:
+ * - Time complexity: O(n).
+ * - Space complexity: O(1), no node is allocated.
+ */
+void singly_list_split(Singly_List* list, int pivot, Singly_List* upper);
+void doubly_list_split(Doubly_List* list, int pivot, Doubly_List* upper);
+
+#endif  // LIST_SORT_H
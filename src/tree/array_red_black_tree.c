@@ -0,0 +1,386 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "array_red_black_tree.h"
+
+#define RB_ARRAY_MIN_CAPACITY 16u
+
+static inline uint32_t node_parent(Rb_Array_Tree* tree, uint32_t idx) {
+    return tree->nodes[idx].parent_color & RB_ARRAY_INDEX_MAX;
+}
+
+static inline bool node_is_red(Rb_Array_Tree* tree, uint32_t idx) {
+    return (tree->nodes[idx].parent_color & RB_ARRAY_RED_BIT) != 0;
+}
+
+static inline void set_parent(Rb_Array_Tree* tree, uint32_t idx, uint32_t parent_idx) {
+    tree->nodes[idx].parent_color = (tree->nodes[idx].parent_color & RB_ARRAY_RED_BIT) | parent_idx;
+}
+
+static inline void set_red(Rb_Array_Tree* tree, uint32_t idx) {
+    tree->nodes[idx].parent_color |= RB_ARRAY_RED_BIT;
+}
+
+static inline void set_black(Rb_Array_Tree* tree, uint32_t idx) {
+    tree->nodes[idx].parent_color &= RB_ARRAY_INDEX_MAX;
+}
+
+static inline void copy_color(Rb_Array_Tree* tree, uint32_t dst_idx, uint32_t src_idx) {
+    tree->nodes[dst_idx].parent_color = (tree->nodes[dst_idx].parent_color & RB_ARRAY_INDEX_MAX)
+                                      | (tree->nodes[src_idx].parent_color & RB_ARRAY_RED_BIT);
+}
+
+void rb_array_tree_init(Rb_Array_Tree* tree, uint32_t capacity) {
+    assert(tree != NULL && "Tree is NULL.");
+
+    tree->nodes     = NULL;
+    tree->capacity  = 0;
+    tree->used      = 1;
+    tree->free_list = RB_ARRAY_NIL;
+    tree->root      = RB_ARRAY_NIL;
+    tree->count     = 0;
+    rb_array_tree_reserve(tree, capacity);
+}
+
+void rb_array_tree_free(Rb_Array_Tree* tree) {
+    assert(tree != NULL && "Tree is NULL.");
+
+    free(tree->nodes);
+    tree->nodes     = NULL;
+    tree->capacity  = 0;
+    tree->used      = 1;
+    tree->free_list = RB_ARRAY_NIL;
+    tree->root      = RB_ARRAY_NIL;
+    tree->count     = 0;
+}
+
+void rb_array_tree_reserve(Rb_Array_Tree* tree, uint32_t capacity) {
+    assert(tree != NULL && "Tree is NULL.");
+    assert(capacity < RB_ARRAY_INDEX_MAX && "Tree capacity exceeds 32-bit indices.");
+
+    // One more slot for the sentinel.
+    uint32_t new_capacity = capacity + 1;
+    if (new_capacity < RB_ARRAY_MIN_CAPACITY) {
+        new_capacity = RB_ARRAY_MIN_CAPACITY;
+    }
+    if (new_capacity <= tree->capacity) {
+        return;
+    }
+
+    Rb_Array_Node* nodes = (Rb_Array_Node*) realloc(tree->nodes, (size_t) new_capacity * sizeof(Rb_Array_Node));
+    if (nodes == NULL) {
+        printf("Unable to allocate memory for the red black tree nodes.");
+        exit(1);
+    }
+
+    if (tree->nodes == NULL) {
+        nodes[RB_ARRAY_NIL].parent_color = RB_ARRAY_NIL;
+        nodes[RB_ARRAY_NIL].left         = RB_ARRAY_NIL;
+        nodes[RB_ARRAY_NIL].right        = RB_ARRAY_NIL;
+        nodes[RB_ARRAY_NIL].val          = 0;
+    }
+
+    tree->nodes    = nodes;
+    tree->capacity = new_capacity;
+}
+
+size_t rb_array_tree_count(Rb_Array_Tree* tree) {
+    assert(tree != NULL && "Tree is NULL.");
+
+    return tree->count;
+}
+
+static uint32_t node_alloc(Rb_Array_Tree* tree) {
+    if (tree->free_list != RB_ARRAY_NIL) {
+        uint32_t idx = tree->free_list;
+        tree->free_list = tree->nodes[idx].left;
+        return idx;
+    }
+
+    if (tree->used == tree->capacity) {
+        assert(tree->capacity <= RB_ARRAY_INDEX_MAX / 2 && "Tree capacity exceeds 32-bit indices.");
+        rb_array_tree_reserve(tree, tree->capacity * 2);
+    }
+
+    uint32_t idx = tree->used;
+    tree->used += 1;
+    return idx;
+}
+
+static void node_release(Rb_Array_Tree* tree, uint32_t idx) {
+    tree->nodes[idx].left = tree->free_list;
+    tree->free_list = idx;
+}
+
+static void rotate_left(Rb_Array_Tree* tree, uint32_t idx) {
+    Rb_Array_Node* nodes = tree->nodes;
+    uint32_t pivot_idx  = nodes[idx].right;
+    uint32_t parent_idx = node_parent(tree, idx);
+
+    nodes[idx].right = nodes[pivot_idx].left;
+    if (nodes[pivot_idx].left != RB_ARRAY_NIL) {
+        set_parent(tree, nodes[pivot_idx].left, idx);
+    }
+
+    set_parent(tree, pivot_idx, parent_idx);
+    if (parent_idx == RB_ARRAY_NIL) {
+        tree->root = pivot_idx;
+    } else if (nodes[parent_idx].left == idx) {
+        nodes[parent_idx].left = pivot_idx;
+    } else {
+        nodes[parent_idx].right = pivot_idx;
+    }
+
+    nodes[pivot_idx].left = idx;
+    set_parent(tree, idx, pivot_idx);
+}
+
+static void rotate_right(Rb_Array_Tree* tree, uint32_t idx) {
+    Rb_Array_Node* nodes = tree->nodes;
+    uint32_t pivot_idx  = nodes[idx].left;
+    uint32_t parent_idx = node_parent(tree, idx);
+
+    nodes[idx].left = nodes[pivot_idx].right;
+    if (nodes[pivot_idx].right != RB_ARRAY_NIL) {
+        set_parent(tree, nodes[pivot_idx].right, idx);
+    }
+
+    set_parent(tree, pivot_idx, parent_idx);
+    if (parent_idx == RB_ARRAY_NIL) {
+        tree->root = pivot_idx;
+    } else if (nodes[parent_idx].right == idx) {
+        nodes[parent_idx].right = pivot_idx;
+    } else {
+        nodes[parent_idx].left = pivot_idx;
+    }
+
+    nodes[pivot_idx].right = idx;
+    set_parent(tree, idx, pivot_idx);
+}
+
+static void fix_insert_violations(Rb_Array_Tree* tree, uint32_t idx) {
+    Rb_Array_Node* nodes = tree->nodes;
+    while (node_is_red(tree, node_parent(tree, idx))) {
+        uint32_t parent_idx       = node_parent(tree, idx);
+        uint32_t grand_parent_idx = node_parent(tree, parent_idx);
+
+        if (nodes[grand_parent_idx].left == parent_idx) {
+            uint32_t uncle_idx = nodes[grand_parent_idx].right;
+            if (node_is_red(tree, uncle_idx)) {
+                set_black(tree, parent_idx);
+                set_black(tree, uncle_idx);
+                set_red(tree, grand_parent_idx);
+                idx = grand_parent_idx;
+                continue;
+            }
+
+            if (nodes[parent_idx].right == idx) {
+                idx = parent_idx;
+                rotate_left(tree, idx);
+                parent_idx = node_parent(tree, idx);
+            }
+            set_black(tree, parent_idx);
+            set_red(tree, grand_parent_idx);
+            rotate_right(tree, grand_parent_idx);
+        } else {
+            uint32_t uncle_idx = nodes[grand_parent_idx].left;
+            if (node_is_red(tree, uncle_idx)) {
+                set_black(tree, parent_idx);
+                set_black(tree, uncle_idx);
+                set_red(tree, grand_parent_idx);
+                idx = grand_parent_idx;
+                continue;
+            }
+
+            if (nodes[parent_idx].left == idx) {
+                idx = parent_idx;
+                rotate_right(tree, idx);
+                parent_idx = node_parent(tree, idx);
+            }
+            set_black(tree, parent_idx);
+            set_red(tree, grand_parent_idx);
+            rotate_left(tree, grand_parent_idx);
+        }
+    }
+
+    set_black(tree, tree->root);
+}
+
+void rb_array_tree_insert(Rb_Array_Tree* tree, uint32_t val) {
+    assert(tree != NULL && "Tree is NULL.");
+
+    // Allocate first, growing the array moves the nodes.
+    uint32_t new_idx = node_alloc(tree);
+    Rb_Array_Node* nodes = tree->nodes;
+
+    uint32_t parent_idx = RB_ARRAY_NIL;
+    uint32_t child_idx  = tree->root;
+    while (child_idx != RB_ARRAY_NIL) {
+        parent_idx = child_idx;
+        child_idx  = nodes[child_idx].val > val ? nodes[child_idx].left : nodes[child_idx].right;
+    }
+
+    nodes[new_idx].parent_color = parent_idx | RB_ARRAY_RED_BIT;
+    nodes[new_idx].left         = RB_ARRAY_NIL;
+    nodes[new_idx].right        = RB_ARRAY_NIL;
+    nodes[new_idx].val          = val;
+
+    if (parent_idx == RB_ARRAY_NIL) {
+        tree->root = new_idx;
+    } else if (nodes[parent_idx].val > val) {
+        nodes[parent_idx].left = new_idx;
+    } else {
+        nodes[parent_idx].right = new_idx;
+    }
+
+    tree->count += 1;
+    fix_insert_violations(tree, new_idx);
+}
+
+static uint32_t find(Rb_Array_Tree* tree, uint32_t val) {
+    Rb_Array_Node* nodes = tree->nodes;
+    uint32_t idx = tree->root;
+    while (idx != RB_ARRAY_NIL && nodes[idx].val != val) {
+        idx = nodes[idx].val > val ? nodes[idx].left : nodes[idx].right;
+    }
+
+    return idx;
+}
+
+bool rb_array_tree_search(Rb_Array_Tree* tree, uint32_t val) {
+    assert(tree != NULL && "Tree is NULL.");
+
+    return find(tree, val) != RB_ARRAY_NIL;
+}
+
+// Puts the subtree rooted at `src_idx` in place of the one rooted at `dst_idx`.
+static void transplant(Rb_Array_Tree* tree, uint32_t dst_idx, uint32_t src_idx) {
+    uint32_t parent_idx = node_parent(tree, dst_idx);
+    if (parent_idx == RB_ARRAY_NIL) {
+        tree->root = src_idx;
+    } else if (tree->nodes[parent_idx].left == dst_idx) {
+        tree->nodes[parent_idx].left = src_idx;
+    } else {
+        tree->nodes[parent_idx].right = src_idx;
+    }
+
+    // The sentinel parent is set as well, `fix_delete_violations` climbs from it.
+    set_parent(tree, src_idx, parent_idx);
+}
+
+static void fix_delete_violations(Rb_Array_Tree* tree, uint32_t idx) {
+    Rb_Array_Node* nodes = tree->nodes;
+    while (idx != tree->root && !node_is_red(tree, idx)) {
+        uint32_t parent_idx = node_parent(tree, idx);
+
+        if (nodes[parent_idx].left == idx) {
+            uint32_t sibling_idx = nodes[parent_idx].right;
+            if (node_is_red(tree, sibling_idx)) {
+                set_black(tree, sibling_idx);
+                set_red(tree, parent_idx);
+                rotate_left(tree, parent_idx);
+                sibling_idx = nodes[parent_idx].right;
+            }
+
+            if (!node_is_red(tree, nodes[sibling_idx].left) && !node_is_red(tree, nodes[sibling_idx].right)) {
+                set_red(tree, sibling_idx);
+                idx = parent_idx;
+                continue;
+            }
+
+            if (!node_is_red(tree, nodes[sibling_idx].right)) {
+                set_black(tree, nodes[sibling_idx].left);
+                set_red(tree, sibling_idx);
+                rotate_right(tree, sibling_idx);
+                sibling_idx = nodes[parent_idx].right;
+            }
+            copy_color(tree, sibling_idx, parent_idx);
+            set_black(tree, parent_idx);
+            set_black(tree, nodes[sibling_idx].right);
+            rotate_left(tree, parent_idx);
+        } else {
+            uint32_t sibling_idx = nodes[parent_idx].left;
+            if (node_is_red(tree, sibling_idx)) {
+                set_black(tree, sibling_idx);
+                set_red(tree, parent_idx);
+                rotate_right(tree, parent_idx);
+                sibling_idx = nodes[parent_idx].left;
+            }
+
+            if (!node_is_red(tree, nodes[sibling_idx].left) && !node_is_red(tree, nodes[sibling_idx].right)) {
+                set_red(tree, sibling_idx);
+                idx = parent_idx;
+                continue;
+            }
+
+            if (!node_is_red(tree, nodes[sibling_idx].left)) {
+                set_black(tree, nodes[sibling_idx].right);
+                set_red(tree, sibling_idx);
+                rotate_left(tree, sibling_idx);
+                sibling_idx = nodes[parent_idx].left;
+            }
+            copy_color(tree, sibling_idx, parent_idx);
+            set_black(tree, parent_idx);
+            set_black(tree, nodes[sibling_idx].left);
+            rotate_right(tree, parent_idx);
+        }
+
+        idx = tree->root;
+    }
+
+    set_black(tree, idx);
+}
+
+bool rb_array_tree_delete(Rb_Array_Tree* tree, uint32_t val) {
+    assert(tree != NULL && "Tree is NULL.");
+
+    uint32_t idx = find(tree, val);
+    if (idx == RB_ARRAY_NIL) {
+        return false;
+    }
+
+    Rb_Array_Node* nodes = tree->nodes;
+    bool removed_red = node_is_red(tree, idx);
+    uint32_t fix_idx;
+
+    if (nodes[idx].left == RB_ARRAY_NIL) {
+        fix_idx = nodes[idx].right;
+        transplant(tree, idx, fix_idx);
+    } else if (nodes[idx].right == RB_ARRAY_NIL) {
+        fix_idx = nodes[idx].left;
+        transplant(tree, idx, fix_idx);
+    } else {
+        // Replace the node by its successor, the leftmost node of its right subtree.
+        uint32_t successor_idx = nodes[idx].right;
+        while (nodes[successor_idx].left != RB_ARRAY_NIL) {
+            successor_idx = nodes[successor_idx].left;
+        }
+
+        removed_red = node_is_red(tree, successor_idx);
+        fix_idx     = nodes[successor_idx].right;
+        if (node_parent(tree, successor_idx) == idx) {
+            set_parent(tree, fix_idx, successor_idx);
+        } else {
+            transplant(tree, successor_idx, fix_idx);
+            nodes[successor_idx].right = nodes[idx].right;
+            set_parent(tree, nodes[successor_idx].right, successor_idx);
+        }
+
+        transplant(tree, idx, successor_idx);
+        nodes[successor_idx].left = nodes[idx].left;
+        set_parent(tree, nodes[successor_idx].left, successor_idx);
+        copy_color(tree, successor_idx, idx);
+    }
+
+    if (!removed_red) {
+        fix_delete_violations(tree, fix_idx);
+    }
+
+    // The sentinel may have been given a parent, it never keeps one.
+    nodes[RB_ARRAY_NIL].parent_color = RB_ARRAY_NIL;
+
+    node_release(tree, idx);
+    tree->count -= 1;
+    return true;
+}
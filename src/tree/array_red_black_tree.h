@@ -0,0 +1,50 @@
+#ifndef ARRAY_RED_BLACK_TREE_H
+#define ARRAY_RED_BLACK_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Red-black tree variant storing every node in a single growable array.
+//
+// Nodes link to each other with 32-bit indices into `nodes` instead of pointers,
+// and the color is packed in the top bit of the parent index, so a node takes 16
+// bytes instead of the 32 bytes of an `Rb_Node`. Index `RB_ARRAY_NIL` (0) is a
+// black sentinel standing for every missing child. Deleted slots are chained in
+// a free list and reused by the next insertions, once the array is large enough
+// inserting and deleting never allocate.
+//
+// Indices stay valid when the array grows, pointers to nodes do not.
+
+#define RB_ARRAY_NIL       0u
+#define RB_ARRAY_RED_BIT   0x80000000u
+#define RB_ARRAY_INDEX_MAX 0x7fffffffu
+
+typedef struct Rb_Array_Node {
+    uint32_t parent_color;
+    uint32_t left;
+    uint32_t right;
+    uint32_t val;
+} Rb_Array_Node;
+
+typedef struct Rb_Array_Tree {
+    Rb_Array_Node* nodes;
+    uint32_t       capacity;  // slots allocated in `nodes`, the sentinel included.
+    uint32_t       used;      // slots handed out at least once, the sentinel included.
+    uint32_t       free_list; // first released slot, chained through `left`.
+    uint32_t       root;
+    size_t         count;
+} Rb_Array_Tree;
+
+void rb_array_tree_init(Rb_Array_Tree* tree, uint32_t capacity);
+void rb_array_tree_free(Rb_Array_Tree* tree);
+// Grows the array so that `capacity` keys can be stored without allocating.
+void rb_array_tree_reserve(Rb_Array_Tree* tree, uint32_t capacity);
+size_t rb_array_tree_count(Rb_Array_Tree* tree);
+// Equal values are inserted to the right of the existing ones, like `rb_node_insert`.
+void rb_array_tree_insert(Rb_Array_Tree* tree, uint32_t val);
+bool rb_array_tree_search(Rb_Array_Tree* tree, uint32_t val);
+// Removes one node holding `val`, returns false when there is none.
+bool rb_array_tree_delete(Rb_Array_Tree* tree, uint32_t val);
+
+#endif  // ARRAY_RED_BLACK_TREE_H
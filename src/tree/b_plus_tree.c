@@ -0,0 +1,566 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "b_plus_tree.h"
+
+static_assert(B_PLUS_TREE_ORDER == 32, "node_rank compares exactly 32 keys.");
+
+// A node visited by a descent and the index of the child taken in it.
+typedef struct Path_Entry {
+    B_Plus_Tree_Node* node;
+    uint32_t          idx;
+} Path_Entry;
+
+static B_Plus_Tree_Node* node_new(B_Plus_Tree* tree, bool is_leaf) {
+    B_Plus_Tree_Node* node = (B_Plus_Tree_Node*) aligned_alloc(alignof(B_Plus_Tree_Node), sizeof(B_Plus_Tree_Node));
+    if (node == NULL) {
+        printf("Unable to allocate memory for a B+ tree node.");
+        exit(1);
+    }
+    // The unused keys are compared too by `node_rank`, before being masked out.
+    memset(node->keys, 0, sizeof(node->keys));
+    node->count   = 0;
+    node->is_leaf = is_leaf;
+    node->prev    = NULL;
+    node->next    = NULL;
+    tree->node_count += 1;
+    return node;
+}
+
+static void node_release(B_Plus_Tree* tree, B_Plus_Tree_Node* node) {
+    tree->node_count -= 1;
+    free(node);
+}
+
+// Number of the `count` first keys of `keys` strictly lower than `key`, or lower or
+// equal to it when `inclusive`. Since the keys are sorted this is the index of the
+// lower (upper when `inclusive`) bound of `key`. The whole node is always compared,
+// without branches, the lanes past `count` are masked out afterwards.
+static inline uint32_t node_rank(const uint32_t* keys, uint32_t count, uint32_t key, bool inclusive) {
+    uint32_t mask;
+
+#if defined(__AVX2__)
+    // There is no unsigned compare, flipping the sign bit maps the unsigned order to the signed one.
+    __m256i bias   = _mm256_set1_epi32(INT32_MIN);
+    __m256i needle = _mm256_xor_si256(_mm256_set1_epi32((int32_t) key), bias);
+    mask = 0;
+    for (uint32_t i = 0; i < B_PLUS_TREE_ORDER; i += 8) {
+        __m256i lanes = _mm256_xor_si256(_mm256_load_si256((const __m256i*) (keys + i)), bias);
+        __m256i cmp   = inclusive ? _mm256_cmpgt_epi32(lanes, needle) : _mm256_cmpgt_epi32(needle, lanes);
+        mask |= (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(cmp)) << i;
+    }
+#elif defined(__SSE2__)
+    __m128i bias   = _mm_set1_epi32(INT32_MIN);
+    __m128i needle = _mm_xor_si128(_mm_set1_epi32((int32_t) key), bias);
+    mask = 0;
+    for (uint32_t i = 0; i < B_PLUS_TREE_ORDER; i += 4) {
+        __m128i lanes = _mm_xor_si128(_mm_load_si128((const __m128i*) (keys + i)), bias);
+        __m128i cmp   = inclusive ? _mm_cmpgt_epi32(lanes, needle) : _mm_cmpgt_epi32(needle, lanes);
+        mask |= (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(cmp)) << i;
+    }
+#else
+    mask = 0;
+    for (uint32_t i = 0; i < B_PLUS_TREE_ORDER; i += 1) {
+        bool cmp = inclusive ? keys[i] > key : keys[i] < key;
+        mask |= (uint32_t) cmp << i;
+    }
+#endif
+
+    // Inclusive compares computed `keys[i] > key`, the complement is `keys[i] <= key`.
+    if (inclusive) {
+        mask = ~mask;
+    }
+    if (count < B_PLUS_TREE_ORDER) {
+        mask &= (1u << count) - 1;
+    }
+    return (uint32_t) __builtin_popcount(mask);
+}
+
+// Walks from the root to the leaf that holds or would hold `key`, recording the path
+// in `path` when not NULL. `tree` must not be empty.
+static B_Plus_Tree_Node* descend(B_Plus_Tree* tree, uint32_t key, Path_Entry* path, uint32_t* depth) {
+    B_Plus_Tree_Node* node = tree->root;
+    uint32_t level = 0;
+    while (!node->is_leaf) {
+        uint32_t idx = node_rank(node->keys, node->count, key, true);
+        if (path != NULL) {
+            path[level].node = node;
+            path[level].idx  = idx;
+        }
+        level += 1;
+        node = node->children[idx];
+        // The keys span two cache lines, the first one is requested by the next compare.
+        __builtin_prefetch(node->keys + 16);
+    }
+    if (depth != NULL) {
+        *depth = level;
+    }
+    return node;
+}
+
+static void leaf_insert_at(B_Plus_Tree_Node* leaf, uint32_t idx, uint32_t key, void* value) {
+    memmove(&leaf->keys[idx + 1], &leaf->keys[idx], (leaf->count - idx) * sizeof(uint32_t));
+    memmove(&leaf->values[idx + 1], &leaf->values[idx], (leaf->count - idx) * sizeof(void*));
+    leaf->keys[idx]   = key;
+    leaf->values[idx] = value;
+    leaf->count += 1;
+}
+
+// Inserts separator `sep_key` and the new node `right` next to `left` in their parent,
+// the last node of `path`, splitting the ancestors that are full.
+static void insert_into_parent(B_Plus_Tree* tree, Path_Entry* path, uint32_t depth,
+                               B_Plus_Tree_Node* left, uint32_t sep_key, B_Plus_Tree_Node* right) {
+    while (depth > 0) {
+        depth -= 1;
+        B_Plus_Tree_Node* parent = path[depth].node;
+        uint32_t pos = path[depth].idx;
+
+        if (parent->count < B_PLUS_TREE_ORDER) {
+            memmove(&parent->keys[pos + 1], &parent->keys[pos], (parent->count - pos) * sizeof(uint32_t));
+            memmove(&parent->children[pos + 2], &parent->children[pos + 1],
+                    (parent->count - pos) * sizeof(B_Plus_Tree_Node*));
+            parent->keys[pos]         = sep_key;
+            parent->children[pos + 1] = right;
+            parent->count += 1;
+            return;
+        }
+
+        // The parent is full: lay out its keys and children with the new ones, then
+        // keep the lower half, promote the middle key and move the upper half.
+        uint32_t          keys[B_PLUS_TREE_ORDER + 1];
+        B_Plus_Tree_Node* children[B_PLUS_TREE_ORDER + 2];
+        memcpy(keys, parent->keys, pos * sizeof(uint32_t));
+        keys[pos] = sep_key;
+        memcpy(&keys[pos + 1], &parent->keys[pos], (B_PLUS_TREE_ORDER - pos) * sizeof(uint32_t));
+        memcpy(children, parent->children, (pos + 1) * sizeof(B_Plus_Tree_Node*));
+        children[pos + 1] = right;
+        memcpy(&children[pos + 2], &parent->children[pos + 1], (B_PLUS_TREE_ORDER - pos) * sizeof(B_Plus_Tree_Node*));
+
+        uint32_t left_count  = (B_PLUS_TREE_ORDER + 1) / 2;
+        uint32_t right_count = B_PLUS_TREE_ORDER - left_count;
+        B_Plus_Tree_Node* sibling = node_new(tree, false);
+        memcpy(parent->keys, keys, left_count * sizeof(uint32_t));
+        memcpy(parent->children, children, (left_count + 1) * sizeof(B_Plus_Tree_Node*));
+        parent->count = left_count;
+        memcpy(sibling->keys, &keys[left_count + 1], right_count * sizeof(uint32_t));
+        memcpy(sibling->children, &children[left_count + 1], (right_count + 1) * sizeof(B_Plus_Tree_Node*));
+        sibling->count = right_count;
+
+        left    = parent;
+        sep_key = keys[left_count];
+        right   = sibling;
+    }
+
+    B_Plus_Tree_Node* root = node_new(tree, false);
+    root->keys[0]     = sep_key;
+    root->children[0] = left;
+    root->children[1] = right;
+    root->count       = 1;
+    tree->root    = root;
+    tree->height += 1;
+}
+
+void b_plus_tree_init(B_Plus_Tree* tree) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    tree->root       = NULL;
+    tree->count      = 0;
+    tree->height     = 0;
+    tree->node_count = 0;
+}
+
+static void free_subtree(B_Plus_Tree_Node* node) {
+    if (!node->is_leaf) {
+        for (uint32_t i = 0; i <= node->count; i += 1) {
+            free_subtree(node->children[i]);
+        }
+    }
+    free(node);
+}
+
+void b_plus_tree_free(B_Plus_Tree* tree) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    if (tree->root != NULL) {
+        free_subtree(tree->root);
+    }
+    b_plus_tree_init(tree);
+}
+
+size_t b_plus_tree_count(B_Plus_Tree* tree) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    return tree->count;
+}
+
+size_t b_plus_tree_memory_usage(B_Plus_Tree* tree) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    return tree->node_count * sizeof(B_Plus_Tree_Node);
+}
+
+bool b_plus_tree_insert(B_Plus_Tree* tree, uint32_t key, void* value) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    if (tree->root == NULL) {
+        B_Plus_Tree_Node* root = node_new(tree, true);
+        root->keys[0]   = key;
+        root->values[0] = value;
+        root->count     = 1;
+        tree->root   = root;
+        tree->count  = 1;
+        tree->height = 1;
+        return true;
+    }
+
+    Path_Entry path[B_PLUS_TREE_MAX_HEIGHT];
+    uint32_t depth;
+    B_Plus_Tree_Node* leaf = descend(tree, key, path, &depth);
+    uint32_t idx = node_rank(leaf->keys, leaf->count, key, false);
+    if (idx < leaf->count && leaf->keys[idx] == key) {
+        leaf->values[idx] = value;
+        return false;
+    }
+
+    tree->count += 1;
+    if (leaf->count < B_PLUS_TREE_ORDER) {
+        leaf_insert_at(leaf, idx, key, value);
+        return true;
+    }
+
+    // The leaf is full: once the key is added the left half keeps `left_count` keys,
+    // so the split point depends on the side the new key goes to.
+    uint32_t left_count = (B_PLUS_TREE_ORDER + 2) / 2;
+    uint32_t split_idx  = idx < left_count ? left_count - 1 : left_count;
+    B_Plus_Tree_Node* right = node_new(tree, true);
+    right->count = B_PLUS_TREE_ORDER - split_idx;
+    memcpy(right->keys, &leaf->keys[split_idx], right->count * sizeof(uint32_t));
+    memcpy(right->values, &leaf->values[split_idx], right->count * sizeof(void*));
+    leaf->count = split_idx;
+    if (idx < left_count) {
+        leaf_insert_at(leaf, idx, key, value);
+    } else {
+        leaf_insert_at(right, idx - split_idx, key, value);
+    }
+
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next != NULL) {
+        leaf->next->prev = right;
+    }
+    leaf->next = right;
+
+    insert_into_parent(tree, path, depth, leaf, right->keys[0], right);
+    return true;
+}
+
+// Moves the last entry of `left` to the front of `node`, its right sibling under `parent`.
+static void borrow_from_left(B_Plus_Tree_Node* parent, uint32_t pos, B_Plus_Tree_Node* node, B_Plus_Tree_Node* left) {
+    memmove(&node->keys[1], &node->keys[0], node->count * sizeof(uint32_t));
+    if (node->is_leaf) {
+        memmove(&node->values[1], &node->values[0], node->count * sizeof(void*));
+        node->keys[0]   = left->keys[left->count - 1];
+        node->values[0] = left->values[left->count - 1];
+        parent->keys[pos - 1] = node->keys[0];
+    } else {
+        memmove(&node->children[1], &node->children[0], (node->count + 1) * sizeof(B_Plus_Tree_Node*));
+        node->keys[0]     = parent->keys[pos - 1];
+        node->children[0] = left->children[left->count];
+        parent->keys[pos - 1] = left->keys[left->count - 1];
+    }
+    left->count -= 1;
+    node->count += 1;
+}
+
+// Moves the first entry of `right` to the end of `node`, its left sibling under `parent`.
+static void borrow_from_right(B_Plus_Tree_Node* parent, uint32_t pos, B_Plus_Tree_Node* node, B_Plus_Tree_Node* right) {
+    if (node->is_leaf) {
+        node->keys[node->count]   = right->keys[0];
+        node->values[node->count] = right->values[0];
+        memmove(&right->values[0], &right->values[1], (right->count - 1) * sizeof(void*));
+        memmove(&right->keys[0], &right->keys[1], (right->count - 1) * sizeof(uint32_t));
+        parent->keys[pos] = right->keys[0];
+    } else {
+        node->keys[node->count]         = parent->keys[pos];
+        node->children[node->count + 1] = right->children[0];
+        parent->keys[pos] = right->keys[0];
+        memmove(&right->keys[0], &right->keys[1], (right->count - 1) * sizeof(uint32_t));
+        memmove(&right->children[0], &right->children[1], right->count * sizeof(B_Plus_Tree_Node*));
+    }
+    right->count -= 1;
+    node->count += 1;
+}
+
+// Appends `right` to `left`, its left sibling separated by `parent->keys[sep_idx]`,
+// then removes `right` and the separator from `parent`.
+static void merge_nodes(B_Plus_Tree* tree, B_Plus_Tree_Node* parent, uint32_t sep_idx,
+                        B_Plus_Tree_Node* left, B_Plus_Tree_Node* right) {
+    if (left->is_leaf) {
+        memcpy(&left->keys[left->count], right->keys, right->count * sizeof(uint32_t));
+        memcpy(&left->values[left->count], right->values, right->count * sizeof(void*));
+        left->count += right->count;
+        left->next = right->next;
+        if (right->next != NULL) {
+            right->next->prev = left;
+        }
+    } else {
+        left->keys[left->count] = parent->keys[sep_idx];
+        memcpy(&left->keys[left->count + 1], right->keys, right->count * sizeof(uint32_t));
+        memcpy(&left->children[left->count + 1], right->children, (right->count + 1) * sizeof(B_Plus_Tree_Node*));
+        left->count += right->count + 1;
+    }
+
+    memmove(&parent->keys[sep_idx], &parent->keys[sep_idx + 1], (parent->count - sep_idx - 1) * sizeof(uint32_t));
+    memmove(&parent->children[sep_idx + 1], &parent->children[sep_idx + 2],
+            (parent->count - sep_idx - 1) * sizeof(B_Plus_Tree_Node*));
+    parent->count -= 1;
+    node_release(tree, right);
+}
+
+bool b_plus_tree_delete(B_Plus_Tree* tree, uint32_t key, void** removed_value) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    if (tree->root == NULL) {
+        return false;
+    }
+
+    Path_Entry path[B_PLUS_TREE_MAX_HEIGHT];
+    uint32_t depth;
+    B_Plus_Tree_Node* node = descend(tree, key, path, &depth);
+    uint32_t idx = node_rank(node->keys, node->count, key, false);
+    if (idx == node->count || node->keys[idx] != key) {
+        return false;
+    }
+
+    if (removed_value != NULL) {
+        *removed_value = node->values[idx];
+    }
+    memmove(&node->keys[idx], &node->keys[idx + 1], (node->count - idx - 1) * sizeof(uint32_t));
+    memmove(&node->values[idx], &node->values[idx + 1], (node->count - idx - 1) * sizeof(void*));
+    node->count -= 1;
+    tree->count -= 1;
+
+    // Refill the underflowing nodes from a sibling with keys to spare, or merge them
+    // with a sibling, which takes a key from the parent that may then underflow too.
+    while (depth > 0 && node->count < B_PLUS_TREE_MIN_KEYS) {
+        depth -= 1;
+        B_Plus_Tree_Node* parent = path[depth].node;
+        uint32_t pos = path[depth].idx;
+        B_Plus_Tree_Node* left  = pos > 0 ? parent->children[pos - 1] : NULL;
+        B_Plus_Tree_Node* right = pos < parent->count ? parent->children[pos + 1] : NULL;
+
+        if (left != NULL && left->count > B_PLUS_TREE_MIN_KEYS) {
+            borrow_from_left(parent, pos, node, left);
+            return true;
+        }
+        if (right != NULL && right->count > B_PLUS_TREE_MIN_KEYS) {
+            borrow_from_right(parent, pos, node, right);
+            return true;
+        }
+        if (left != NULL) {
+            merge_nodes(tree, parent, pos - 1, left, node);
+        } else {
+            merge_nodes(tree, parent, pos, node, right);
+        }
+        node = parent;
+    }
+
+    B_Plus_Tree_Node* root = tree->root;
+    if (root->count == 0) {
+        tree->root = root->is_leaf ? NULL : root->children[0];
+        tree->height -= 1;
+        node_release(tree, root);
+    }
+    return true;
+}
+
+bool b_plus_tree_find(B_Plus_Tree* tree, uint32_t key, void** value) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    if (tree->root == NULL) {
+        return false;
+    }
+
+    B_Plus_Tree_Node* leaf = descend(tree, key, NULL, NULL);
+    uint32_t idx = node_rank(leaf->keys, leaf->count, key, false);
+    if (idx == leaf->count || leaf->keys[idx] != key) {
+        return false;
+    }
+    if (value != NULL) {
+        *value = leaf->values[idx];
+    }
+    return true;
+}
+
+// Cursor on the `idx`-th key of `leaf`, moving to the next leaf when `idx` is past its last key.
+static B_Plus_Tree_Cursor cursor_at(B_Plus_Tree_Node* leaf, uint32_t idx) {
+    if (idx == leaf->count) {
+        leaf = leaf->next;
+        idx  = 0;
+    }
+    return (B_Plus_Tree_Cursor) { .leaf = leaf, .idx = idx };
+}
+
+B_Plus_Tree_Cursor b_plus_tree_lower_bound(B_Plus_Tree* tree, uint32_t key) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    if (tree->root == NULL) {
+        return (B_Plus_Tree_Cursor) { .leaf = NULL, .idx = 0 };
+    }
+    B_Plus_Tree_Node* leaf = descend(tree, key, NULL, NULL);
+    return cursor_at(leaf, node_rank(leaf->keys, leaf->count, key, false));
+}
+
+B_Plus_Tree_Cursor b_plus_tree_upper_bound(B_Plus_Tree* tree, uint32_t key) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    if (tree->root == NULL) {
+        return (B_Plus_Tree_Cursor) { .leaf = NULL, .idx = 0 };
+    }
+    B_Plus_Tree_Node* leaf = descend(tree, key, NULL, NULL);
+    return cursor_at(leaf, node_rank(leaf->keys, leaf->count, key, true));
+}
+
+B_Plus_Tree_Cursor b_plus_tree_first(B_Plus_Tree* tree) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    B_Plus_Tree_Node* node = tree->root;
+    while (node != NULL && !node->is_leaf) {
+        node = node->children[0];
+    }
+    return (B_Plus_Tree_Cursor) { .leaf = node, .idx = 0 };
+}
+
+B_Plus_Tree_Cursor b_plus_tree_last(B_Plus_Tree* tree) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    B_Plus_Tree_Node* node = tree->root;
+    while (node != NULL && !node->is_leaf) {
+        node = node->children[node->count];
+    }
+    return (B_Plus_Tree_Cursor) { .leaf = node, .idx = node != NULL ? node->count - 1 : 0 };
+}
+
+bool b_plus_tree_cursor_next(B_Plus_Tree_Cursor* cursor) {
+    assert(cursor != NULL && cursor->leaf != NULL && "B+ tree cursor is past the end.");
+    *cursor = cursor_at(cursor->leaf, cursor->idx + 1);
+    return cursor->leaf != NULL;
+}
+
+bool b_plus_tree_cursor_prev(B_Plus_Tree_Cursor* cursor) {
+    assert(cursor != NULL && cursor->leaf != NULL && "B+ tree cursor is past the end.");
+    if (cursor->idx > 0) {
+        cursor->idx -= 1;
+        return true;
+    }
+    cursor->leaf = cursor->leaf->prev;
+    cursor->idx  = cursor->leaf != NULL ? cursor->leaf->count - 1 : 0;
+    return cursor->leaf != NULL;
+}
+
+bool b_plus_tree_cursor_valid(B_Plus_Tree_Cursor cursor) {
+    return cursor.leaf != NULL;
+}
+
+uint32_t b_plus_tree_cursor_key(B_Plus_Tree_Cursor cursor) {
+    assert(cursor.leaf != NULL && "B+ tree cursor is past the end.");
+    return cursor.leaf->keys[cursor.idx];
+}
+
+void* b_plus_tree_cursor_value(B_Plus_Tree_Cursor cursor) {
+    assert(cursor.leaf != NULL && "B+ tree cursor is past the end.");
+    return cursor.leaf->values[cursor.idx];
+}
+
+size_t b_plus_tree_range(B_Plus_Tree* tree, uint32_t lo, uint32_t hi, B_Plus_Tree_Visit_Fn visit, void* ctx) {
+    assert(visit != NULL && "B+ tree visit function is NULL.");
+    size_t visited = 0;
+    if (lo > hi) {
+        return 0;
+    }
+
+    B_Plus_Tree_Cursor cursor = b_plus_tree_lower_bound(tree, lo);
+    for (B_Plus_Tree_Node* leaf = cursor.leaf; leaf != NULL; leaf = leaf->next) {
+        for (uint32_t i = leaf == cursor.leaf ? cursor.idx : 0; i < leaf->count; i += 1) {
+            if (leaf->keys[i] > hi) {
+                return visited;
+            }
+            visited += 1;
+            if (!visit(leaf->keys[i], leaf->values[i], ctx)) {
+                return visited;
+            }
+        }
+    }
+    return visited;
+}
+
+typedef struct Validate_State {
+    B_Plus_Tree_Node* prev_leaf;
+    size_t            key_count;
+    size_t            node_count;
+} Validate_State;
+
+// Checks the subtree of `node` at `level` (the root is at level 1), whose keys must lie
+// in `[lo, hi]`, visiting the leaves in order.
+static bool validate_node(B_Plus_Tree* tree, B_Plus_Tree_Node* node, uint32_t level,
+                          uint64_t lo, uint64_t hi, Validate_State* state) {
+    state->node_count += 1;
+    if (node != tree->root && node->count < B_PLUS_TREE_MIN_KEYS) {
+        printf("B+ tree: a node holds %u keys, less than the minimum.\n", node->count);
+        return false;
+    }
+    if (node->count == 0 || node->count > B_PLUS_TREE_ORDER) {
+        printf("B+ tree: a node holds %u keys.\n", node->count);
+        return false;
+    }
+    for (uint32_t i = 0; i < node->count; i += 1) {
+        if (node->keys[i] < lo || node->keys[i] > hi || (i > 0 && node->keys[i - 1] >= node->keys[i])) {
+            printf("B+ tree: key %u is out of order.\n", node->keys[i]);
+            return false;
+        }
+    }
+
+    if (node->is_leaf) {
+        if (level != tree->height) {
+            printf("B+ tree: a leaf is at depth %u instead of %u.\n", level, tree->height);
+            return false;
+        }
+        if (node->prev != state->prev_leaf || (state->prev_leaf != NULL && state->prev_leaf->next != node)) {
+            printf("B+ tree: the leaf holding %u is badly linked.\n", node->keys[0]);
+            return false;
+        }
+        state->prev_leaf  = node;
+        state->key_count += node->count;
+        return true;
+    }
+
+    for (uint32_t i = 0; i <= node->count; i += 1) {
+        uint64_t child_lo = i > 0 ? node->keys[i - 1] : lo;
+        uint64_t child_hi = i < node->count ? (uint64_t) node->keys[i] - 1 : hi;
+        if (!validate_node(tree, node->children[i], level + 1, child_lo, child_hi, state)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool b_plus_tree_validate(B_Plus_Tree* tree) {
+    assert(tree != NULL && "B+ tree is NULL.");
+    if (tree->root == NULL) {
+        if (tree->count != 0 || tree->height != 0 || tree->node_count != 0) {
+            printf("B+ tree: an empty tree has non zero counts.\n");
+            return false;
+        }
+        return true;
+    }
+
+    Validate_State state = { .prev_leaf = NULL, .key_count = 0, .node_count = 0 };
+    if (!validate_node(tree, tree->root, 1, 0, UINT32_MAX, &state)) {
+        return false;
+    }
+    if (state.prev_leaf->next != NULL) {
+        printf("B+ tree: the last leaf has a next leaf.\n");
+        return false;
+    }
+    if (state.key_count != tree->count || state.node_count != tree->node_count) {
+        printf("B+ tree: %zu keys in %zu nodes, the tree caches %zu keys in %zu nodes.\n",
+               state.key_count, state.node_count, tree->count, tree->node_count);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,296 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "order_statistic_tree.h"
+
+static uint32_t node_size(Os_Rb_Node* node) {
+    return node != NULL ? node->size : 0;
+}
+
+// Recomputes the aggregates of `node` from its value and the aggregates of its children.
+static void update_aggregates(Os_Rb_Node* node) {
+    node->size = 1;
+    node->sum  = node->value;
+    node->min  = node->value;
+    node->max  = node->value;
+
+    Os_Rb_Node* children[2] = { node->left, node->right };
+    for (size_t i = 0; i < 2; i += 1) {
+        Os_Rb_Node* child = children[i];
+        if (child == NULL) {
+            continue;
+        }
+        node->size += child->size;
+        node->sum  += child->sum;
+        if (child->min < node->min) { node->min = child->min; }
+        if (child->max > node->max) { node->max = child->max; }
+    }
+}
+
+// Recomputes the aggregates from `node` up to the root.
+static void update_path(Os_Rb_Node* node) {
+    for (; node != NULL; node = node->parent) {
+        update_aggregates(node);
+    }
+}
+
+// The rebalancing of `red_black_tree.c`. The subtree of a rotation keeps the same set
+// of nodes, so only `node` and `pivot` need their aggregates recomputed, bottom-up.
+// Unlinking recomputes them along the path of the subtrees that lost a node, before
+// the fixup rotations which then keep them right.
+#define OS_ROTATED(node, pivot) (update_aggregates(node), update_aggregates(pivot))
+
+RB_TREE_DEFINE_BALANCE(os_rb, Os_Rb_Node, OS_ROTATED, RB_TREE_NO_HOOK, update_path)
+
+void os_rb_node_free(Os_Rb_Node* root) {
+    // Post-order walk using the parent links, see `rb_node_free`.
+    Os_Rb_Node* node = root;
+    while (node != NULL) {
+        if (node->left != NULL) {
+            node = node->left;
+        } else if (node->right != NULL) {
+            node = node->right;
+        } else {
+            Os_Rb_Node* parent_node = node == root ? NULL : node->parent;
+            if (parent_node != NULL) {
+                if (parent_node->left == node) {
+                    parent_node->left = NULL;
+                } else {
+                    parent_node->right = NULL;
+                }
+            }
+            free(node);
+            node = parent_node;
+        }
+    }
+}
+
+size_t os_rb_node_size(Os_Rb_Node* root) {
+    return node_size(root);
+}
+
+bool os_rb_node_insert(Os_Rb_Node** root, uint32_t key, int32_t value) {
+    return os_rb_node_insert_pooled(NULL, root, key, value);
+}
+
+bool os_rb_node_insert_pooled(Node_Pool* pool, Os_Rb_Node** root, uint32_t key, int32_t value) {
+    Os_Rb_Node* parent_node = NULL;
+    Os_Rb_Node* child_node  = *root;
+    while (child_node != NULL) {
+        if (child_node->key == key) {
+            child_node->value = value;
+            update_path(child_node);
+            return false;
+        }
+        parent_node = child_node;
+        child_node  = key < child_node->key ? child_node->left : child_node->right;
+    }
+
+    child_node = pool != NULL ? (Os_Rb_Node*) node_pool_alloc(pool) : (Os_Rb_Node*) malloc(sizeof(Os_Rb_Node));
+    if (child_node == NULL) {
+        printf("Unable to allocate memory for an order statistic tree node.");
+        exit(1);
+    }
+    child_node->parent = parent_node;
+    child_node->left   = NULL;
+    child_node->right  = NULL;
+    child_node->key    = key;
+    child_node->value  = value;
+    child_node->color  = parent_node == NULL ? NODE_BLACK : NODE_RED;
+
+    if (parent_node == NULL) {
+        *root = child_node;
+    } else if (key < parent_node->key) {
+        parent_node->left = child_node;
+    } else {
+        parent_node->right = child_node;
+    }
+
+    // The aggregates are made right along the path first, rotations then keep them right.
+    update_path(child_node);
+    os_rb_fix_violations(root, child_node);
+    return true;
+}
+
+bool os_rb_node_delete(Os_Rb_Node** root, uint32_t key, int32_t* removed_value) {
+    return os_rb_node_delete_pooled(NULL, root, key, removed_value);
+}
+
+bool os_rb_node_delete_pooled(Node_Pool* pool, Os_Rb_Node** root, uint32_t key, int32_t* removed_value) {
+    Os_Rb_Node* node = os_rb_node_find(*root, key);
+    if (node == NULL) {
+        return false;
+    }
+
+    if (removed_value != NULL) {
+        *removed_value = node->value;
+    }
+
+    os_rb_unlink(root, node);
+    if (pool != NULL) {
+        node_pool_release(pool, node);
+    } else {
+        free(node);
+    }
+    return true;
+}
+
+Os_Rb_Node* os_rb_node_find(Os_Rb_Node* root, uint32_t key) {
+    Os_Rb_Node* node = root;
+    while (node != NULL && node->key != key) {
+        node = key < node->key ? node->left : node->right;
+    }
+
+    return node;
+}
+
+size_t os_rb_node_rank(Os_Rb_Node* root, uint32_t key) {
+    size_t rank = 0;
+    Os_Rb_Node* node = root;
+    while (node != NULL) {
+        if (key <= node->key) {
+            node = node->left;
+        } else {
+            rank += node_size(node->left) + 1;
+            node = node->right;
+        }
+    }
+
+    return rank;
+}
+
+Os_Rb_Node* os_rb_node_select(Os_Rb_Node* root, size_t k) {
+    Os_Rb_Node* node = root;
+    while (node != NULL) {
+        size_t left_size = node_size(node->left);
+        if (k < left_size) {
+            node = node->left;
+        } else if (k == left_size) {
+            return node;
+        } else {
+            k   -= left_size + 1;
+            node = node->right;
+        }
+    }
+
+    return NULL;
+}
+
+static void stats_add(Os_Rb_Stats* stats, size_t count, int64_t sum, int32_t min, int32_t max) {
+    if (stats->count == 0 || min < stats->min) { stats->min = min; }
+    if (stats->count == 0 || max > stats->max) { stats->max = max; }
+    stats->count += count;
+    stats->sum   += sum;
+}
+
+static void stats_add_subtree(Os_Rb_Stats* stats, Os_Rb_Node* node) {
+    if (node != NULL) {
+        stats_add(stats, node->size, node->sum, node->min, node->max);
+    }
+}
+
+static void stats_add_node(Os_Rb_Stats* stats, Os_Rb_Node* node) {
+    stats_add(stats, 1, node->value, node->value, node->value);
+}
+
+Os_Rb_Stats os_rb_node_range_stats(Os_Rb_Node* root, uint32_t lo, uint32_t hi) {
+    Os_Rb_Stats stats = { 0, 0, 0, 0 };
+    if (lo > hi) {
+        return stats;
+    }
+
+    // Descends to the first node within the range, where the paths to `lo` and `hi` split.
+    Os_Rb_Node* split_node = root;
+    while (split_node != NULL && (split_node->key < lo || split_node->key > hi)) {
+        split_node = split_node->key < lo ? split_node->right : split_node->left;
+    }
+    if (split_node == NULL) {
+        return stats;
+    }
+    stats_add_node(&stats, split_node);
+
+    // Along the path to `lo`, every node within the range has its whole right subtree
+    // within the range too.
+    for (Os_Rb_Node* node = split_node->left; node != NULL;) {
+        if (node->key >= lo) {
+            stats_add_node(&stats, node);
+            stats_add_subtree(&stats, node->right);
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+
+    // Symmetrically for the left subtrees along the path to `hi`.
+    for (Os_Rb_Node* node = split_node->right; node != NULL;) {
+        if (node->key <= hi) {
+            stats_add_node(&stats, node);
+            stats_add_subtree(&stats, node->left);
+            node = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+
+    return stats;
+}
+
+size_t os_rb_node_count_in_range(Os_Rb_Node* root, uint32_t lo, uint32_t hi) {
+    return os_rb_node_range_stats(root, lo, hi).count;
+}
+
+int64_t os_rb_node_sum_in_range(Os_Rb_Node* root, uint32_t lo, uint32_t hi) {
+    return os_rb_node_range_stats(root, lo, hi).sum;
+}
+
+// Returns the black height of the subtree, -1 when it breaks a property.
+static int validate_subtree(Os_Rb_Node* node, Os_Rb_Node* parent_node, const uint32_t* min_key, const uint32_t* max_key) {
+    if (node == NULL) {
+        return 1;
+    }
+
+    if (node->parent != parent_node) {
+        printf("Order statistic tree: key %u has a wrong parent link.\n", node->key);
+        return -1;
+    }
+    if ((min_key != NULL && node->key <= *min_key) || (max_key != NULL && node->key >= *max_key)) {
+        printf("Order statistic tree: key %u is out of order.\n", node->key);
+        return -1;
+    }
+    if (node->color == NODE_RED && (os_rb_color(node->left) == NODE_RED || os_rb_color(node->right) == NODE_RED)) {
+        printf("Order statistic tree: red key %u has a red child.\n", node->key);
+        return -1;
+    }
+
+    int left_height  = validate_subtree(node->left, node, min_key, &node->key);
+    int right_height = validate_subtree(node->right, node, &node->key, max_key);
+    if (left_height < 0 || right_height < 0) {
+        return -1;
+    }
+    if (left_height != right_height) {
+        printf("Order statistic tree: key %u has unbalanced black heights.\n", node->key);
+        return -1;
+    }
+
+    Os_Rb_Node expected = *node;
+    update_aggregates(&expected);
+    if (expected.size != node->size || expected.sum != node->sum || expected.min != node->min || expected.max != node->max) {
+        printf("Order statistic tree: key %u has stale aggregates.\n", node->key);
+        return -1;
+    }
+
+    return left_height + (node->color == NODE_BLACK ? 1 : 0);
+}
+
+bool os_rb_node_validate(Os_Rb_Node* root) {
+    if (root == NULL) {
+        return true;
+    }
+
+    if (root->color != NODE_BLACK) {
+        printf("Order statistic tree: the root is not black.\n");
+        return false;
+    }
+
+    return validate_subtree(root, root->parent, NULL, NULL) >= 0;
+}
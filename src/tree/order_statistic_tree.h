@@ -0,0 +1,82 @@
+#ifndef ORDER_STATISTIC_TREE_H
+#define ORDER_STATISTIC_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "memory/node_pool.h"
+#include "tree/red_black_tree.h"
+
+// Red-black tree from `uint32_t` keys to `int32_t` values, augmented with aggregates
+// of every subtree: its number of nodes and the sum, minimum and maximum of its
+// values. The aggregates are maintained along the insertion and deletion paths and
+// through every rotation, which makes rank, select and range aggregate queries
+// O(log n) instead of an in-order walk of `Rb_Node`.
+//
+// Same conventions as `red_black_tree.h`: a tree is designated by a pointer to its
+// root node, `NULL` for an empty tree, and updates take the address of that pointer.
+typedef struct Os_Rb_Node {
+    struct Os_Rb_Node* parent;
+    struct Os_Rb_Node* left;
+    struct Os_Rb_Node* right;
+    int64_t            sum;
+    uint32_t           key;
+    int32_t            value;
+    uint32_t           size;
+    int32_t            min;
+    int32_t            max;
+    Rb_Node_Color      color;
+} Os_Rb_Node;
+
+// Aggregates of the values of a key range, `min` and `max` are only meaningful when
+// `count` is not 0.
+typedef struct Os_Rb_Stats {
+    size_t  count;
+    int64_t sum;
+    int32_t min;
+    int32_t max;
+} Os_Rb_Stats;
+
+// Frees every node of the tree, iteratively so that the call stack stays flat.
+void os_rb_node_free(Os_Rb_Node* root);
+
+// Number of keys in the tree, O(1).
+size_t os_rb_node_size(Os_Rb_Node* root);
+
+// Inserts `key` mapped to `value`. Returns true when the key was not in the tree,
+// false when it was, in which case only its value (and the aggregates) are updated.
+bool os_rb_node_insert(Os_Rb_Node** root, uint32_t key, int32_t value);
+// Removes `key` from the tree, storing its value in `removed_value` when not NULL.
+// Returns false when the key is not in the tree.
+bool os_rb_node_delete(Os_Rb_Node** root, uint32_t key, int32_t* removed_value);
+
+// Returns the node holding `key`, NULL when there is none.
+Os_Rb_Node* os_rb_node_find(Os_Rb_Node* root, uint32_t key);
+
+// Number of keys strictly smaller than `key`, which is the index `key` has or would
+// have in sorted order.
+size_t os_rb_node_rank(Os_Rb_Node* root, uint32_t key);
+// Returns the node with the `k`-th smallest key (0 based), NULL when `k` is not
+// smaller than the size of the tree.
+Os_Rb_Node* os_rb_node_select(Os_Rb_Node* root, size_t k);
+
+// Aggregates of the values of the keys in `[lo, hi]`, visiting O(log n) nodes.
+Os_Rb_Stats os_rb_node_range_stats(Os_Rb_Node* root, uint32_t lo, uint32_t hi);
+// Number of keys in `[lo, hi]`.
+size_t os_rb_node_count_in_range(Os_Rb_Node* root, uint32_t lo, uint32_t hi);
+// Sum of the values of the keys in `[lo, hi]`.
+int64_t os_rb_node_sum_in_range(Os_Rb_Node* root, uint32_t lo, uint32_t hi);
+
+// Checks the red-black properties like `rb_node_validate`, and that the aggregates of
+// every node match its subtree. Returns false, after printing the first violation
+// found, on a broken tree.
+bool os_rb_node_validate(Os_Rb_Node* root);
+
+// Same as above, with nodes taken from and given back to `pool` (node size
+// `sizeof(Os_Rb_Node)`) instead of `malloc` and `free`. A NULL pool falls back to
+// `malloc` and `free`.
+bool os_rb_node_insert_pooled(Node_Pool* pool, Os_Rb_Node** root, uint32_t key, int32_t value);
+bool os_rb_node_delete_pooled(Node_Pool* pool, Os_Rb_Node** root, uint32_t key, int32_t* removed_value);
+
+#endif  // ORDER_STATISTIC_TREE_H
@@ -1,125 +1,629 @@
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "red_black_tree.h"
+#include "instrument.h"
 
-static Rb_Node_Color node_color(Rb_Node* node) {
-    if (node == NULL) { return NODE_BLACK; }
-    return node->color;
-}
+// Rotations, fixups and unlinking come from `red_black_tree_template.h`, shared with
+// the template instances and `order_statistic_tree.c`, and counted by the hooks.
+#define RB_ROTATED(node, pivot) INSTRUMENT_ROTATION()
 
-static void fix_violations(Rb_Node* node) {
-    while (node->color == NODE_RED) {
-        Rb_Node* parent_node = node->parent;
-        if (node_color(parent_node) == NODE_BLACK) {
-            // No violations, return.
-            return;
-        } else {
-            Rb_Node* grand_parent_node = parent_node->parent;
-            Rb_Node* uncle_node = grand_parent_node->left != parent_node ? grand_parent_node->left : grand_parent_node->right;
-
-            if (node_color(uncle_node) == NODE_RED) {
-                // recolor parent and uncle to black
-                parent_node->color = NODE_BLACK;
-                uncle_node->color  = NODE_BLACK;
-
-                // if grandparent is not root
-                if (grand_parent_node->parent != NULL) {
-                    grand_parent_node->color = NODE_RED;
-                    node = grand_parent_node; 
-                    continue; // Continue to check for new violations
-                }
-            } else {
-                bool node_is_left        = parent_node->left == node;
-                bool parent_node_is_left = grand_parent_node->left == parent_node;
-                // TODO Check rotation name if it is not inversed.
-                // + Refactor, some logics can be shared between rotations.
-                if (node_is_left && parent_node_is_left) {
-                    // Right rotation
-                    parent_node->parent             = grand_parent_node->parent;
-                    grand_parent_node->parent->left = parent_node;
-                    grand_parent_node->left         = parent_node->right;
-                    grand_parent_node->parent       = parent_node;
-                    parent_node->right              = grand_parent_node;
-                    parent_node->color              = NODE_BLACK;
-                    grand_parent_node->color        = NODE_RED;
-                } else if (node_is_left) {
-                    // Right-Left rotation
-                    grand_parent_node->parent->right = node;
-                    node->parent                     = grand_parent_node->parent;
-                    parent_node->left                = NULL;
-                    node->right                      = parent_node;
-                    node->left                       = grand_parent_node;
-                    grand_parent_node->parent        = node;
-                    node->color                      = NODE_BLACK;
-                    grand_parent_node->color         = NODE_RED;
-                } else if (parent_node_is_left) {
-                    // left-Right rotation
-                    grand_parent_node->parent->left = node;
-                    node->parent                    = grand_parent_node->parent;
-                    parent_node->right              = NULL;
-                    node->right                     = grand_parent_node;
-                    node->left                      = parent_node;
-                    grand_parent_node->parent       = node;
-                    node->color                     = NODE_BLACK;
-                    grand_parent_node->color        = NODE_RED;
-                } else {
-                    // Left rotation
-                    parent_node->parent              = grand_parent_node->parent;
-                    grand_parent_node->parent->right = parent_node;
-                    grand_parent_node->right         = parent_node->left;
-                    grand_parent_node->parent        = parent_node;
-                    parent_node->left                = grand_parent_node;
-                    parent_node->color               = NODE_BLACK;
-                    grand_parent_node->color         = NODE_RED;
-                }
-                break;
-            }
-        }
-    }
+RB_TREE_DEFINE_BALANCE(rb, Rb_Node, RB_ROTATED, INSTRUMENT_RECOLORS, RB_TREE_NO_HOOK)
+
+Rb_Node* rb_node_new(uint32_t root_key, bool is_root) {
+    return rb_node_new_pooled(NULL, root_key, is_root);
 }
 
-Rb_Node* rb_node_new(uint32_t root_val, bool is_root) {
-    Rb_Node* root = (Rb_Node*) malloc(sizeof(Rb_Node));
+Rb_Node* rb_node_new_pooled(Node_Pool* pool, uint32_t root_key, bool is_root) {
+    Rb_Node* root = pool != NULL ? (Rb_Node*) node_pool_alloc(pool) : (Rb_Node*) malloc(sizeof(Rb_Node));
     if(root == NULL) {
         printf("Unable to allocate memory for the red black tree root node.");
         exit(1);
     }
+    INSTRUMENT_ALLOC();
 
     root->parent = NULL;
     root->left   = NULL;
     root->right  = NULL;
-    root->val    = root_val;
+    root->value  = NULL;
+    root->key    = root_key;
+    root->count  = 1;
     root->color  = is_root ? NODE_BLACK : NODE_RED;
     return root;
 }
 
 void rb_node_free(Rb_Node* root) {
-    free(root);
-    // TODO
+    // Post-order walk using the parent links: free a node once both its subtrees
+    // are gone, detaching it from its parent first.
+    Rb_Node* node = root;
+    while (node != NULL) {
+        if (node->left != NULL) {
+            node = node->left;
+        } else if (node->right != NULL) {
+            node = node->right;
+        } else {
+            Rb_Node* parent_node = node == root ? NULL : node->parent;
+            if (parent_node != NULL) {
+                if (parent_node->left == node) {
+                    parent_node->left = NULL;
+                } else {
+                    parent_node->right = NULL;
+                }
+            }
+            INSTRUMENT_FREE();
+            free(node);
+            node = parent_node;
+        }
+    }
 }
 
+bool rb_node_insert(Rb_Node** root, uint32_t key, void* value) {
+    return rb_node_insert_pooled(NULL, root, key, value);
+}
 
-void rb_node_insert(Rb_Node* root, uint32_t val) {
-    // Inset like binary search tree.
-    Rb_Node* parent_node = root;
-    Rb_Node* child_node = parent_node->val > val ? parent_node->left : parent_node->right;
-    while(child_node != NULL) {
+bool rb_node_insert_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, void* value) {
+    INSTRUMENT_SCOPE(RB_NODE_INSERT);
+    // Insert like binary search tree.
+    Rb_Node* parent_node = NULL;
+    Rb_Node* child_node  = *root;
+    while (child_node != NULL) {
+        INSTRUMENT_VISIT();
+        if (child_node->key == key) {
+            child_node->value = value;
+            return false;
+        }
         parent_node = child_node;
-        child_node = parent_node->val > val ? parent_node->left : parent_node->right;
+        child_node  = key < child_node->key ? child_node->left : child_node->right;
+    }
+
+    child_node = rb_node_new_pooled(pool, key, parent_node == NULL);
+    child_node->value  = value;
+    child_node->parent = parent_node;
+    if (parent_node == NULL) {
+        *root = child_node;
+        return true;
+    }
+
+    if (key < parent_node->key) {
+        parent_node->left = child_node;
+    } else {
+        parent_node->right = child_node;
+    }
+
+    rb_fix_violations(root, child_node);
+    return true;
+}
+
+uint32_t rb_node_insert_multi(Rb_Node** root, uint32_t key, uint32_t count) {
+    return rb_node_insert_multi_pooled(NULL, root, key, count);
+}
+
+uint32_t rb_node_insert_multi_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, uint32_t count) {
+    INSTRUMENT_SCOPE(RB_NODE_INSERT);
+    assert(count > 0 && "Inserted count is zero.");
+    Rb_Node* parent_node = NULL;
+    Rb_Node* child_node  = *root;
+    while (child_node != NULL) {
+        INSTRUMENT_VISIT();
+        if (child_node->key == key) {
+            // A repeated key leaves the shape of the tree untouched.
+            assert(child_node->count <= UINT32_MAX - count && "Key count overflows.");
+            child_node->count += count;
+            return child_node->count;
+        }
+        parent_node = child_node;
+        child_node  = key < child_node->key ? child_node->left : child_node->right;
+    }
+
+    child_node = rb_node_new_pooled(pool, key, parent_node == NULL);
+    child_node->count  = count;
+    child_node->parent = parent_node;
+    if (parent_node == NULL) {
+        *root = child_node;
+        return count;
+    }
+
+    if (key < parent_node->key) {
+        parent_node->left = child_node;
+    } else {
+        parent_node->right = child_node;
+    }
+
+    rb_fix_violations(root, child_node);
+    return count;
+}
+
+bool rb_node_delete(Rb_Node** root, uint32_t key, void** removed_value) {
+    return rb_node_delete_pooled(NULL, root, key, removed_value);
+}
+
+// Unlinks `node` from the tree, rebalances it and frees the node.
+static void delete_node(Node_Pool* pool, Rb_Node** root, Rb_Node* node) {
+    rb_unlink(root, node);
+    INSTRUMENT_FREE();
+    if (pool != NULL) {
+        node_pool_release(pool, node);
+    } else {
+        free(node);
+    }
+}
+
+bool rb_node_delete_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, void** removed_value) {
+    INSTRUMENT_SCOPE(RB_NODE_DELETE);
+    Rb_Node* node = rb_node_find(*root, key);
+    if (node == NULL) {
+        return false;
+    }
+
+    if (removed_value != NULL) {
+        *removed_value = node->value;
+    }
+    delete_node(pool, root, node);
+    return true;
+}
+
+uint32_t rb_node_delete_multi(Rb_Node** root, uint32_t key, uint32_t count) {
+    return rb_node_delete_multi_pooled(NULL, root, key, count);
+}
+
+uint32_t rb_node_delete_multi_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, uint32_t count) {
+    INSTRUMENT_SCOPE(RB_NODE_DELETE);
+    Rb_Node* node = rb_node_find(*root, key);
+    if (node == NULL || count == 0) {
+        return 0;
+    }
+
+    // Only the last occurrence unlinks the node.
+    if (count < node->count) {
+        node->count -= count;
+        return count;
+    }
+    uint32_t removed = node->count;
+    delete_node(pool, root, node);
+    return removed;
+}
+
+Rb_Node* rb_node_bulk_load(const uint32_t* keys, void* const* values, size_t n) {
+    return rb_node_bulk_load_pooled(NULL, keys, values, n);
+}
+
+// The node with in-order rank `rank`, from the pooled block or the array of individually
+// allocated nodes.
+static Rb_Node* bulk_node(Rb_Node* block, Rb_Node** nodes, size_t rank) {
+    return block != NULL ? &block[rank] : nodes[rank];
+}
+
+// Links the `count` nodes of the block or array, sorted by key, into a perfectly
+// balanced tree and returns its root: the root of a range is its middle node, so
+// sibling subtrees differ by at most one node and every level but the deepest is full.
+// Coloring that deepest level red and everything else black gives every path the same
+// number of black nodes.
+static Rb_Node* link_balanced(Rb_Node* block, Rb_Node** nodes, size_t count) {
+    size_t max_depth = 0;
+    while (((size_t) 2 << max_depth) - 1 < count) {
+        max_depth += 1;
+    }
+
+    typedef struct { size_t lo; size_t hi; Rb_Node* parent; bool is_left; size_t depth; } Range;
+    Range stack[2 * 64];
+    size_t top = 0;
+    Rb_Node* root = NULL;
+    stack[top++] = (Range) { 0, count, NULL, false, 0 };
+    while (top > 0) {
+        Range range = stack[--top];
+        size_t mid = range.lo + (range.hi - range.lo) / 2;
+        Rb_Node* node = bulk_node(block, nodes, mid);
+
+        node->parent = range.parent;
+        node->left   = NULL;
+        node->right  = NULL;
+        node->color  = range.depth == max_depth && max_depth > 0 ? NODE_RED : NODE_BLACK;
+        if (range.parent == NULL) {
+            root = node;
+        } else if (range.is_left) {
+            range.parent->left = node;
+        } else {
+            range.parent->right = node;
+        }
+
+        if (mid + 1 < range.hi) {
+            stack[top++] = (Range) { mid + 1, range.hi, node, false, range.depth + 1 };
+        }
+        if (range.lo < mid) {
+            stack[top++] = (Range) { range.lo, mid, node, true, range.depth + 1 };
+        }
+    }
+
+    return root;
+}
+
+Rb_Node* rb_node_bulk_load_pooled(Node_Pool* pool, const uint32_t* keys, void* const* values, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i += 1) {
+        assert((i == 0 || keys[i - 1] <= keys[i]) && "Bulk loaded keys are not sorted.");
+        if (i == 0 || keys[i - 1] != keys[i]) {
+            count += 1;
+        }
+    }
+    if (count == 0) {
+        return NULL;
+    }
+
+    Rb_Node*  block = NULL;
+    Rb_Node** nodes = NULL;
+    if (pool != NULL) {
+        assert(pool->node_size == sizeof(Rb_Node) && "Node pool size does not match Rb_Node.");
+        block = (Rb_Node*) node_pool_alloc_array(pool, count);
+    } else {
+        nodes = (Rb_Node**) malloc(count * sizeof(Rb_Node*));
+        if (nodes == NULL) {
+            printf("Unable to allocate memory for the red black tree bulk load.");
+            exit(1);
+        }
+    }
+
+    // Fills the nodes in key order, merging duplicates.
+    size_t rank = 0;
+    for (size_t i = 0; i < n; i += 1) {
+        if (i > 0 && keys[i - 1] == keys[i]) {
+            bulk_node(block, nodes, rank - 1)->value = values != NULL ? values[i] : NULL;
+            continue;
+        }
+        if (block == NULL) {
+            nodes[rank] = rb_node_new(keys[i], false);
+        }
+        Rb_Node* node = bulk_node(block, nodes, rank);
+        node->key   = keys[i];
+        node->count = 1;
+        node->value = values != NULL ? values[i] : NULL;
+        rank += 1;
+    }
+
+    Rb_Node* root = link_balanced(block, nodes, count);
+    free(nodes);
+    return root;
+}
+
+typedef struct Batch_Entry {
+    uint32_t key;
+    uint32_t idx;
+} Batch_Entry;
+
+// Sorts the `n` entries by key, equal keys keeping their batch order, with `scratch`
+// holding as many entries. Returns whichever of the two arrays ends up sorted.
+static Batch_Entry* sort_batch(Batch_Entry* entries, Batch_Entry* scratch, size_t n) {
+    if (n < 64) {
+        for (size_t i = 1; i < n; i += 1) {
+            Batch_Entry entry = entries[i];
+            size_t j = i;
+            for (; j > 0 && entries[j - 1].key > entry.key; j -= 1) {
+                entries[j] = entries[j - 1];
+            }
+            entries[j] = entry;
+        }
+        return entries;
+    }
+
+    // Least significant byte first, each pass stable, skipping the bytes every key shares.
+    for (uint32_t shift = 0; shift < 32; shift += 8) {
+        size_t offsets[256] = { 0 };
+        for (size_t i = 0; i < n; i += 1) {
+            offsets[(entries[i].key >> shift) & 0xff] += 1;
+        }
+        if (offsets[(entries[0].key >> shift) & 0xff] == n) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t digit = 0; digit < 256; digit += 1) {
+            size_t digit_count = offsets[digit];
+            offsets[digit] = offset;
+            offset += digit_count;
+        }
+        for (size_t i = 0; i < n; i += 1) {
+            scratch[offsets[(entries[i].key >> shift) & 0xff]++] = entries[i];
+        }
+
+        Batch_Entry* sorted = scratch;
+        scratch = entries;
+        entries = sorted;
     }
+    return entries;
+}
+
+// Inserts the sorted, distinct entries into a non empty tree, in key order. The
+// descent for a key starts from the node of the previous one: it climbs to the lowest
+// ancestor whose subtree spans the key, then descends from there, so keys close to
+// each other share the upper part of their path instead of each starting at the root.
+static size_t merge_batch(Rb_Node** root, Rb_Node* block, const Batch_Entry* entries, size_t count,
+                          void* const* values) {
+    size_t inserted = 0;
+    Rb_Node* finger = NULL;
+    for (size_t i = 0; i < count; i += 1) {
+        uint32_t key = entries[i].key;
+        void* value  = values != NULL ? values[entries[i].idx] : NULL;
+
+        // The previous key is smaller: while `node` is a right child, or a left child
+        // whose parent is not greater than `key`, its subtree ends below `key`.
+        Rb_Node* node = *root;
+        if (finger != NULL) {
+            node = finger;
+            while (node->parent != NULL && !(node->parent->left == node && key < node->parent->key)) {
+                node = node->parent;
+            }
+        }
 
-    // TODO: What to do when val equals ?
-    if(parent_node->val > val) {
-        parent_node->left         = rb_node_new(val, false);
-        parent_node->left->parent = parent_node;
-        child_node = parent_node->left;
+        Rb_Node* parent_node = NULL;
+        while (node != NULL && node->key != key) {
+            parent_node = node;
+            node = key < node->key ? node->left : node->right;
+        }
+        if (node != NULL) {
+            node->value = value;
+            finger = node;
+            continue;
+        }
+
+        node = block != NULL ? &block[inserted] : rb_node_new(key, false);
+        node->parent = parent_node;
+        node->left   = NULL;
+        node->right  = NULL;
+        node->value  = value;
+        node->key    = key;
+        node->count  = 1;
+        node->color  = NODE_RED;
+        if (key < parent_node->key) {
+            parent_node->left = node;
+        } else {
+            parent_node->right = node;
+        }
+        rb_fix_violations(root, node);
+        finger = node;
+        inserted += 1;
+    }
+    return inserted;
+}
+
+size_t rb_node_insert_batch(Rb_Node** root, const uint32_t* keys, void* const* values, size_t n) {
+    return rb_node_insert_batch_pooled(NULL, root, keys, values, n);
+}
+
+size_t rb_node_insert_batch_pooled(Node_Pool* pool, Rb_Node** root, const uint32_t* keys, void* const* values, size_t n) {
+    assert((keys != NULL || n == 0) && "Batch keys array is NULL.");
+    assert(n <= UINT32_MAX && "Batch is too large.");
+    if (n == 0) {
+        return 0;
+    }
+
+    Batch_Entry* entries = (Batch_Entry*) malloc(2 * n * sizeof(Batch_Entry));
+    if (entries == NULL) {
+        printf("Unable to allocate memory for the red black tree batch insert.");
+        exit(1);
+    }
+    for (size_t i = 0; i < n; i += 1) {
+        entries[i] = (Batch_Entry) { keys[i], (uint32_t) i };
+    }
+    Batch_Entry* sorted = sort_batch(entries, entries + n, n);
+
+    // Keeps the last occurrence of every key, whose value successive insertions would leave.
+    size_t count = 0;
+    for (size_t i = 0; i < n; i += 1) {
+        if (i + 1 == n || sorted[i + 1].key != sorted[i].key) {
+            sorted[count++] = sorted[i];
+        }
+    }
+
+    Rb_Node* block = NULL;
+    if (pool != NULL) {
+        assert(pool->node_size == sizeof(Rb_Node) && "Node pool size does not match Rb_Node.");
+        block = (Rb_Node*) node_pool_alloc_array(pool, count);
+    }
+
+    size_t inserted = count;
+    if (*root == NULL) {
+        // Nothing to merge with, the batch is linked like a bulk load.
+        Rb_Node** nodes = NULL;
+        if (block == NULL) {
+            nodes = (Rb_Node**) malloc(count * sizeof(Rb_Node*));
+            if (nodes == NULL) {
+                printf("Unable to allocate memory for the red black tree batch insert.");
+                exit(1);
+            }
+        }
+        for (size_t i = 0; i < count; i += 1) {
+            if (block == NULL) {
+                nodes[i] = rb_node_new(sorted[i].key, false);
+            }
+            Rb_Node* node = bulk_node(block, nodes, i);
+            node->key   = sorted[i].key;
+            node->count = 1;
+            node->value = values != NULL ? values[sorted[i].idx] : NULL;
+        }
+        *root = link_balanced(block, nodes, count);
+        free(nodes);
     } else {
-        parent_node->right         = rb_node_new(val, false);
-        parent_node->right->parent = parent_node;
-        child_node = parent_node->right;
+        inserted = merge_batch(root, block, sorted, count, values);
+        // The block was sized for every key, those already in the tree left nodes unused.
+        for (size_t i = inserted; block != NULL && i < count; i += 1) {
+            node_pool_release(pool, &block[i]);
+        }
+    }
+
+    free(entries);
+    return inserted;
+}
+
+Rb_Node* rb_node_find(Rb_Node* root, uint32_t key) {
+    INSTRUMENT_SCOPE(RB_NODE_FIND);
+    Rb_Node* node = root;
+    while (node != NULL && node->key != key) {
+        INSTRUMENT_VISIT();
+        node = key < node->key ? node->left : node->right;
+    }
+
+    return node;
+}
+
+uint32_t rb_node_count(Rb_Node* root, uint32_t key) {
+    Rb_Node* node = rb_node_find(root, key);
+    return node != NULL ? node->count : 0;
+}
+
+Rb_Node* rb_node_lower_bound(Rb_Node* root, uint32_t key) {
+    INSTRUMENT_SCOPE(RB_NODE_LOWER_BOUND);
+    Rb_Node* bound = NULL;
+    Rb_Node* node  = root;
+    while (node != NULL) {
+        INSTRUMENT_VISIT();
+        if (node->key >= key) {
+            bound = node;
+            node  = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+
+    return bound;
+}
+
+Rb_Node* rb_node_upper_bound(Rb_Node* root, uint32_t key) {
+    INSTRUMENT_SCOPE(RB_NODE_UPPER_BOUND);
+    Rb_Node* bound = NULL;
+    Rb_Node* node  = root;
+    while (node != NULL) {
+        INSTRUMENT_VISIT();
+        if (node->key > key) {
+            bound = node;
+            node  = node->left;
+        } else {
+            node = node->right;
+        }
     }
 
-    fix_violations(child_node);
-}
\ No newline at end of file
+    return bound;
+}
+
+// Walks down to the smallest or largest node of the subtree of `node`, prefetching on
+// the way the subtree on the other side of every node passed: an in-order walk enters
+// it right after that node, which is long enough for the prefetch to complete.
+static Rb_Node* leftmost(Rb_Node* node) {
+    while (node->left != NULL) {
+        __builtin_prefetch(node->right);
+        node = node->left;
+    }
+    __builtin_prefetch(node->right);
+    return node;
+}
+
+static Rb_Node* rightmost(Rb_Node* node) {
+    while (node->right != NULL) {
+        __builtin_prefetch(node->left);
+        node = node->right;
+    }
+    __builtin_prefetch(node->left);
+    return node;
+}
+
+Rb_Node* rb_node_first(Rb_Node* root) {
+    return root != NULL ? leftmost(root) : NULL;
+}
+
+Rb_Node* rb_node_last(Rb_Node* root) {
+    return root != NULL ? rightmost(root) : NULL;
+}
+
+Rb_Node* rb_node_next(Rb_Node* node) {
+    if (node->right != NULL) {
+        return leftmost(node->right);
+    }
+
+    // Ancestors were passed on the way down, their other subtree was already prefetched.
+    while (node->parent != NULL && node->parent->right == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+Rb_Node* rb_node_prev(Rb_Node* node) {
+    if (node->left != NULL) {
+        return rightmost(node->left);
+    }
+
+    while (node->parent != NULL && node->parent->left == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+Rb_Iterator rb_iterator_range(Rb_Node* root, uint32_t lo, uint32_t hi) {
+    Rb_Node* node = lo <= hi ? rb_node_lower_bound(root, lo) : NULL;
+    // The right subtrees along the lower bound path were not prefetched, unlike a descent by `leftmost`.
+    if (node != NULL) {
+        __builtin_prefetch(node->right);
+    }
+    return (Rb_Iterator) { node, hi };
+}
+
+Rb_Node* rb_iterator_next(Rb_Iterator* iterator) {
+    Rb_Node* node = iterator->node;
+    if (node == NULL || node->key > iterator->hi) {
+        iterator->node = NULL;
+        return NULL;
+    }
+
+    iterator->node = rb_node_next(node);
+    return node;
+}
+
+// Returns the black height of the subtree, -1 when it breaks a property.
+static int validate_subtree(Rb_Node* node, Rb_Node* parent_node, const uint32_t* min_key, const uint32_t* max_key) {
+    if (node == NULL) {
+        return 1;
+    }
+
+    if (node->parent != parent_node) {
+        printf("Red black tree: key %u has a wrong parent link.\n", node->key);
+        return -1;
+    }
+    if ((min_key != NULL && node->key <= *min_key) || (max_key != NULL && node->key >= *max_key)) {
+        printf("Red black tree: key %u is out of order.\n", node->key);
+        return -1;
+    }
+    if (node->count == 0) {
+        printf("Red black tree: key %u has a zero count.\n", node->key);
+        return -1;
+    }
+    if (node->color == NODE_RED && (rb_color(node->left) == NODE_RED || rb_color(node->right) == NODE_RED)) {
+        printf("Red black tree: red key %u has a red child.\n", node->key);
+        return -1;
+    }
+
+    int left_height  = validate_subtree(node->left, node, min_key, &node->key);
+    int right_height = validate_subtree(node->right, node, &node->key, max_key);
+    if (left_height < 0 || right_height < 0) {
+        return -1;
+    }
+    if (left_height != right_height) {
+        printf("Red black tree: key %u has unbalanced black heights.\n", node->key);
+        return -1;
+    }
+
+    return left_height + (node->color == NODE_BLACK ? 1 : 0);
+}
+
+bool rb_node_validate(Rb_Node* root) {
+    if (root == NULL) {
+        return true;
+    }
+
+    if (root->color != NODE_BLACK) {
+        printf("Red black tree: the root is not black.\n");
+        return false;
+    }
+
+    return validate_subtree(root, root->parent, NULL, NULL) >= 0;
+}
+
+RB_TREE_DEFINE(I32, i32, int32_t, void*, RB_TREE_DEFAULT_LESS)
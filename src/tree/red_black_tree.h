@@ -2,25 +2,127 @@
 #define RED_BLACK_TREE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "memory/node_pool.h"
+
 typedef uint8_t Rb_Node_Color;
 
 #define NODE_BLACK 0
 #define NODE_RED   1
 
-// TODO: Add an implementation variation backed by arrays instead of allocating nodes.
+// See `array_red_black_tree.h` for a variation backed by an array instead of allocating nodes.
 
+// Ordered map from `uint32_t` keys to `void*` values.
+//
+// A tree is designated by a pointer to its root node, `NULL` for an empty tree.
+// Insertions and deletions may rotate a new node up to the root, so they take the
+// address of the root pointer and update it.
+//
+// `count` is the number of occurrences of the key, always 1 when the tree is used as
+// a map. The `_multi` procedures use the tree as a multiset instead: a repeated key
+// increments the count of its node rather than adding a node.
 typedef struct Rb_Node {
     struct Rb_Node* parent;
     struct Rb_Node* left;
     struct Rb_Node* right;
-    uint32_t        val;
+    void*           value;
+    uint32_t        key;
+    uint32_t        count;
     Rb_Node_Color   color;
 } Rb_Node;
 
-Rb_Node* rb_node_new(uint32_t root_val, bool is_root);
+Rb_Node* rb_node_new(uint32_t root_key, bool is_root);
+// Frees every node of the tree, iteratively so that the call stack stays flat.
 void rb_node_free(Rb_Node* root);
-void rb_node_insert(Rb_Node* root, uint32_t value);
+
+// Inserts `key` mapped to `value`. Returns true when the key was not in the tree,
+// false when it was, in which case only its value is replaced.
+bool rb_node_insert(Rb_Node** root, uint32_t key, void* value);
+// Removes `key` from the tree, storing its value in `removed_value` when not NULL.
+// Returns false when the key is not in the tree.
+bool rb_node_delete(Rb_Node** root, uint32_t key, void** removed_value);
+
+// Multiset insertion: adds `count` occurrences of `key`, which must be at least 1. A
+// key already in the tree only has its count incremented, without allocation nor
+// rebalancing; a new key gets a node with a NULL value. Returns the count of `key`
+// after the insertion.
+uint32_t rb_node_insert_multi(Rb_Node** root, uint32_t key, uint32_t count);
+// Multiset removal: removes up to `count` occurrences of `key`, and its node once none
+// is left. Returns the number of occurrences removed, 0 when the key is not in the tree.
+uint32_t rb_node_delete_multi(Rb_Node** root, uint32_t key, uint32_t count);
+// Returns the number of occurrences of `key`, 0 when it is not in the tree.
+uint32_t rb_node_count(Rb_Node* root, uint32_t key);
+
+// Returns the node holding `key`, NULL when there is none.
+Rb_Node* rb_node_find(Rb_Node* root, uint32_t key);
+// Returns the node with the smallest key greater or equal to `key`, NULL when there is none.
+Rb_Node* rb_node_lower_bound(Rb_Node* root, uint32_t key);
+// Returns the node with the smallest key strictly greater than `key`, NULL when there is none.
+Rb_Node* rb_node_upper_bound(Rb_Node* root, uint32_t key);
+// Nodes with the smallest and the largest key, NULL for an empty tree.
+Rb_Node* rb_node_first(Rb_Node* root);
+Rb_Node* rb_node_last(Rb_Node* root);
+// In-order successor and predecessor of `node`, NULL past the ends. The walk follows
+// the parent links, without stack or allocation, and prefetches the subtrees it will
+// enter next, so a full scan from `rb_node_first` overlaps most of its cache misses.
+Rb_Node* rb_node_next(Rb_Node* node);
+Rb_Node* rb_node_prev(Rb_Node* node);
+
+// Increasing iteration over the keys in `[lo, hi]`:
+//
+//   Rb_Iterator iterator = rb_iterator_range(root, lo, hi);
+//   for (Rb_Node* node; (node = rb_iterator_next(&iterator)) != NULL;) { ... }
+//
+// The tree must not be modified during the iteration, except for node values.
+typedef struct Rb_Iterator {
+    Rb_Node* node;
+    uint32_t hi;
+} Rb_Iterator;
+
+// Iterator starting at `rb_node_lower_bound(root, lo)`, empty when `lo > hi`.
+Rb_Iterator rb_iterator_range(Rb_Node* root, uint32_t lo, uint32_t hi);
+// Returns the current node and moves to its successor, NULL once past `hi`.
+Rb_Node* rb_iterator_next(Rb_Iterator* iterator);
+
+// Checks the binary search tree ordering, the parent links, that every count is at
+// least 1, that the root is black, that no red node has a red child and that every
+// path has the same number of black nodes. Returns false, after printing the first
+// violation found, on a broken tree.
+bool rb_node_validate(Rb_Node* root);
+
+// Builds a tree from `n` keys sorted in non-decreasing order in O(n), instead of the
+// O(n log n) of `n` insertions. Duplicate keys are merged, the last one's value wins.
+// `values` holds the value of every key and may be NULL for NULL values. The tree is
+// perfectly balanced: every level is full except the deepest, whose nodes are red.
+Rb_Node* rb_node_bulk_load(const uint32_t* keys, void* const* values, size_t n);
+
+// Inserts the `n` keys of `keys`, in any order, mapped to `values` (NULL for NULL
+// values), like `n` calls to `rb_node_insert` in array order: a key already in the
+// tree or repeated in the batch gets the value of its last occurrence. Returns the
+// number of keys that were not in the tree. The batch is radix sorted (O(n) extra
+// memory) and inserted in key order, each descent starting from the node of the
+// previous key rather than from the root. An empty tree is built like a bulk load.
+size_t rb_node_insert_batch(Rb_Node** root, const uint32_t* keys, void* const* values, size_t n);
+
+// Same as above, with nodes taken from and given back to `pool` (node size
+// `sizeof(Rb_Node)`) instead of `malloc` and `free`. A pooled tree is released as a
+// whole by `node_pool_destroy`. A NULL pool falls back to `malloc` and `free`.
+Rb_Node* rb_node_new_pooled(Node_Pool* pool, uint32_t root_key, bool is_root);
+bool rb_node_insert_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, void* value);
+bool rb_node_delete_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, void** removed_value);
+uint32_t rb_node_insert_multi_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, uint32_t count);
+uint32_t rb_node_delete_multi_pooled(Node_Pool* pool, Rb_Node** root, uint32_t key, uint32_t count);
+// Takes every node from a single `node_pool_alloc_array` block, laid out in key order.
+Rb_Node* rb_node_bulk_load_pooled(Node_Pool* pool, const uint32_t* keys, void* const* values, size_t n);
+// Takes every new node from a single `node_pool_alloc_array` block.
+size_t rb_node_insert_batch_pooled(Node_Pool* pool, Rb_Node** root, const uint32_t* keys, void* const* values,
+                                   size_t n);
+
+// Signed 32-bit keys, ordered by `<`. See `red_black_tree_template.h` for other types,
+// and for the `rb_node_*` procedures the instances lack.
+#include "tree/red_black_tree_template.h"
+RB_TREE_DECLARE(I32, i32, int32_t, void*)
 
 #endif  // RED_BLACK_TREE_H
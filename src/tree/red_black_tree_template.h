@@ -0,0 +1,543 @@
+#ifndef RED_BLACK_TREE_TEMPLATE_H
+#define RED_BLACK_TREE_TEMPLATE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "memory/node_pool.h"
+
+// Compile-time specialized red-black trees for arbitrary key and value types.
+//
+// `Rb_Node` is fixed to `uint32_t` keys and `void*` values. Storing other types
+// behind `void*` with a comparison function pointer costs an indirect call and a
+// pointer chase per comparison. These macros instead generate a node type and the
+// `rb_node_*` procedures for a given key type, value type and comparator, which is
+// pasted in the generated code and inlined by the compiler.
+//
+// - `RB_TREE_DECLARE(Name, name, Key, Value)` declares `Name##_Rb_Node` and the
+//   prototypes of the procedures, in a header.
+// - `RB_TREE_DEFINE(Name, name, Key, Value, LESS)` defines the procedures, in a single
+//   translation unit. `LESS(a, b)` must be an expression (a function-like macro or an
+//   inline function) telling whether key `a` orders before key `b`. Keys are equal
+//   when neither is less than the other.
+//
+// The generated procedures behave like their `rb_node_*` counterparts:
+//
+//   Name##_Rb_Node* name##_rb_node_new(Key key);           // black, detached, zero value
+//   void            name##_rb_node_free(Name##_Rb_Node* root);
+//   bool            name##_rb_node_insert(Name##_Rb_Node** root, Key key, Value value);
+//   bool            name##_rb_node_delete(Name##_Rb_Node** root, Key key, Value* removed_value);
+//   Name##_Rb_Node* name##_rb_node_find(Name##_Rb_Node* root, Key key);
+//   Name##_Rb_Node* name##_rb_node_lower_bound(Name##_Rb_Node* root, Key key);
+//   Name##_Rb_Node* name##_rb_node_upper_bound(Name##_Rb_Node* root, Key key);
+//   Name##_Rb_Node* name##_rb_node_next(Name##_Rb_Node* node);
+//   Name##_Rb_Node* name##_rb_node_prev(Name##_Rb_Node* node);
+//   bool            name##_rb_node_validate(Name##_Rb_Node* root);
+//
+// plus `_pooled` variants of insert and delete taking a `Node_Pool*` first.
+//
+// Only that subset is generated. These `rb_node_*` procedures of `red_black_tree.h`
+// have no template counterpart, and a feature added to `Rb_Node` reaches the
+// instances only when it is added to these macros as well:
+//
+// - multiset counts: the `count` member, `rb_node_insert_multi`, `rb_node_delete_multi`
+//   and `rb_node_count`, the instances are maps only;
+// - `rb_node_bulk_load` and `rb_node_insert_batch`;
+// - `rb_node_first`, `rb_node_last` and the range iterator `Rb_Iterator`;
+// - the prefetching of `rb_node_next` and `rb_node_prev`;
+// - the hot path counters of `instrument.h`.
+//
+// Example, a tree from `double` to `int`:
+//
+//   #define DOUBLE_LESS(a, b) ((a) < (b))
+//   RB_TREE_DECLARE(F64, f64, double, int)
+//   RB_TREE_DEFINE(F64, f64, double, int, DOUBLE_LESS)
+//
+//   F64_Rb_Node* root = NULL;
+//   f64_rb_node_insert(&root, 0.5, 1);
+//
+// `RB_TREE_DEFAULT_LESS` compares keys with `<`.
+//
+// The rebalancing itself is shared by `Rb_Node`, the instances and `Os_Rb_Node` through
+// `RB_TREE_DEFINE_BALANCE(prefix, Node, ROTATED, RECOLORED, UNLINKED)`, which defines
+// for any `Node` struct with `parent`, `left`, `right` and `color` members:
+//
+//   static Rb_Node_Color prefix##_color(Node* node);       // NULL leaves are black
+//   static void prefix##_replace_child(Node** root, Node* parent, Node* old_child, Node* new_child);
+//   static void prefix##_rotate_left(Node** root, Node* node);
+//   static void prefix##_rotate_right(Node** root, Node* node);
+//   static void prefix##_fix_violations(Node** root, Node* node);  // after linking a red leaf
+//   static void prefix##_unlink(Node** root, Node* node);  // unlinks and rebalances, no free
+//
+// The hooks let a tree keep state in sync with the shape of the tree, they are
+// function-like macros or functions:
+//
+// - `ROTATED(node, pivot)` after a rotation moved `pivot` above `node`, for instance
+//   to recompute subtree aggregates of `node` then `pivot`.
+// - `RECOLORED(n)` after `n` nodes were recolored.
+// - `UNLINKED(node)` after `prefix##_unlink` relinked the tree and before it rebalances
+//   it, `node` being the lowest node whose subtree lost a node (NULL when the root
+//   was unlinked): every such subtree is on the path from `node` to the root.
+//
+// `RB_TREE_NO_HOOK` ignores its arguments.
+
+#define RB_TREE_DEFAULT_LESS(a, b) ((a) < (b))
+
+#define RB_TREE_NO_HOOK(...) ((void) 0)
+
+#define RB_TREE_DEFINE_BALANCE(prefix, Node, ROTATED, RECOLORED, UNLINKED)                                \
+    static inline Rb_Node_Color prefix##_color(Node* node) {                                              \
+        return node != NULL ? node->color : NODE_BLACK;                                                   \
+    }                                                                                                     \
+                                                                                                          \
+    /* Makes `new_child` take the place of `old_child` below `parent`, or at the root */                  \
+    /* when `parent` is NULL. */                                                                          \
+    static void prefix##_replace_child(Node** root, Node* parent, Node* old_child, Node* new_child) {     \
+        if (parent == NULL) {                                                                             \
+            *root = new_child;                                                                            \
+        } else if (parent->left == old_child) {                                                           \
+            parent->left = new_child;                                                                     \
+        } else {                                                                                          \
+            parent->right = new_child;                                                                    \
+        }                                                                                                 \
+        if (new_child != NULL) {                                                                          \
+            new_child->parent = parent;                                                                   \
+        }                                                                                                 \
+    }                                                                                                     \
+                                                                                                          \
+    /*    node              pivot      */                                                                 \
+    /*   /    \            /     \     */                                                                 \
+    /*  a    pivot  =>   node     c    */                                                                 \
+    /*       /   \       /  \          */                                                                 \
+    /*      b     c     a    b         */                                                                 \
+    static void prefix##_rotate_left(Node** root, Node* node) {                                           \
+        Node* pivot = node->right;                                                                        \
+        node->right = pivot->left;                                                                        \
+        if (pivot->left != NULL) {                                                                        \
+            pivot->left->parent = node;                                                                   \
+        }                                                                                                 \
+        prefix##_replace_child(root, node->parent, node, pivot);                                          \
+        pivot->left  = node;                                                                              \
+        node->parent = pivot;                                                                             \
+        ROTATED(node, pivot);                                                                             \
+    }                                                                                                     \
+                                                                                                          \
+    /*      node          pivot        */                                                                 \
+    /*     /    \        /     \       */                                                                 \
+    /*  pivot    c  =>  a      node    */                                                                 \
+    /*  /   \                  /  \    */                                                                 \
+    /* a     b                b    c   */                                                                 \
+    static void prefix##_rotate_right(Node** root, Node* node) {                                          \
+        Node* pivot = node->left;                                                                         \
+        node->left = pivot->right;                                                                        \
+        if (pivot->right != NULL) {                                                                       \
+            pivot->right->parent = node;                                                                  \
+        }                                                                                                 \
+        prefix##_replace_child(root, node->parent, node, pivot);                                          \
+        pivot->right = node;                                                                              \
+        node->parent = pivot;                                                                             \
+        ROTATED(node, pivot);                                                                             \
+    }                                                                                                     \
+                                                                                                          \
+    /* Restores the red-black properties after `node` was linked as a red leaf. */                        \
+    static void prefix##_fix_violations(Node** root, Node* node) {                                        \
+        while (prefix##_color(node->parent) == NODE_RED) {                                                \
+            Node* parent_node = node->parent;                                                             \
+            /* A red parent is never the root, so the grand parent exists. */                             \
+            Node* grand_parent_node = parent_node->parent;                                                \
+            bool parent_node_is_left = grand_parent_node->left == parent_node;                            \
+            Node* uncle_node = parent_node_is_left ? grand_parent_node->right : grand_parent_node->left;  \
+            if (prefix##_color(uncle_node) == NODE_RED) {                                                 \
+                /* Pushes the red up to the grand parent and checks again from there. */                  \
+                parent_node->color       = NODE_BLACK;                                                    \
+                uncle_node->color        = NODE_BLACK;                                                    \
+                grand_parent_node->color = NODE_RED;                                                      \
+                RECOLORED(3);                                                                             \
+                node = grand_parent_node;                                                                 \
+                continue;                                                                                 \
+            }                                                                                             \
+            if (parent_node_is_left) {                                                                    \
+                if (parent_node->right == node) {                                                         \
+                    /* Left-Right case, reduced to the Left-Left case. */                                 \
+                    prefix##_rotate_left(root, parent_node);                                              \
+                    node        = parent_node;                                                            \
+                    parent_node = node->parent;                                                           \
+                }                                                                                         \
+                prefix##_rotate_right(root, grand_parent_node);                                           \
+            } else {                                                                                      \
+                if (parent_node->left == node) {                                                          \
+                    /* Right-Left case, reduced to the Right-Right case. */                               \
+                    prefix##_rotate_right(root, parent_node);                                             \
+                    node        = parent_node;                                                            \
+                    parent_node = node->parent;                                                           \
+                }                                                                                         \
+                prefix##_rotate_left(root, grand_parent_node);                                            \
+            }                                                                                             \
+            parent_node->color       = NODE_BLACK;                                                        \
+            grand_parent_node->color = NODE_RED;                                                          \
+            RECOLORED(2);                                                                                 \
+            break;                                                                                        \
+        }                                                                                                 \
+        (*root)->color = NODE_BLACK;                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    /* Restores the red-black properties after a black node was unlinked, `node` (maybe */                \
+    /* NULL) being the child that took its place below `parent_node`. */                                  \
+    static void prefix##_fix_delete_violations(Node** root, Node* node, Node* parent_node) {              \
+        while (node != *root && prefix##_color(node) == NODE_BLACK) {                                     \
+            bool node_is_left  = parent_node->left == node;                                               \
+            Node* sibling_node = node_is_left ? parent_node->right : parent_node->left;                   \
+            if (prefix##_color(sibling_node) == NODE_RED) {                                               \
+                sibling_node->color = NODE_BLACK;                                                         \
+                parent_node->color  = NODE_RED;                                                           \
+                RECOLORED(2);                                                                             \
+                if (node_is_left) {                                                                       \
+                    prefix##_rotate_left(root, parent_node);                                              \
+                    sibling_node = parent_node->right;                                                    \
+                } else {                                                                                  \
+                    prefix##_rotate_right(root, parent_node);                                             \
+                    sibling_node = parent_node->left;                                                     \
+                }                                                                                         \
+            }                                                                                             \
+            if (prefix##_color(sibling_node->left) == NODE_BLACK &&                                       \
+                prefix##_color(sibling_node->right) == NODE_BLACK) {                                      \
+                sibling_node->color = NODE_RED;                                                           \
+                RECOLORED(1);                                                                             \
+                node        = parent_node;                                                                \
+                parent_node = node->parent;                                                               \
+                continue;                                                                                 \
+            }                                                                                             \
+            if (node_is_left) {                                                                           \
+                if (prefix##_color(sibling_node->right) == NODE_BLACK) {                                  \
+                    sibling_node->left->color = NODE_BLACK;                                               \
+                    sibling_node->color       = NODE_RED;                                                 \
+                    RECOLORED(2);                                                                         \
+                    prefix##_rotate_right(root, sibling_node);                                            \
+                    sibling_node = parent_node->right;                                                    \
+                }                                                                                         \
+                sibling_node->color        = parent_node->color;                                          \
+                parent_node->color         = NODE_BLACK;                                                  \
+                sibling_node->right->color = NODE_BLACK;                                                  \
+                RECOLORED(3);                                                                             \
+                prefix##_rotate_left(root, parent_node);                                                  \
+            } else {                                                                                      \
+                if (prefix##_color(sibling_node->left) == NODE_BLACK) {                                   \
+                    sibling_node->right->color = NODE_BLACK;                                              \
+                    sibling_node->color        = NODE_RED;                                                \
+                    RECOLORED(2);                                                                         \
+                    prefix##_rotate_left(root, sibling_node);                                             \
+                    sibling_node = parent_node->left;                                                     \
+                }                                                                                         \
+                sibling_node->color       = parent_node->color;                                           \
+                parent_node->color        = NODE_BLACK;                                                   \
+                sibling_node->left->color = NODE_BLACK;                                                   \
+                RECOLORED(3);                                                                             \
+                prefix##_rotate_right(root, parent_node);                                                 \
+            }                                                                                             \
+            node = *root;                                                                                 \
+            break;                                                                                        \
+        }                                                                                                 \
+        if (node != NULL) {                                                                               \
+            node->color = NODE_BLACK;                                                                     \
+        }                                                                                                 \
+    }                                                                                                     \
+                                                                                                          \
+    /* Unlinks `node` from the tree and rebalances it, the caller frees the node. With */                 \
+    /* two children, the successor (leftmost node of the right subtree) takes the place */                \
+    /* and the color of `node`. */                                                                        \
+    static void prefix##_unlink(Node** root, Node* node) {                                                \
+        Rb_Node_Color removed_color = node->color;                                                        \
+        Node* fix_node;                                                                                   \
+        Node* fix_parent_node;                                                                            \
+        if (node->left == NULL || node->right == NULL) {                                                  \
+            fix_node        = node->left != NULL ? node->left : node->right;                              \
+            fix_parent_node = node->parent;                                                               \
+            prefix##_replace_child(root, node->parent, node, fix_node);                                   \
+        } else {                                                                                          \
+            Node* successor_node = node->right;                                                           \
+            while (successor_node->left != NULL) {                                                        \
+                successor_node = successor_node->left;                                                    \
+            }                                                                                             \
+            removed_color = successor_node->color;                                                        \
+            fix_node      = successor_node->right;                                                        \
+            if (successor_node->parent == node) {                                                         \
+                fix_parent_node = successor_node;                                                         \
+            } else {                                                                                      \
+                fix_parent_node = successor_node->parent;                                                 \
+                prefix##_replace_child(root, successor_node->parent, successor_node, fix_node);           \
+                successor_node->right = node->right;                                                      \
+                successor_node->right->parent = successor_node;                                           \
+            }                                                                                             \
+            prefix##_replace_child(root, node->parent, node, successor_node);                             \
+            successor_node->left = node->left;                                                            \
+            successor_node->left->parent = successor_node;                                                \
+            successor_node->color = node->color;                                                          \
+        }                                                                                                 \
+        UNLINKED(fix_parent_node);                                                                        \
+        if (removed_color == NODE_BLACK && *root != NULL) {                                               \
+            prefix##_fix_delete_violations(root, fix_node, fix_parent_node);                              \
+        }                                                                                                 \
+    }
+
+#define RB_TREE_DECLARE(Name, name, Key, Value)                                                           \
+    typedef struct Name##_Rb_Node {                                                                       \
+        struct Name##_Rb_Node* parent;                                                                    \
+        struct Name##_Rb_Node* left;                                                                      \
+        struct Name##_Rb_Node* right;                                                                     \
+        Value                  value;                                                                     \
+        Key                    key;                                                                       \
+        Rb_Node_Color          color;                                                                     \
+    } Name##_Rb_Node;                                                                                     \
+                                                                                                          \
+    Name##_Rb_Node* name##_rb_node_new(Key key);                                                          \
+    void            name##_rb_node_free(Name##_Rb_Node* root);                                            \
+    bool            name##_rb_node_insert(Name##_Rb_Node** root, Key key, Value value);                   \
+    bool            name##_rb_node_delete(Name##_Rb_Node** root, Key key, Value* removed_value);          \
+    bool            name##_rb_node_insert_pooled(Node_Pool* pool, Name##_Rb_Node** root, Key key,         \
+                                                 Value value);                                            \
+    bool            name##_rb_node_delete_pooled(Node_Pool* pool, Name##_Rb_Node** root, Key key,         \
+                                                 Value* removed_value);                                   \
+    Name##_Rb_Node* name##_rb_node_find(Name##_Rb_Node* root, Key key);                                   \
+    Name##_Rb_Node* name##_rb_node_lower_bound(Name##_Rb_Node* root, Key key);                            \
+    Name##_Rb_Node* name##_rb_node_upper_bound(Name##_Rb_Node* root, Key key);                            \
+    Name##_Rb_Node* name##_rb_node_next(Name##_Rb_Node* node);                                            \
+    Name##_Rb_Node* name##_rb_node_prev(Name##_Rb_Node* node);                                            \
+    bool            name##_rb_node_validate(Name##_Rb_Node* root);
+
+#define RB_TREE_DEFINE(Name, name, Key, Value, LESS)                                                      \
+    RB_TREE_DEFINE_BALANCE(name##_rb, Name##_Rb_Node, RB_TREE_NO_HOOK, RB_TREE_NO_HOOK, RB_TREE_NO_HOOK)  \
+                                                                                                          \
+    static Name##_Rb_Node* name##_rb_node_alloc(Node_Pool* pool) {                                        \
+        Name##_Rb_Node* node = pool != NULL ? (Name##_Rb_Node*) node_pool_alloc(pool)                     \
+                                            : (Name##_Rb_Node*) malloc(sizeof(Name##_Rb_Node));           \
+        if (node == NULL) {                                                                               \
+            printf("Unable to allocate memory for a red black tree node.");                               \
+            exit(1);                                                                                      \
+        }                                                                                                 \
+        return node;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    Name##_Rb_Node* name##_rb_node_new(Key key) {                                                         \
+        Name##_Rb_Node* node = name##_rb_node_alloc(NULL);                                                \
+        node->parent = NULL;                                                                              \
+        node->left   = NULL;                                                                              \
+        node->right  = NULL;                                                                              \
+        node->key    = key;                                                                               \
+        node->value  = (Value) { 0 };                                                                     \
+        node->color  = NODE_BLACK;                                                                        \
+        return node;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    void name##_rb_node_free(Name##_Rb_Node* root) {                                                      \
+        Name##_Rb_Node* node = root;                                                                      \
+        while (node != NULL) {                                                                            \
+            if (node->left != NULL) {                                                                     \
+                node = node->left;                                                                        \
+            } else if (node->right != NULL) {                                                             \
+                node = node->right;                                                                       \
+            } else {                                                                                      \
+                Name##_Rb_Node* parent_node = node == root ? NULL : node->parent;                         \
+                if (parent_node != NULL) {                                                                \
+                    if (parent_node->left == node) {                                                      \
+                        parent_node->left = NULL;                                                         \
+                    } else {                                                                              \
+                        parent_node->right = NULL;                                                        \
+                    }                                                                                     \
+                }                                                                                         \
+                free(node);                                                                               \
+                node = parent_node;                                                                       \
+            }                                                                                             \
+        }                                                                                                 \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_rb_node_insert_pooled(Node_Pool* pool, Name##_Rb_Node** root, Key key, Value value) {     \
+        Name##_Rb_Node* parent_node = NULL;                                                               \
+        Name##_Rb_Node* child_node  = *root;                                                              \
+        bool go_left = false;                                                                             \
+        while (child_node != NULL) {                                                                      \
+            go_left = LESS(key, child_node->key);                                                         \
+            if (!go_left && !LESS(child_node->key, key)) {                                                \
+                child_node->value = value;                                                                \
+                return false;                                                                             \
+            }                                                                                             \
+            parent_node = child_node;                                                                     \
+            child_node  = go_left ? child_node->left : child_node->right;                                 \
+        }                                                                                                 \
+                                                                                                          \
+        child_node = name##_rb_node_alloc(pool);                                                          \
+        child_node->parent = parent_node;                                                                 \
+        child_node->left   = NULL;                                                                        \
+        child_node->right  = NULL;                                                                        \
+        child_node->key    = key;                                                                         \
+        child_node->value  = value;                                                                       \
+        child_node->color  = parent_node == NULL ? NODE_BLACK : NODE_RED;                                 \
+        if (parent_node == NULL) {                                                                        \
+            *root = child_node;                                                                           \
+            return true;                                                                                  \
+        }                                                                                                 \
+        if (go_left) {                                                                                    \
+            parent_node->left = child_node;                                                               \
+        } else {                                                                                          \
+            parent_node->right = child_node;                                                              \
+        }                                                                                                 \
+        name##_rb_fix_violations(root, child_node);                                                       \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_rb_node_insert(Name##_Rb_Node** root, Key key, Value value) {                             \
+        return name##_rb_node_insert_pooled(NULL, root, key, value);                                      \
+    }                                                                                                     \
+                                                                                                          \
+    Name##_Rb_Node* name##_rb_node_find(Name##_Rb_Node* root, Key key) {                                  \
+        Name##_Rb_Node* node = root;                                                                      \
+        while (node != NULL) {                                                                            \
+            /* Both comparisons are evaluated up front so that the child is picked */                     \
+            /* with a conditional move instead of a poorly predicted branch. */                           \
+            bool key_is_less  = LESS(key, node->key);                                                     \
+            bool node_is_less = LESS(node->key, key);                                                     \
+            if (!key_is_less && !node_is_less) {                                                          \
+                break;                                                                                    \
+            }                                                                                             \
+            node = key_is_less ? node->left : node->right;                                                \
+        }                                                                                                 \
+        return node;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_rb_node_delete_pooled(Node_Pool* pool, Name##_Rb_Node** root, Key key,                    \
+                                      Value* removed_value) {                                             \
+        Name##_Rb_Node* node = name##_rb_node_find(*root, key);                                           \
+        if (node == NULL) {                                                                               \
+            return false;                                                                                 \
+        }                                                                                                 \
+        if (removed_value != NULL) {                                                                      \
+            *removed_value = node->value;                                                                 \
+        }                                                                                                 \
+                                                                                                          \
+        name##_rb_unlink(root, node);                                                                     \
+        if (pool != NULL) {                                                                               \
+            node_pool_release(pool, node);                                                                \
+        } else {                                                                                          \
+            free(node);                                                                                   \
+        }                                                                                                 \
+        return true;                                                                                      \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_rb_node_delete(Name##_Rb_Node** root, Key key, Value* removed_value) {                    \
+        return name##_rb_node_delete_pooled(NULL, root, key, removed_value);                              \
+    }                                                                                                     \
+                                                                                                          \
+    Name##_Rb_Node* name##_rb_node_lower_bound(Name##_Rb_Node* root, Key key) {                           \
+        Name##_Rb_Node* bound = NULL;                                                                     \
+        Name##_Rb_Node* node  = root;                                                                     \
+        while (node != NULL) {                                                                            \
+            if (!LESS(node->key, key)) {                                                                  \
+                bound = node;                                                                             \
+                node  = node->left;                                                                       \
+            } else {                                                                                      \
+                node = node->right;                                                                       \
+            }                                                                                             \
+        }                                                                                                 \
+        return bound;                                                                                     \
+    }                                                                                                     \
+                                                                                                          \
+    Name##_Rb_Node* name##_rb_node_upper_bound(Name##_Rb_Node* root, Key key) {                           \
+        Name##_Rb_Node* bound = NULL;                                                                     \
+        Name##_Rb_Node* node  = root;                                                                     \
+        while (node != NULL) {                                                                            \
+            if (LESS(key, node->key)) {                                                                   \
+                bound = node;                                                                             \
+                node  = node->left;                                                                       \
+            } else {                                                                                      \
+                node = node->right;                                                                       \
+            }                                                                                             \
+        }                                                                                                 \
+        return bound;                                                                                     \
+    }                                                                                                     \
+                                                                                                          \
+    Name##_Rb_Node* name##_rb_node_next(Name##_Rb_Node* node) {                                           \
+        if (node->right != NULL) {                                                                        \
+            node = node->right;                                                                           \
+            while (node->left != NULL) {                                                                  \
+                node = node->left;                                                                        \
+            }                                                                                             \
+            return node;                                                                                  \
+        }                                                                                                 \
+        while (node->parent != NULL && node->parent->right == node) {                                     \
+            node = node->parent;                                                                          \
+        }                                                                                                 \
+        return node->parent;                                                                              \
+    }                                                                                                     \
+                                                                                                          \
+    Name##_Rb_Node* name##_rb_node_prev(Name##_Rb_Node* node) {                                           \
+        if (node->left != NULL) {                                                                         \
+            node = node->left;                                                                            \
+            while (node->right != NULL) {                                                                 \
+                node = node->right;                                                                       \
+            }                                                                                             \
+            return node;                                                                                  \
+        }                                                                                                 \
+        while (node->parent != NULL && node->parent->left == node) {                                      \
+            node = node->parent;                                                                          \
+        }                                                                                                 \
+        return node->parent;                                                                              \
+    }                                                                                                     \
+                                                                                                          \
+    /* Black height of the subtree, -1 when it breaks a property. Keys are checked by */                  \
+    /* the in-order walk of `name##_rb_node_validate`. */                                                 \
+    static int name##_rb_validate_subtree(Name##_Rb_Node* node, Name##_Rb_Node* parent_node) {            \
+        if (node == NULL) {                                                                               \
+            return 1;                                                                                     \
+        }                                                                                                 \
+        if (node->parent != parent_node) {                                                                \
+            printf("Red black tree: a node has a wrong parent link.\n");                                  \
+            return -1;                                                                                    \
+        }                                                                                                 \
+        if (node->color == NODE_RED &&                                                                    \
+            (name##_rb_color(node->left) == NODE_RED ||                                                   \
+             name##_rb_color(node->right) == NODE_RED)) {                                                 \
+            printf("Red black tree: a red node has a red child.\n");                                      \
+            return -1;                                                                                    \
+        }                                                                                                 \
+        int left_height  = name##_rb_validate_subtree(node->left, node);                                  \
+        int right_height = name##_rb_validate_subtree(node->right, node);                                 \
+        if (left_height < 0 || right_height < 0) {                                                        \
+            return -1;                                                                                    \
+        }                                                                                                 \
+        if (left_height != right_height) {                                                                \
+            printf("Red black tree: a node has unbalanced black heights.\n");                             \
+            return -1;                                                                                    \
+        }                                                                                                 \
+        return left_height + (node->color == NODE_BLACK ? 1 : 0);                                         \
+    }                                                                                                     \
+                                                                                                          \
+    bool name##_rb_node_validate(Name##_Rb_Node* root) {                                                  \
+        if (root == NULL) {                                                                               \
+            return true;                                                                                  \
+        }                                                                                                 \
+        if (root->color != NODE_BLACK) {                                                                  \
+            printf("Red black tree: the root is not black.\n");                                           \
+            return false;                                                                                 \
+        }                                                                                                 \
+        if (name##_rb_validate_subtree(root, root->parent) < 0) {                                         \
+            return false;                                                                                 \
+        }                                                                                                 \
+        Name##_Rb_Node* node = root;                                                                      \
+        while (node->left != NULL) {                                                                      \
+            node = node->left;                                                                            \
+        }                                                                                                 \
+        for (Name##_Rb_Node* next = name##_rb_node_next(node); next != NULL;                              \
+             node = next, next = name##_rb_node_next(next)) {                                             \
+            if (!LESS(node->key, next->key)) {                                                            \
+                printf("Red black tree: keys are out of order.\n");                                       \
+                return false;                                                                             \
+            }                                                                                             \
+        }                                                                                                 \
+        return true;                                                                                      \
+    }
+
+// Included last: `red_black_tree.h` instantiates the macros above, and provides the
+// `Rb_Node_Color` they expand to.
+#include "tree/red_black_tree.h"
+
+#endif  // RED_BLACK_TREE_TEMPLATE_H
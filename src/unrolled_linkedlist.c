@@ -0,0 +1,267 @@
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "unrolled_linkedlist.h"
+
+static_assert(UNROLLED_LIST_BLOCK_LEN == 12, "block_find compares exactly 12 values.");
+static_assert(sizeof(Unrolled_Linked_List_Node) == 64, "A node fills exactly one cache line.");
+
+static Unrolled_Linked_List_Node* unrolled_node_new(void) {
+    Unrolled_Linked_List_Node* node = (Unrolled_Linked_List_Node*) aligned_alloc(
+        alignof(Unrolled_Linked_List_Node), sizeof(Unrolled_Linked_List_Node));
+    assert(node != NULL && "Unable to allocate more memory.");
+    node->next  = NULL;
+    node->count = 0;
+    return node;
+}
+
+// Returns the index of the first occurrence of `needle_val` among the `count` first
+// values of `vals`, or -1. The whole block is always compared, the lanes past `count`
+// are masked out afterwards.
+static int block_find(const int* vals, uint32_t count, int needle_val) {
+    uint32_t mask;
+
+#if defined(__AVX2__)
+    // The values are 16 bytes aligned, not 32: the unaligned load stays within the line.
+    __m256i needle = _mm256_set1_epi32(needle_val);
+    __m256i low    = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*) vals), needle);
+    __m128i high   = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*) (vals + 8)),
+                                     _mm256_castsi256_si128(needle));
+    mask = (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(low))
+         | (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(high)) << 8;
+#elif defined(__SSE2__)
+    __m128i needle = _mm_set1_epi32(needle_val);
+    mask = 0;
+    for (uint32_t i = 0; i < UNROLLED_LIST_BLOCK_LEN; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*) (vals + i)), needle);
+        mask |= (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(eq)) << i;
+    }
+#else
+    mask = 0;
+    for (uint32_t i = 0; i < count; i += 1) {
+        mask |= (uint32_t) (vals[i] == needle_val) << i;
+    }
+#endif
+
+    mask &= (1u << count) - 1;
+    if (mask == 0) {
+        return -1;
+    }
+
+    return __builtin_ctz(mask);
+}
+
+// Finds the node holding the value at `idx`, storing the index of the value within
+// the node in `node_idx` and the node before it in `prev_node`.
+static Unrolled_Linked_List_Node* find_node(Unrolled_List* list, size_t idx, size_t* node_idx, Unrolled_Linked_List_Node** prev_node) {
+    Unrolled_Linked_List_Node* prev = NULL;
+    Unrolled_Linked_List_Node* curr_node = list->head;
+    for (;curr_node != NULL && idx >= curr_node->count;) {
+        idx -= curr_node->count;
+        prev = curr_node;
+        curr_node = curr_node->next;
+    }
+
+    *node_idx = idx;
+    if (prev_node != NULL) {
+        *prev_node = prev;
+    }
+    return curr_node;
+}
+
+void unrolled_list_init(Unrolled_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->len  = 0;
+}
+
+void unrolled_list_free(Unrolled_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    Unrolled_Linked_List_Node* curr_node = list->head;
+    for (;curr_node != NULL;) {
+        Unrolled_Linked_List_Node* to_free = curr_node;
+        curr_node = curr_node->next;
+        free(to_free);
+    }
+
+    unrolled_list_init(list);
+}
+
+size_t unrolled_list_len(Unrolled_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    return list->len;
+}
+
+void unrolled_list_print(Unrolled_List* list) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    bool first = true;
+    Unrolled_Linked_List_Node* curr_node = list->head;
+    for (;curr_node != NULL;) {
+        for (uint32_t i = 0; i < curr_node->count; i += 1) {
+            printf(first ? "%d" : " -> %d", curr_node->vals[i]);
+            first = false;
+        }
+        curr_node = curr_node->next;
+    }
+}
+
+void unrolled_list_append(Unrolled_List* list, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (list->tail == NULL || list->tail->count == UNROLLED_LIST_BLOCK_LEN) {
+        Unrolled_Linked_List_Node* new_node = unrolled_node_new();
+        if (list->tail == NULL) {
+            list->head = new_node;
+        } else {
+            list->tail->next = new_node;
+        }
+        list->tail = new_node;
+    }
+
+    list->tail->vals[list->tail->count] = val;
+    list->tail->count += 1;
+    list->len += 1;
+}
+
+bool unrolled_list_insert(Unrolled_List* list, size_t idx, int val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx > list->len) {
+        return false;
+    }
+
+    if (idx == list->len) {
+        unrolled_list_append(list, val);
+        return true;
+    }
+
+    size_t node_idx;
+    Unrolled_Linked_List_Node* node = find_node(list, idx, &node_idx, NULL);
+
+    if (node->count == UNROLLED_LIST_BLOCK_LEN) {
+        // Split the full node, moving its upper half in a new node.
+        Unrolled_Linked_List_Node* new_node = unrolled_node_new();
+        uint32_t half = UNROLLED_LIST_BLOCK_LEN / 2;
+        memcpy(new_node->vals, node->vals + half, (UNROLLED_LIST_BLOCK_LEN - half) * sizeof(int));
+        new_node->count = UNROLLED_LIST_BLOCK_LEN - half;
+        new_node->next  = node->next;
+        node->count     = half;
+        node->next      = new_node;
+        if (list->tail == node) {
+            list->tail = new_node;
+        }
+
+        if (node_idx > half) {
+            node      = new_node;
+            node_idx -= half;
+        }
+    }
+
+    memmove(node->vals + node_idx + 1, node->vals + node_idx, (node->count - node_idx) * sizeof(int));
+    node->vals[node_idx] = val;
+    node->count += 1;
+    list->len += 1;
+    return true;
+}
+
+bool unrolled_list_remove(Unrolled_List* list, size_t idx, int* removed_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->len) {
+        return false;
+    }
+
+    size_t node_idx;
+    Unrolled_Linked_List_Node* prev_node;
+    Unrolled_Linked_List_Node* node = find_node(list, idx, &node_idx, &prev_node);
+
+    if (removed_val != NULL) {
+        *removed_val = node->vals[node_idx];
+    }
+
+    memmove(node->vals + node_idx, node->vals + node_idx + 1, (node->count - node_idx - 1) * sizeof(int));
+    node->count -= 1;
+    list->len -= 1;
+
+    if (node->count == 0) {
+        if (prev_node == NULL) {
+            list->head = node->next;
+        } else {
+            prev_node->next = node->next;
+        }
+        if (list->tail == node) {
+            list->tail = prev_node;
+        }
+        free(node);
+        return true;
+    }
+
+    // Keep nodes at least half full by merging with the next node when both fit.
+    Unrolled_Linked_List_Node* next_node = node->next;
+    if (node->count < UNROLLED_LIST_BLOCK_LEN / 2 && next_node != NULL
+        && node->count + next_node->count <= UNROLLED_LIST_BLOCK_LEN) {
+        memcpy(node->vals + node->count, next_node->vals, next_node->count * sizeof(int));
+        node->count += next_node->count;
+        node->next   = next_node->next;
+        if (list->tail == next_node) {
+            list->tail = node;
+        }
+        free(next_node);
+    }
+
+    return true;
+}
+
+bool unrolled_list_get(Unrolled_List* list, size_t idx, int* get_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->len) {
+        return false;
+    }
+
+    size_t node_idx;
+    Unrolled_Linked_List_Node* node = find_node(list, idx, &node_idx, NULL);
+    *get_val = node->vals[node_idx];
+    return true;
+}
+
+bool unrolled_list_set(Unrolled_List* list, size_t idx, int new_val) {
+    assert(list != NULL && "Linked List handle is NULL.");
+
+    if (idx >= list->len) {
+        return false;
+    }
+
+    size_t node_idx;
+    Unrolled_Linked_List_Node* node = find_node(list, idx, &node_idx, NULL);
+    node->vals[node_idx] = new_val;
+    return true;
+}
+
+bool unrolled_list_lookup(Unrolled_List* list, int needle_val, size_t* found_idx) {
+    assert(list != NULL && "Linked List handle is NULL.");
+    assert(found_idx != NULL && "Found index pointer is NULL.");
+
+    size_t base_idx = 0;
+    Unrolled_Linked_List_Node* curr_node = list->head;
+    for (;curr_node != NULL;) {
+        int block_idx = block_find(curr_node->vals, curr_node->count, needle_val);
+        if (block_idx >= 0) {
+            *found_idx = base_idx + (size_t) block_idx;
+            return true;
+        }
+
+        base_idx += curr_node->count;
+        curr_node = curr_node->next;
+    }
+
+    return false;
+}
@@ -0,0 +1,192 @@
+#ifndef UNROLLED_LINKEDLIST_H
+#define UNROLLED_LINKEDLIST_H
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/**
+ * The number of values held by a node, sized so that a whole node, `next` and
+ * `count` included, fills exactly one 64 bytes cache line. The values start 16 bytes
+ * into the line, aligned for SIMD loads.
+ */
+#define UNROLLED_LIST_BLOCK_LEN 12
+
+/**
+ * @struct Unrolled_Linked_List_Node
+ * @brief A node of an unrolled linked list, holding a block of values instead of a single one.
+ *
+ * Singly and doubly linked lists store one `int` per node, so walking them costs one
+ * pointer dereference, and likely one cache miss, per value. An unrolled list stores
+ * up to `UNROLLED_LIST_BLOCK_LEN` values per node in a cache line aligned block, which
+ * divides the number of pointers to chase by the block length and lets searches
+ * compare a whole block at once with SIMD instructions.
+ *
+ * Fields:
+ * - `next`:
+ *   A pointer to the next node in the list, `NULL` for the last node.
+ *
+ * - `count`:
+ *   The number of values in use in `vals`, never `0` for a node linked in a list.
+ *
+ * - `vals`:
+ *   The values of the node, only the first `count` ones are part of the list.
+ */
+typedef struct Unrolled_Linked_List_Node {
+    alignas(64) struct Unrolled_Linked_List_Node* next;
+    uint32_t count;
+    alignas(16) int vals[UNROLLED_LIST_BLOCK_LEN];
+} Unrolled_Linked_List_Node;
+
+/**
+ * @struct Unrolled_List
+ * @brief A handle over an unrolled linked list, caching its tail and length.
+ *
+ * Fields:
+ * - `head`:
+ *   The first node of the list, `NULL` when the list is empty.
+ *
+ * - `tail`:
+ *   The last node of the list, `NULL` when the list is empty.
+ *
+ * - `len`:
+ *   The number of values in the list, not the number of nodes.
+ *
+ * Example:
+ *
+ * ```c
+ * Unrolled_List list;
+ * unrolled_list_init(&list);
+ *
+ * for (int i = 0; i < 100; i += 1) {
+ *     unrolled_list_append(&list, i * 10);
+ * }
+ *
+ * size_t found_idx;
+ * if (unrolled_list_lookup(&list, 420, &found_idx)) {
+ *     printf("Value found at index: %zu\n", found_idx); // Output: Value found at index: 42
+ * }
+ *
+ * unrolled_list_free(&list);
+ * ```
+ *
+ * Notes:
+ * - Appending fills the tail node before allocating a new one. Inserting in a full
+ *   node splits it in two halves, removing from a node less than half full merges
+ *   it with the next node when both fit in a single block.
+ */
+typedef struct Unrolled_List {
+    Unrolled_Linked_List_Node* head;
+    Unrolled_Linked_List_Node* tail;
+    size_t                     len;
+} Unrolled_List;
+
+/**
+ * @brief Initializes an empty unrolled list.
+ *
+ * @param list
+ *        The handle to initialize. Must not be `NULL`.
+ */
+void unrolled_list_init(Unrolled_List* list);
+
+/**
+ * @brief Frees every node of the list and resets the handle to an empty list.
+ *
+ * @param list
+ *        The handle of the list to free. Must not be `NULL`.
+ */
+void unrolled_list_free(Unrolled_List* list);
+
+/**
+ * @brief Returns the number of values in the list.
+ *
+ * Performance:
+ * - Time complexity: O(1), the length is cached in the handle.
+ */
+size_t unrolled_list_len(Unrolled_List* list);
+
+/**
+ * @brief Prints the values of the list to the standard output, separated by " -> ".
+ */
+void unrolled_list_print(Unrolled_List* list);
+
+/**
+ * @brief Appends `val` at the end of the list.
+ *
+ * Potential Errors:
+ * - Memory allocation failure will cause an assertion error.
+ *
+ * Performance:
+ * - Time complexity: O(1), a node is only allocated once every `UNROLLED_LIST_BLOCK_LEN` appends.
+ */
+void unrolled_list_append(Unrolled_List* list, int val);
+
+/**
+ * @brief Inserts `val` so that it ends up at index `idx`.
+ *
+ * @param idx
+ *        The zero-based index of the new value, `idx == len` appends.
+ *
+ * @return
+ *        `true` if the value was inserted, `false` if `idx` is greater than the length.
+ *
+ * Performance:
+ * - Time complexity: O(n / B + B), where `B` is `UNROLLED_LIST_BLOCK_LEN`: the node
+ *   holding the index is found by skipping whole nodes, then the values after the
+ *   index are shifted within the node.
+ */
+bool unrolled_list_insert(Unrolled_List* list, size_t idx, int val);
+
+/**
+ * @brief Removes the value at index `idx` and optionally retrieves it.
+ *
+ * @param removed_val
+ *        Where to store the removed value, may be `NULL`.
+ *
+ * @return
+ *        `true` if a value was removed, `false` if `idx` is out of range.
+ *
+ * Performance:
+ * - Time complexity: O(n / B + B), see `unrolled_list_insert`.
+ */
+bool unrolled_list_remove(Unrolled_List* list, size_t idx, int* removed_val);
+
+/**
+ * @brief Retrieves the value at index `idx`.
+ *
+ * @return
+ *        `true` if `idx` is in range and `get_val` was written, `false` otherwise.
+ */
+bool unrolled_list_get(Unrolled_List* list, size_t idx, int* get_val);
+
+/**
+ * @brief Overwrites the value at index `idx`.
+ *
+ * @return
+ *        `true` if `idx` is in range and the value was written, `false` otherwise.
+ */
+bool unrolled_list_set(Unrolled_List* list, size_t idx, int new_val);
+
+/**
+ * @brief Searches for the first occurrence of `needle_val`.
+ *
+ * Each node is searched as a whole: the block is compared against the needle 8
+ * values at a time with AVX2, 4 values at a time with SSE2, one value at a time
+ * when neither is available at compile time.
+ *
+ * @param found_idx
+ *        Where to store the index of the first occurrence. Left unchanged when the
+ *        value is not found. Must not be `NULL`.
+ *
+ * @return
+ *        `true` if the value is found, `false` otherwise.
+ *
+ * Performance:
+ * - Time complexity: O(n), with one pointer dereference per `UNROLLED_LIST_BLOCK_LEN` values.
+ */
+bool unrolled_list_lookup(Unrolled_List* list, int needle_val, size_t* found_idx);
+
+#endif